@@ -0,0 +1,520 @@
+#include <benchmark/benchmark.h>
+
+import std;
+import mo_yanxi.concurrent.mpsc_queue;
+import mo_yanxi.concurrent.mpmc_queue;
+import mo_yanxi.concurrent.shared_queue;
+import mo_yanxi.concurrent.mpsc_double_buffer;
+import mo_yanxi.concurrent.swmr_double_buffer;
+import mo_yanxi.concurrent.atomic_shared_mutex;
+
+namespace{
+using clock_type = std::chrono::steady_clock;
+
+std::int64_t now_ns() noexcept{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 对数-线性直方图（HDR 风格），相对误差约 1/32
+ *
+ * 每个线程独立记录，结束后合并，记录路径上无共享写。
+ */
+struct latency_histogram{
+	static constexpr unsigned sub_bits = 5;
+	static constexpr unsigned sub_count = 1u << sub_bits;
+	static constexpr unsigned max_exponent = 40;
+	static constexpr unsigned bucket_count = (max_exponent - sub_bits + 2) * sub_count;
+
+	std::array<std::uint64_t, bucket_count> buckets{};
+	std::uint64_t total{};
+	std::uint64_t max_value{};
+
+	static constexpr unsigned index_of(std::uint64_t value) noexcept{
+		if(value < sub_count) return static_cast<unsigned>(value);
+		const unsigned exponent = std::min<unsigned>(static_cast<unsigned>(std::bit_width(value)) - 1, max_exponent);
+		const unsigned shift = exponent - sub_bits;
+		const auto sub = static_cast<unsigned>((value >> shift) & (sub_count - 1));
+		return (shift + 1) * sub_count + sub;
+	}
+
+	static constexpr std::uint64_t lower_bound_of(unsigned index) noexcept{
+		if(index < sub_count) return index;
+		const unsigned shift = index / sub_count - 1;
+		const unsigned sub = index % sub_count;
+		return (std::uint64_t{sub_count} | sub) << shift;
+	}
+
+	void record(std::int64_t value_ns) noexcept{
+		const auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(value_ns, 0));
+		++buckets[index_of(value)];
+		++total;
+		max_value = std::max(max_value, value);
+	}
+
+	void merge(const latency_histogram& other) noexcept{
+		for(unsigned i = 0; i < bucket_count; ++i){
+			buckets[i] += other.buckets[i];
+		}
+		total += other.total;
+		max_value = std::max(max_value, other.max_value);
+	}
+
+	[[nodiscard]] double percentile(double q) const noexcept{
+		if(total == 0) return 0;
+		const auto target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+		std::uint64_t seen = 0;
+		for(unsigned i = 0; i < bucket_count; ++i){
+			seen += buckets[i];
+			if(seen >= target) return static_cast<double>(lower_bound_of(i));
+		}
+		return static_cast<double>(max_value);
+	}
+
+	void report(benchmark::State& state, std::string_view prefix = {}) const{
+		const auto name = [&](std::string_view key){ return std::format("{}{}", prefix, key); };
+		state.counters[name("p50_ns")] = percentile(0.50);
+		state.counters[name("p99_ns")] = percentile(0.99);
+		state.counters[name("p999_ns")] = percentile(0.999);
+		state.counters[name("max_ns")] = static_cast<double>(max_value);
+	}
+};
+
+// 避免各线程的直方图落在同一缓存行
+struct alignas(std::hardware_destructive_interference_size) padded_histogram{
+	latency_histogram histogram;
+};
+
+constexpr std::size_t messages_per_iteration = 1 << 17;
+
+struct message{
+	std::int64_t stamp;
+};
+
+//------------------------------------------------------------------------------
+// 通道适配器
+//
+// push(stamp)                 生产者调用
+// consume_until_stopped(fn)   消费者调用，对每个收到的时间戳调用 fn，直到 stop 被调用
+// stop(consumers)             所有消息均被消费后由主线程调用一次
+//------------------------------------------------------------------------------
+
+struct std_mutex_deque_channel{
+	static constexpr bool multi_consumer = true;
+
+	std::mutex mtx{};
+	std::condition_variable cond{};
+	std::deque<message> queue{};
+	bool stopped{};
+
+	void push(std::int64_t stamp){
+		{
+			std::lock_guard lock{mtx};
+			queue.push_back({stamp});
+		}
+		cond.notify_one();
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		std::unique_lock lock{mtx};
+		while(true){
+			cond.wait(lock, [this]{ return !queue.empty() || stopped; });
+			if(queue.empty()) return;
+			const auto msg = queue.front();
+			queue.pop_front();
+			lock.unlock();
+			fn(msg.stamp);
+			lock.lock();
+		}
+	}
+
+	void stop(std::size_t){
+		{
+			std::lock_guard lock{mtx};
+			stopped = true;
+		}
+		cond.notify_all();
+	}
+};
+
+struct mpsc_queue_channel{
+	static constexpr bool multi_consumer = false;
+
+	mo_yanxi::ccur::mpsc_queue<message> queue{};
+	std::atomic_bool stopped{};
+
+	void push(std::int64_t stamp){
+		queue.push(message{stamp});
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		while(auto msg = queue.consume([this]{ return stopped.load(std::memory_order_relaxed); })){
+			fn(msg->stamp);
+		}
+	}
+
+	void stop(std::size_t consumers){
+		stopped.store(true, std::memory_order_relaxed);
+		for(std::size_t i = 0; i < consumers; ++i) queue.notify();
+	}
+};
+
+struct mpmc_queue_channel{
+	static constexpr bool multi_consumer = true;
+
+	mo_yanxi::ccur::mpmc_queue<message> queue{1 << 12};
+	std::atomic_bool stopped{};
+
+	void push(std::int64_t stamp){
+		queue.push(message{stamp});
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		while(auto msg = queue.consume([this]{ return stopped.load(std::memory_order_relaxed); })){
+			fn(msg->stamp);
+		}
+	}
+
+	void stop(std::size_t){
+		stopped.store(true, std::memory_order_relaxed);
+		queue.notify();
+	}
+};
+
+struct shared_queue_channel{
+	static constexpr bool multi_consumer = true;
+
+	mo_yanxi::ccur::shared_queue<message> queue{};
+	std::stop_source stop_source{};
+
+	void push(std::int64_t stamp){
+		queue.push(message{stamp});
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		const auto token = stop_source.get_token();
+		while(auto msg = queue.consume(token)){
+			fn(msg->stamp);
+		}
+	}
+
+	void stop(std::size_t consumers){
+		stop_source.request_stop();
+		for(std::size_t i = 0; i < consumers; ++i) queue.notify_consumer();
+	}
+};
+
+// 延迟为入队到任务开始执行；毒丸任务用于让消费者退出
+struct task_queue_channel{
+	static constexpr bool multi_consumer = true;
+
+	struct consumer_context{
+		void (*on_item)(void*, std::int64_t);
+		void* fn;
+		bool exit;
+	};
+
+	static inline thread_local consumer_context* context{};
+
+	mo_yanxi::ccur::task_queue<> queue{};
+
+	void push(std::int64_t stamp){
+		(void)queue.push([stamp]{
+			context->on_item(context->fn, stamp);
+		});
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		consumer_context ctx{
+				[](void* f, std::int64_t stamp){ (*static_cast<Fn*>(f))(stamp); },
+				std::addressof(fn),
+				false
+			};
+		context = &ctx;
+		while(!ctx.exit){
+			auto task = queue.consume();
+			task();
+		}
+		context = nullptr;
+	}
+
+	void stop(std::size_t consumers){
+		for(std::size_t i = 0; i < consumers; ++i){
+			(void)queue.push([]{ context->exit = true; });
+		}
+	}
+};
+
+// 单消费者轮询 fetch，批量取走生产者累积的数据
+struct mpsc_double_buffer_channel{
+	static constexpr bool multi_consumer = false;
+
+	mo_yanxi::ccur::mpsc_double_buffer<message> buffer{};
+	std::atomic_bool stopped{};
+
+	void push(std::int64_t stamp){
+		buffer.push(message{stamp});
+	}
+
+	template <typename Fn>
+	void consume_until_stopped(Fn fn){
+		while(!stopped.load(std::memory_order_relaxed)){
+			if(auto* batch = buffer.fetch()){
+				for(const auto& msg : *batch){
+					fn(msg.stamp);
+				}
+			} else{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void stop(std::size_t){
+		stopped.store(true, std::memory_order_relaxed);
+	}
+};
+
+template <typename Channel>
+void BM_channel(benchmark::State& state){
+	const auto producers = static_cast<std::size_t>(state.range(0));
+	const auto consumers = static_cast<std::size_t>(state.range(1));
+	const std::size_t per_producer = messages_per_iteration / producers;
+	const std::size_t total = per_producer * producers;
+
+	latency_histogram overall{};
+
+	for(auto _ : state){
+		Channel channel{};
+		std::vector<padded_histogram> histograms(consumers);
+		std::atomic<std::size_t> consumed{0};
+		std::atomic_bool finished{false};
+
+		std::vector<std::jthread> consumer_threads;
+		consumer_threads.reserve(consumers);
+		for(std::size_t c = 0; c < consumers; ++c){
+			consumer_threads.emplace_back([&, c]{
+				auto& hist = histograms[c].histogram;
+				channel.consume_until_stopped([&](std::int64_t stamp){
+					hist.record(now_ns() - stamp);
+					if(consumed.fetch_add(1, std::memory_order_relaxed) + 1 == total){
+						finished.store(true, std::memory_order_release);
+						finished.notify_one();
+					}
+				});
+			});
+		}
+
+		std::vector<std::jthread> producer_threads;
+		producer_threads.reserve(producers);
+		for(std::size_t p = 0; p < producers; ++p){
+			producer_threads.emplace_back([&]{
+				for(std::size_t i = 0; i < per_producer; ++i){
+					channel.push(now_ns());
+				}
+			});
+		}
+
+		producer_threads.clear();
+		finished.wait(false, std::memory_order_acquire);
+		channel.stop(consumers);
+		consumer_threads.clear();
+
+		for(const auto& h : histograms){
+			overall.merge(h.histogram);
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * total));
+	overall.report(state);
+}
+
+// 生产者 1..N 的 2 次幂扫描；多消费者通道同时扫描消费者数
+template <typename Channel>
+void channel_threads(benchmark::internal::Benchmark* b){
+	const auto hardware = std::max(2u, std::thread::hardware_concurrency());
+	for(unsigned producers = 1; producers < hardware; producers *= 2){
+		if constexpr(Channel::multi_consumer){
+			for(unsigned consumers = 1; consumers < hardware && producers + consumers <= hardware; consumers *= 2){
+				b->Args({producers, consumers});
+			}
+		} else{
+			b->Args({producers, 1});
+		}
+	}
+	b->ArgNames({"producers", "consumers"});
+}
+
+//------------------------------------------------------------------------------
+// 单写多读：swmr_double_buffer vs std::shared_mutex 保护的值
+//
+// 延迟为写者发布到读者首次观察到该版本的时间
+//------------------------------------------------------------------------------
+
+struct versioned{
+	std::uint64_t version;
+	std::int64_t stamp;
+};
+
+struct swmr_double_buffer_cell{
+	mo_yanxi::ccur::swmr_double_buffer<versioned> buffer{};
+
+	void store(const versioned& value){
+		buffer.store(value);
+	}
+
+	versioned load(){
+		versioned out;
+		buffer.load_latest([&](versioned& v){ out = v; });
+		return out;
+	}
+};
+
+struct std_shared_mutex_cell{
+	std::shared_mutex mtx{};
+	versioned value{};
+
+	void store(const versioned& v){
+		std::unique_lock lock{mtx};
+		value = v;
+	}
+
+	versioned load(){
+		std::shared_lock lock{mtx};
+		return value;
+	}
+};
+
+constexpr std::uint64_t writes_per_iteration = 1 << 15;
+
+template <typename Cell>
+void BM_publish(benchmark::State& state){
+	const auto readers = static_cast<std::size_t>(state.range(0));
+
+	latency_histogram overall{};
+	std::uint64_t total_reads{};
+
+	for(auto _ : state){
+		Cell cell{};
+		std::vector<padded_histogram> histograms(readers);
+		std::vector<std::uint64_t> reads(readers);
+		std::atomic_bool writer_done{false};
+
+		std::vector<std::jthread> reader_threads;
+		reader_threads.reserve(readers);
+		for(std::size_t r = 0; r < readers; ++r){
+			reader_threads.emplace_back([&, r]{
+				auto& hist = histograms[r].histogram;
+				std::uint64_t last_version = 0;
+				std::uint64_t count = 0;
+				while(!writer_done.load(std::memory_order_acquire)){
+					const auto v = cell.load();
+					++count;
+					if(v.version != last_version){
+						last_version = v.version;
+						hist.record(now_ns() - v.stamp);
+					}
+				}
+				reads[r] = count;
+			});
+		}
+
+		for(std::uint64_t i = 1; i <= writes_per_iteration; ++i){
+			cell.store({i, now_ns()});
+		}
+		writer_done.store(true, std::memory_order_release);
+		reader_threads.clear();
+
+		for(std::size_t r = 0; r < readers; ++r){
+			overall.merge(histograms[r].histogram);
+			total_reads += reads[r];
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * writes_per_iteration));
+	state.counters["reads_per_sec"] = benchmark::Counter(static_cast<double>(total_reads), benchmark::Counter::kIsRate);
+	overall.report(state);
+}
+
+//------------------------------------------------------------------------------
+// 读写锁：atomic_shared_mtx vs std::shared_mutex（单写者，读者 1..N）
+//
+// 延迟为加锁请求到获得锁的等待时间，读写分开统计
+//------------------------------------------------------------------------------
+
+constexpr std::size_t reads_per_reader = 1 << 16;
+constexpr std::size_t writes_per_writer = 1 << 12;
+
+template <typename Mutex>
+void BM_shared_lock(benchmark::State& state){
+	const auto readers = static_cast<std::size_t>(state.range(0));
+
+	latency_histogram read_overall{};
+	latency_histogram write_overall{};
+
+	for(auto _ : state){
+		Mutex mtx{};
+		std::array<std::uint64_t, 8> shared_payload{};
+		std::vector<padded_histogram> histograms(readers);
+		latency_histogram write_hist{};
+
+		std::vector<std::jthread> reader_threads;
+		reader_threads.reserve(readers);
+		for(std::size_t r = 0; r < readers; ++r){
+			reader_threads.emplace_back([&, r]{
+				auto& hist = histograms[r].histogram;
+				for(std::size_t i = 0; i < reads_per_reader; ++i){
+					const auto begin = now_ns();
+					mtx.lock_shared();
+					hist.record(now_ns() - begin);
+					benchmark::DoNotOptimize(shared_payload[i % shared_payload.size()]);
+					mtx.unlock_shared();
+				}
+			});
+		}
+
+		for(std::size_t i = 0; i < writes_per_writer; ++i){
+			const auto begin = now_ns();
+			mtx.lock();
+			write_hist.record(now_ns() - begin);
+			shared_payload[i % shared_payload.size()] = i;
+			mtx.unlock();
+		}
+		reader_threads.clear();
+
+		for(const auto& h : histograms){
+			read_overall.merge(h.histogram);
+		}
+		write_overall.merge(write_hist);
+	}
+
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * (readers * reads_per_reader + writes_per_writer)));
+	read_overall.report(state, "read_");
+	write_overall.report(state, "write_");
+}
+
+void reader_threads(benchmark::internal::Benchmark* b){
+	const auto hardware = std::max(2u, std::thread::hardware_concurrency());
+	for(unsigned readers = 1; readers < hardware; readers *= 2){
+		b->Arg(readers);
+	}
+	b->ArgName("readers");
+}
+}
+
+BENCHMARK_TEMPLATE(BM_channel, std_mutex_deque_channel)->Apply(channel_threads<std_mutex_deque_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_channel, mpsc_queue_channel)->Apply(channel_threads<mpsc_queue_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_channel, mpmc_queue_channel)->Apply(channel_threads<mpmc_queue_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_channel, shared_queue_channel)->Apply(channel_threads<shared_queue_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_channel, task_queue_channel)->Apply(channel_threads<task_queue_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_channel, mpsc_double_buffer_channel)->Apply(channel_threads<mpsc_double_buffer_channel>)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_publish, swmr_double_buffer_cell)->Apply(reader_threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_publish, std_shared_mutex_cell)->Apply(reader_threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_shared_lock, mo_yanxi::ccur::atomic_shared_mtx)->Apply(reader_threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_shared_lock, std::shared_mutex)->Apply(reader_threads)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,611 @@
+#include <benchmark/benchmark.h>
+
+import std;
+import mo_yanxi.circular_queue;
+import mo_yanxi.ext.array_queue;
+import mo_yanxi.flat_set;
+import mo_yanxi.flat_seq_map;
+import mo_yanxi.cache;
+import mo_yanxi.cache.map;
+import mo_yanxi.byte_pool;
+import mo_yanxi.raw_byte_buffer;
+
+namespace{
+// 元素负载：4B / 16B / 64B 平凡类型，以及一个超出 SSO 的非平凡类型
+template <std::size_t Bytes>
+struct pod{
+	static_assert(Bytes % sizeof(std::uint32_t) == 0);
+	std::array<std::uint32_t, Bytes / sizeof(std::uint32_t)> words;
+
+	friend constexpr auto operator<=>(const pod&, const pod&) noexcept = default;
+};
+
+using pod4 = pod<4>;
+using pod16 = pod<16>;
+using pod64 = pod<64>;
+using non_trivial = std::string;
+
+template <typename T>
+T make_value(std::uint32_t seed){
+	if constexpr(std::same_as<T, non_trivial>){
+		return std::format("non_trivial_payload_{:016}", seed);
+	} else{
+		T v{};
+		v.words.fill(seed);
+		return v;
+	}
+}
+
+struct value_hasher{
+	template <std::size_t Bytes>
+	static std::size_t operator()(const pod<Bytes>& v) noexcept{
+		return std::hash<std::uint32_t>{}(v.words.front());
+	}
+
+	static std::size_t operator()(const non_trivial& v) noexcept{
+		return std::hash<std::string_view>{}(v);
+	}
+};
+
+template <typename T>
+std::vector<T> make_values(std::size_t count){
+	std::vector<T> values;
+	values.reserve(count);
+	std::mt19937 rng{0x5eed};
+	for(std::size_t i = 0; i < count; ++i){
+		values.push_back(make_value<T>(static_cast<std::uint32_t>(rng())));
+	}
+	return values;
+}
+
+// 每次迭代处理的字节数，便于对照 L1 / L2 / LLC / DRAM 的工作集
+template <typename T>
+void set_counters(benchmark::State& state, std::size_t elements_per_iteration){
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements_per_iteration));
+	state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * elements_per_iteration * sizeof(T)));
+	state.counters["working_set"] = benchmark::Counter(
+		static_cast<double>(state.range(0) * sizeof(T)), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+// 64 -> 1M 元素，64B 负载时覆盖约 4KB -> 64MB 的工作集
+void working_set_sizes(benchmark::internal::Benchmark* b){
+	b->RangeMultiplier(8)->Range(1 << 6, 1 << 20);
+}
+
+// 有序插入为 O(N)，上限压低以免单项耗时过长
+void sorted_insert_sizes(benchmark::internal::Benchmark* b){
+	b->RangeMultiplier(4)->Range(1 << 4, 1 << 14);
+}
+
+//------------------------------------------------------------------------------
+// FIFO：circular_queue / array_queue vs std::deque
+//------------------------------------------------------------------------------
+
+template <typename Queue, typename T>
+void run_fifo(benchmark::State& state, Queue& queue){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		for(const auto& v : values){
+			queue.push_back(v);
+		}
+		while(!queue.empty()){
+			benchmark::DoNotOptimize(queue.front());
+			queue.pop_front();
+		}
+	}
+	set_counters<T>(state, count * 2);
+}
+
+template <typename T>
+void BM_fifo_circular_queue(benchmark::State& state){
+	mo_yanxi::circular_queue<T> queue(static_cast<std::size_t>(state.range(0)));
+	run_fifo<decltype(queue), T>(state, queue);
+}
+
+template <typename T>
+void BM_fifo_std_deque(benchmark::State& state){
+	std::deque<T> queue;
+	run_fifo<decltype(queue), T>(state, queue);
+}
+
+template <typename T, std::size_t N>
+void BM_fifo_array_queue(benchmark::State& state){
+	auto queue = std::make_unique<mo_yanxi::array_queue<T, N>>();
+	run_fifo<mo_yanxi::array_queue<T, N>, T>(state, *queue);
+}
+
+// 稳态滚动：队列保持半满，每轮 push 一个 pop 一个
+template <typename Queue, typename T>
+void run_rolling(benchmark::State& state, Queue& queue){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+	for(std::size_t i = 0; i < count / 2; ++i){
+		queue.push_back(values[i]);
+	}
+
+	std::size_t cursor = 0;
+	for(auto _ : state){
+		queue.push_back(values[cursor]);
+		benchmark::DoNotOptimize(queue.front());
+		queue.pop_front();
+		cursor = cursor + 1 == count ? 0 : cursor + 1;
+	}
+	set_counters<T>(state, 1);
+}
+
+template <typename T>
+void BM_rolling_circular_queue(benchmark::State& state){
+	mo_yanxi::circular_queue<T> queue(static_cast<std::size_t>(state.range(0)));
+	run_rolling<decltype(queue), T>(state, queue);
+}
+
+template <typename T>
+void BM_rolling_std_deque(benchmark::State& state){
+	std::deque<T> queue;
+	run_rolling<decltype(queue), T>(state, queue);
+}
+
+//------------------------------------------------------------------------------
+// 集合：linear_flat_set vs std::set / std::unordered_set
+//------------------------------------------------------------------------------
+
+template <typename Set, typename T>
+void run_set_insert(benchmark::State& state, auto make_set){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		Set set = make_set();
+		for(const auto& v : values){
+			set.insert(v);
+		}
+		benchmark::DoNotOptimize(set);
+	}
+	set_counters<T>(state, count);
+}
+
+// 偶数下标的元素进入集合：查询时一半命中一半未命中
+template <typename T>
+std::vector<T> half_of(const std::vector<T>& values){
+	std::vector<T> half;
+	half.reserve(values.size() / 2 + 1);
+	for(std::size_t i = 0; i < values.size(); i += 2){
+		half.push_back(values[i]);
+	}
+	return half;
+}
+
+template <typename Set, typename T>
+void run_set_lookup(benchmark::State& state, const Set& set, const std::vector<T>& values){
+	const auto count = values.size();
+	for(auto _ : state){
+		std::size_t hits = 0;
+		for(const auto& v : values){
+			hits += set.contains(v);
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_set_insert_linear_flat_set(benchmark::State& state){
+	using set_t = mo_yanxi::linear_flat_set<std::vector<T>>;
+	run_set_insert<set_t, T>(state, []{ return set_t{}; });
+}
+
+template <typename T>
+void BM_set_insert_std_set(benchmark::State& state){
+	using set_t = std::set<T>;
+	run_set_insert<set_t, T>(state, []{ return set_t{}; });
+}
+
+template <typename T>
+void BM_set_insert_std_unordered_set(benchmark::State& state){
+	using set_t = std::unordered_set<T, value_hasher>;
+	run_set_insert<set_t, T>(state, []{ return set_t{}; });
+}
+
+// 查询用例整体构建集合，避免逐个有序插入的 O(N^2) 准备时间
+template <typename T>
+void BM_set_lookup_linear_flat_set(benchmark::State& state){
+	const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+	const mo_yanxi::linear_flat_set<std::vector<T>> set{half_of(values)};
+	run_set_lookup(state, set, values);
+}
+
+template <typename T>
+void BM_set_lookup_std_set(benchmark::State& state){
+	const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+	const auto half = half_of(values);
+	const std::set<T> set{half.begin(), half.end()};
+	run_set_lookup(state, set, values);
+}
+
+template <typename T>
+void BM_set_lookup_std_unordered_set(benchmark::State& state){
+	const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+	const auto half = half_of(values);
+	const std::unordered_set<T, value_hasher> set{half.begin(), half.end()};
+	run_set_lookup(state, set, values);
+}
+
+//------------------------------------------------------------------------------
+// 有序映射：flat_seq_map vs std::map
+//------------------------------------------------------------------------------
+
+template <typename T>
+void BM_map_insert_flat_seq_map(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+	const auto keys = make_values<pod4>(count);
+
+	for(auto _ : state){
+		mo_yanxi::flat_seq_map<std::uint32_t, T> map;
+		for(std::size_t i = 0; i < count; ++i){
+			map.insert_unique(std::uint32_t{keys[i].words[0]}, values[i]);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_map_insert_std_map(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+	const auto keys = make_values<pod4>(count);
+
+	for(auto _ : state){
+		std::map<std::uint32_t, T> map;
+		for(std::size_t i = 0; i < count; ++i){
+			map.try_emplace(keys[i].words[0], values[i]);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_map_lookup_flat_seq_map(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+	const auto keys = make_values<pod4>(count);
+
+	// 按键有序插入，每次都落在尾部，准备阶段保持线性
+	std::vector<std::size_t> order;
+	for(std::size_t i = 0; i < count; i += 2){
+		order.push_back(i);
+	}
+	std::ranges::sort(order, {}, [&](std::size_t i){ return keys[i].words[0]; });
+
+	mo_yanxi::flat_seq_map<std::uint32_t, T> map;
+	for(const auto i : order){
+		map.insert_unique(std::uint32_t{keys[i].words[0]}, values[i]);
+	}
+
+	for(auto _ : state){
+		std::size_t hits = 0;
+		for(const auto& key : keys){
+			hits += map.find_unique(key.words[0]) != nullptr;
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_map_lookup_std_map(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+	const auto keys = make_values<pod4>(count);
+
+	std::map<std::uint32_t, T> map;
+	for(std::size_t i = 0; i < count; i += 2){
+		map.try_emplace(keys[i].words[0], values[i]);
+	}
+
+	for(auto _ : state){
+		std::size_t hits = 0;
+		for(const auto& key : keys){
+			hits += map.contains(key.words[0]);
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	set_counters<T>(state, count);
+}
+
+//------------------------------------------------------------------------------
+// LRU：lru_cache / mapped_lru_cache vs std::list + std::unordered_map
+//------------------------------------------------------------------------------
+
+template <typename K, typename V>
+struct std_lru_cache{
+	using list_type = std::list<std::pair<K, V>>;
+
+	std::size_t capacity;
+	list_type entries{};
+	std::unordered_map<K, typename list_type::iterator> index{};
+
+	explicit std_lru_cache(std::size_t capacity) : capacity(capacity){
+		index.reserve(capacity);
+	}
+
+	V* get(const K& key){
+		auto it = index.find(key);
+		if(it == index.end()) return nullptr;
+		entries.splice(entries.begin(), entries, it->second);
+		return std::addressof(it->second->second);
+	}
+
+	void put(const K& key, const V& value){
+		if(auto it = index.find(key); it != index.end()){
+			it->second->second = value;
+			entries.splice(entries.begin(), entries, it->second);
+			return;
+		}
+
+		if(entries.size() == capacity){
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, value);
+		index.emplace(key, entries.begin());
+	}
+};
+
+// 键空间为容量的 2 倍，约一半访问命中
+template <typename Cache, typename T>
+void run_lru(benchmark::State& state, Cache& cache, std::size_t capacity){
+	const auto values = make_values<T>(capacity);
+	std::vector<std::uint32_t> keys(capacity * 8);
+	std::mt19937 rng{0x1eaf};
+	std::uniform_int_distribution<std::uint32_t> dist{0, static_cast<std::uint32_t>(capacity * 2 - 1)};
+	std::ranges::generate(keys, [&]{ return dist(rng); });
+
+	for(auto _ : state){
+		std::size_t hits = 0;
+		for(std::size_t i = 0; i < keys.size(); ++i){
+			if(auto* v = cache.get(keys[i])){
+				benchmark::DoNotOptimize(v);
+				++hits;
+			} else{
+				cache.put(keys[i], values[i % capacity]);
+			}
+		}
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * keys.size()));
+	state.counters["working_set"] = benchmark::Counter(
+		static_cast<double>(capacity * (sizeof(T) + sizeof(std::uint32_t))), benchmark::Counter::kDefaults,
+		benchmark::Counter::kIs1024);
+}
+
+template <typename T, std::size_t N>
+void BM_lru_lru_cache(benchmark::State& state){
+	auto cache = std::make_unique<mo_yanxi::lru_cache<std::uint32_t, T, N>>();
+	run_lru<mo_yanxi::lru_cache<std::uint32_t, T, N>, T>(state, *cache, N);
+}
+
+template <typename T, std::size_t N>
+void BM_lru_std_list_map(benchmark::State& state){
+	std_lru_cache<std::uint32_t, T> cache{N};
+	run_lru<decltype(cache), T>(state, cache, N);
+}
+
+template <typename T>
+void BM_lru_mapped_lru_cache(benchmark::State& state){
+	const auto capacity = static_cast<std::uint32_t>(state.range(0));
+	mo_yanxi::mapped_lru_cache<std::uint32_t, T> cache{capacity};
+
+	struct adaptor{
+		mo_yanxi::mapped_lru_cache<std::uint32_t, T>& cache;
+		T* get(std::uint32_t key){ return cache.get_ptr(key); }
+		void put(std::uint32_t key, const T& value){ cache.put(key, value); }
+	} view{cache};
+
+	run_lru<adaptor, T>(state, view, capacity);
+}
+
+template <typename T>
+void BM_lru_std_list_map_dynamic(benchmark::State& state){
+	std_lru_cache<std::uint32_t, T> cache{static_cast<std::size_t>(state.range(0))};
+	run_lru<decltype(cache), T>(state, cache, static_cast<std::size_t>(state.range(0)));
+}
+
+//------------------------------------------------------------------------------
+// 字节池：byte_pool vs std::allocator（byte_pool 仅接受平凡析构类型）
+//------------------------------------------------------------------------------
+
+// 同时借出 32 个缓冲区再全部归还，模拟一帧内的临时分配
+constexpr std::size_t pool_batch = 32;
+
+template <typename T>
+void BM_pool_byte_pool(benchmark::State& state){
+	const auto count = static_cast<unsigned>(state.range(0));
+	mo_yanxi::byte_pool<> pool;
+	std::array<mo_yanxi::byte_buffer<T>, pool_batch> live{};
+
+	for(auto _ : state){
+		for(auto& buf : live){
+			buf = pool.template acquire<T>(count);
+			benchmark::DoNotOptimize(buf.data());
+		}
+		for(auto& buf : live){
+			pool.retire(buf);
+		}
+	}
+	pool.clear();
+	set_counters<T>(state, pool_batch * count);
+}
+
+template <typename T>
+void BM_pool_std_allocator(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	std::allocator<T> alloc;
+	std::array<T*, pool_batch> live{};
+
+	for(auto _ : state){
+		for(auto& buf : live){
+			buf = alloc.allocate(count);
+			benchmark::DoNotOptimize(buf);
+		}
+		for(auto& buf : live){
+			alloc.deallocate(buf, count);
+		}
+	}
+	set_counters<T>(state, pool_batch * count);
+}
+
+// byte_pool 最大桶为 16MB，超出部分直接走系统分配
+void pool_sizes(benchmark::internal::Benchmark* b){
+	b->RangeMultiplier(8)->Range(1 << 4, 1 << 16);
+}
+
+//------------------------------------------------------------------------------
+// 向量：raw_vector vs std::vector（raw_vector 仅接受隐式生存期类型）
+//------------------------------------------------------------------------------
+
+template <typename T>
+void BM_vector_push_raw_vector(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		mo_yanxi::raw_vector<T> vec;
+		for(const auto& v : values){
+			vec.push_back(v);
+		}
+		benchmark::DoNotOptimize(vec.data());
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_vector_push_std_vector(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		std::vector<T> vec;
+		for(const auto& v : values){
+			vec.push_back(v);
+		}
+		benchmark::DoNotOptimize(vec.data());
+	}
+	set_counters<T>(state, count);
+}
+
+// resize 后整体覆写：raw_vector 跳过值初始化，std::vector 需要先清零
+template <typename T>
+void BM_vector_overwrite_raw_vector(benchmark::State& state){
+	const auto count = static_cast<unsigned>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		mo_yanxi::raw_vector<T> vec;
+		vec.resize_and_overwrite(count, [&](T* data, unsigned, unsigned requested) noexcept{
+			std::ranges::copy(values, data);
+			return requested;
+		});
+		benchmark::DoNotOptimize(vec.data());
+	}
+	set_counters<T>(state, count);
+}
+
+template <typename T>
+void BM_vector_overwrite_std_vector(benchmark::State& state){
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto values = make_values<T>(count);
+
+	for(auto _ : state){
+		std::vector<T> vec;
+		vec.resize(count);
+		std::ranges::copy(values, vec.data());
+		benchmark::DoNotOptimize(vec.data());
+	}
+	set_counters<T>(state, count);
+}
+}
+
+#define MO_YANXI_BENCH_ELEMENTS(fn, sizes) \
+	BENCHMARK_TEMPLATE(fn, pod4)->Apply(sizes); \
+	BENCHMARK_TEMPLATE(fn, pod16)->Apply(sizes); \
+	BENCHMARK_TEMPLATE(fn, pod64)->Apply(sizes); \
+	BENCHMARK_TEMPLATE(fn, non_trivial)->Apply(sizes)
+
+#define MO_YANXI_BENCH_POD_ELEMENTS(fn, sizes) \
+	BENCHMARK_TEMPLATE(fn, pod4)->Apply(sizes); \
+	BENCHMARK_TEMPLATE(fn, pod16)->Apply(sizes); \
+	BENCHMARK_TEMPLATE(fn, pod64)->Apply(sizes)
+
+MO_YANXI_BENCH_ELEMENTS(BM_fifo_circular_queue, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_fifo_std_deque, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_rolling_circular_queue, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_rolling_std_deque, working_set_sizes);
+
+// array_queue 的容量是编译期常量，分别取 L1 / L2 / DRAM 量级，std::deque 对照见 BM_fifo_std_deque
+
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod4, 64)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod16, 64)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod64, 64)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, non_trivial, 64)->Arg(64);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod4, 4096)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod16, 4096)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod64, 4096)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, non_trivial, 4096)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod4, 262144)->Arg(262144);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod16, 262144)->Arg(262144);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, pod64, 262144)->Arg(262144);
+BENCHMARK_TEMPLATE(BM_fifo_array_queue, non_trivial, 262144)->Arg(262144);
+
+MO_YANXI_BENCH_ELEMENTS(BM_set_insert_linear_flat_set, sorted_insert_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_set_insert_std_set, sorted_insert_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_set_insert_std_unordered_set, sorted_insert_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_set_lookup_linear_flat_set, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_set_lookup_std_set, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_set_lookup_std_unordered_set, working_set_sizes);
+
+MO_YANXI_BENCH_ELEMENTS(BM_map_insert_flat_seq_map, sorted_insert_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_map_insert_std_map, sorted_insert_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_map_lookup_flat_seq_map, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_map_lookup_std_map, working_set_sizes);
+
+// lru_cache 的容量是编译期常量；N = 256 会与 uint8 的 invalid_index 冲突，故取 255
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod4, 64);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod16, 64);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod64, 64);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, non_trivial, 64);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod4, 255);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod16, 255);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod64, 255);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, non_trivial, 255);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod4, 4096);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod16, 4096);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, pod64, 4096);
+BENCHMARK_TEMPLATE(BM_lru_lru_cache, non_trivial, 4096);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod4, 64);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod16, 64);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod64, 64);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, non_trivial, 64);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod4, 255);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod16, 255);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod64, 255);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, non_trivial, 255);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod4, 4096);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod16, 4096);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, pod64, 4096);
+BENCHMARK_TEMPLATE(BM_lru_std_list_map, non_trivial, 4096);
+
+MO_YANXI_BENCH_ELEMENTS(BM_lru_mapped_lru_cache, working_set_sizes);
+MO_YANXI_BENCH_ELEMENTS(BM_lru_std_list_map_dynamic, working_set_sizes);
+
+MO_YANXI_BENCH_POD_ELEMENTS(BM_pool_byte_pool, pool_sizes);
+MO_YANXI_BENCH_POD_ELEMENTS(BM_pool_std_allocator, pool_sizes);
+
+MO_YANXI_BENCH_POD_ELEMENTS(BM_vector_push_raw_vector, working_set_sizes);
+MO_YANXI_BENCH_POD_ELEMENTS(BM_vector_push_std_vector, working_set_sizes);
+MO_YANXI_BENCH_POD_ELEMENTS(BM_vector_overwrite_raw_vector, working_set_sizes);
+MO_YANXI_BENCH_POD_ELEMENTS(BM_vector_overwrite_std_vector, working_set_sizes);
@@ -1,3 +1,13 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#ifdef __AVX2__
+#define MO_YANXI_BITMAP_AVX2
+#include <immintrin.h>
+#endif
+
 export module mo_yanxi.bitmap;
 
 export import mo_yanxi.math.vector2;
@@ -5,6 +15,7 @@ export import mo_yanxi.math.vector2;
 import std;
 import mo_yanxi.concepts;
 import mo_yanxi.dim2.tile;
+import mo_yanxi.concurrent.thread_pool;
 
 namespace mo_yanxi{
 export
@@ -79,6 +90,206 @@ struct alignas(sizeof(std::uint32_t)) color_bits{
 };
 
 
+namespace bitmap_kernel{
+	using pixel = color_bits;
+	using channel = color_bits::bit_type;
+
+	/**
+	 * @brief round(value * factor / 255)，value 与 factor 不超过 255
+	 */
+	[[nodiscard]] FORCE_INLINE constexpr channel mul_div255(const unsigned value, const unsigned factor) noexcept{
+		const unsigned t = value * factor + 128;
+		return static_cast<channel>((t + (t >> 8)) >> 8);
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr float unpremultiply_scale(const unsigned alpha) noexcept{
+		return alpha == 0 ? 0.f : 255.f / static_cast<float>(alpha);
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr channel unpremultiply_channel(const unsigned value, const float scale) noexcept{
+		return static_cast<channel>(std::min(255, static_cast<int>(static_cast<float>(value) * scale + .5f)));
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr channel average4(const unsigned a, const unsigned b, const unsigned c, const unsigned d) noexcept{
+		return static_cast<channel>((a + b + c + d + 2) >> 2);
+	}
+
+#ifdef MO_YANXI_BITMAP_AVX2
+	[[nodiscard]] FORCE_INLINE __m256i load8(const pixel* src) noexcept{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+	}
+
+	FORCE_INLINE void store8(pixel* dst, const __m256i v) noexcept{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+	}
+
+	/**
+	 * @brief 对每个 16 位通道计算 mul_div255，factor 的两个 16 位半字均为同一像素的系数
+	 */
+	[[nodiscard]] FORCE_INLINE __m256i mul_div255_x16(const __m256i value, const __m256i factor) noexcept{
+		const __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(value, factor), _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+	}
+
+	/**
+	 * @brief 将每个像素的 8 位系数复制到两个 16 位半字
+	 */
+	[[nodiscard]] FORCE_INLINE __m256i broadcast16(const __m256i factor) noexcept{
+		return _mm256_or_si256(factor, _mm256_slli_epi32(factor, 16));
+	}
+#endif
+
+	inline void premultiply(pixel* RESTRICT p, const std::size_t count) noexcept{
+		std::size_t i = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		const __m256i low_mask = _mm256_set1_epi32(0x00ff00ff);
+		const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xff000000u));
+		for(; i + 8 <= count; i += 8){
+			const __m256i v = bitmap_kernel::load8(p + i);
+			const __m256i alpha = bitmap_kernel::broadcast16(_mm256_srli_epi32(v, 24));
+			const __m256i rb = bitmap_kernel::mul_div255_x16(_mm256_and_si256(v, low_mask), alpha);
+			const __m256i ga = bitmap_kernel::mul_div255_x16(_mm256_and_si256(_mm256_srli_epi32(v, 8), low_mask), alpha);
+			const __m256i rgb = _mm256_andnot_si256(alpha_mask, _mm256_or_si256(rb, _mm256_slli_epi16(ga, 8)));
+			bitmap_kernel::store8(p + i, _mm256_or_si256(rgb, _mm256_and_si256(v, alpha_mask)));
+		}
+#endif
+		for(; i < count; ++i){
+			pixel& px = p[i];
+			px.r = bitmap_kernel::mul_div255(px.r, px.a);
+			px.g = bitmap_kernel::mul_div255(px.g, px.a);
+			px.b = bitmap_kernel::mul_div255(px.b, px.a);
+		}
+	}
+
+	inline void unpremultiply(pixel* RESTRICT p, const std::size_t count) noexcept{
+		std::size_t i = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		const __m256i byte_mask = _mm256_set1_epi32(0xff);
+		const __m256i max_value = _mm256_set1_epi32(255);
+		const __m256 half = _mm256_set1_ps(.5f);
+		for(; i + 8 <= count; i += 8){
+			const __m256i v = bitmap_kernel::load8(p + i);
+			const __m256i alpha = _mm256_srli_epi32(v, 24);
+			const __m256 transparent = _mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, _mm256_setzero_si256()));
+			const __m256 scale = _mm256_andnot_ps(transparent, _mm256_div_ps(_mm256_set1_ps(255.f), _mm256_cvtepi32_ps(alpha)));
+
+			const auto channel_of = [&](const int shift){
+				const __m256 value = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, shift), byte_mask));
+				const __m256i rst = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, scale), half));
+				return _mm256_slli_epi32(_mm256_min_epi32(rst, max_value), shift);
+			};
+
+			const __m256i rgb = _mm256_or_si256(channel_of(0), _mm256_or_si256(channel_of(8), channel_of(16)));
+			bitmap_kernel::store8(p + i, _mm256_or_si256(rgb, _mm256_slli_epi32(alpha, 24)));
+		}
+#endif
+		for(; i < count; ++i){
+			pixel& px = p[i];
+			const float scale = bitmap_kernel::unpremultiply_scale(px.a);
+			px.r = bitmap_kernel::unpremultiply_channel(px.r, scale);
+			px.g = bitmap_kernel::unpremultiply_channel(px.g, scale);
+			px.b = bitmap_kernel::unpremultiply_channel(px.b, scale);
+		}
+	}
+
+	inline void swizzle(pixel* RESTRICT p, const std::size_t count, const std::array<std::uint8_t, 4> order) noexcept{
+		std::size_t i = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		alignas(32) std::array<std::uint8_t, 32> indices;
+		for(unsigned k = 0; k < 32; ++k){
+			indices[k] = static_cast<std::uint8_t>((k & ~3u) % 16 + (order[k & 3u] & 3u));
+		}
+		const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(indices.data()));
+		for(; i + 8 <= count; i += 8){
+			bitmap_kernel::store8(p + i, _mm256_shuffle_epi8(bitmap_kernel::load8(p + i), shuffle));
+		}
+#endif
+		for(; i < count; ++i){
+			const pixel src = p[i];
+			p[i] = {src[order[0]], src[order[1]], src[order[2]], src[order[3]]};
+		}
+	}
+
+	/**
+	 * @brief 预乘 alpha 的 source-over：dst = src + dst * (255 - src.a) / 255
+	 */
+	inline void blend(pixel* RESTRICT dst, const pixel* RESTRICT src, const std::size_t count) noexcept{
+		std::size_t i = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		const __m256i low_mask = _mm256_set1_epi32(0x00ff00ff);
+		const __m256i max_alpha = _mm256_set1_epi32(255);
+		for(; i + 8 <= count; i += 8){
+			const __m256i s = bitmap_kernel::load8(src + i);
+			const __m256i d = bitmap_kernel::load8(dst + i);
+			const __m256i inv_alpha = bitmap_kernel::broadcast16(_mm256_sub_epi32(max_alpha, _mm256_srli_epi32(s, 24)));
+			const __m256i rb = bitmap_kernel::mul_div255_x16(_mm256_and_si256(d, low_mask), inv_alpha);
+			const __m256i ga = bitmap_kernel::mul_div255_x16(_mm256_and_si256(_mm256_srli_epi32(d, 8), low_mask), inv_alpha);
+			bitmap_kernel::store8(dst + i, _mm256_adds_epu8(s, _mm256_or_si256(rb, _mm256_slli_epi16(ga, 8))));
+		}
+#endif
+		for(; i < count; ++i){
+			const pixel s = src[i];
+			pixel& d = dst[i];
+			const unsigned inv_alpha = 255u - s.a;
+			d.r = static_cast<channel>(std::min(255u, s.r + unsigned{bitmap_kernel::mul_div255(d.r, inv_alpha)}));
+			d.g = static_cast<channel>(std::min(255u, s.g + unsigned{bitmap_kernel::mul_div255(d.g, inv_alpha)}));
+			d.b = static_cast<channel>(std::min(255u, s.b + unsigned{bitmap_kernel::mul_div255(d.b, inv_alpha)}));
+			d.a = static_cast<channel>(std::min(255u, s.a + unsigned{bitmap_kernel::mul_div255(d.a, inv_alpha)}));
+		}
+	}
+
+	inline void fill(pixel* RESTRICT dst, const std::size_t count, const pixel value) noexcept{
+		std::size_t i = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		const __m256i v = _mm256_set1_epi32(static_cast<int>(value.pack()));
+		for(; i + 8 <= count; i += 8){
+			bitmap_kernel::store8(dst + i, v);
+		}
+#endif
+		std::fill_n(dst + i, count - i, value);
+	}
+
+	/**
+	 * @brief 2x2 盒式滤波，src_width 为奇数时最后一列与前一列合并，为 1 时横向复用同一列
+	 */
+	inline void downsample(pixel* RESTRICT dst, const std::size_t dst_width,
+		const pixel* RESTRICT row0, const pixel* RESTRICT row1, const std::size_t src_width) noexcept{
+		std::size_t x = 0;
+#ifdef MO_YANXI_BITMAP_AVX2
+		const __m256i low_mask = _mm256_set1_epi32(0x00ff00ff);
+		const __m256i bias = _mm256_set1_epi16(2);
+		for(; x + 8 <= dst_width && (x + 8) * 2 <= src_width; x += 8){
+			const __m256i a0 = bitmap_kernel::load8(row0 + x * 2), b0 = bitmap_kernel::load8(row0 + x * 2 + 8);
+			const __m256i a1 = bitmap_kernel::load8(row1 + x * 2), b1 = bitmap_kernel::load8(row1 + x * 2 + 8);
+
+			// 每像素的两个 16 位通道之和不超过 1020，可直接按 32 位横向相加
+			const auto sum = [&](const auto select){
+				const __m256i lo = _mm256_add_epi32(select(a0), select(a1));
+				const __m256i hi = _mm256_add_epi32(select(b0), select(b1));
+				// hadd 在 128 位内交错两个输入，换回顺序
+				const __m256i pairs = _mm256_permute4x64_epi64(_mm256_hadd_epi32(lo, hi), 0b11'01'10'00);
+				return _mm256_srli_epi16(_mm256_add_epi16(pairs, bias), 2);
+			};
+
+			const __m256i rb = sum([&](const __m256i v){ return _mm256_and_si256(v, low_mask); });
+			const __m256i ga = sum([&](const __m256i v){ return _mm256_and_si256(_mm256_srli_epi32(v, 8), low_mask); });
+			bitmap_kernel::store8(dst + x, _mm256_or_si256(rb, _mm256_slli_epi16(ga, 8)));
+		}
+#endif
+		for(; x < dst_width; ++x){
+			const std::size_t x0 = std::min(x * 2, src_width - 1);
+			const std::size_t x1 = std::min(x * 2 + 1, src_width - 1);
+			const pixel p00 = row0[x0], p01 = row0[x1], p10 = row1[x0], p11 = row1[x1];
+			dst[x] = {
+					bitmap_kernel::average4(p00.r, p01.r, p10.r, p11.r),
+					bitmap_kernel::average4(p00.g, p01.g, p10.g, p11.g),
+					bitmap_kernel::average4(p00.b, p01.b, p10.b, p11.b),
+					bitmap_kernel::average4(p00.a, p01.a, p10.a, p11.a),
+				};
+		}
+	}
+}
+
 export
 struct bitmap : dim2::tile<color_bits>{
 	static constexpr size_type channels = 4;
@@ -121,6 +332,226 @@ struct bitmap : dim2::tile<color_bits>{
 			std::memcpy(dst, src_data, size_bytes());
 		}
 	}
+
+	/**
+	 * @brief 行序为 RGBA 的像素与 BGRA 互换所用的通道顺序
+	 */
+	static constexpr std::array<std::uint8_t, 4> swizzle_bgra{2, 1, 0, 3};
+
+	/**
+	 * @brief 像素数低于此值时线程池版本直接在调用线程执行，高于时按行带切分，每带至少约此数量的像素
+	 */
+	static constexpr std::size_t parallel_pixel_threshold = 1 << 16;
+
+	void premultiply_alpha() noexcept{
+		this->premultiply_alpha_(nullptr);
+	}
+
+	void premultiply_alpha(ccur::thread_pool& pool){
+		this->premultiply_alpha_(&pool);
+	}
+
+	/**
+	 * @brief 预乘的逆运算，alpha 为 0 的像素颜色置零
+	 */
+	void unpremultiply_alpha() noexcept{
+		this->unpremultiply_alpha_(nullptr);
+	}
+
+	void unpremultiply_alpha(ccur::thread_pool& pool){
+		this->unpremultiply_alpha_(&pool);
+	}
+
+	/**
+	 * @brief 重排通道：新像素的第 i 个通道取自原像素的第 order[i] 个通道
+	 */
+	void swizzle(const std::array<std::uint8_t, 4>& order = swizzle_bgra) noexcept{
+		this->swizzle_(nullptr, order);
+	}
+
+	void swizzle(ccur::thread_pool& pool, const std::array<std::uint8_t, 4>& order = swizzle_bgra){
+		this->swizzle_(&pool, order);
+	}
+
+	void fill(const value_type value) noexcept{
+		bitmap_kernel::fill(data(), size(), value);
+	}
+
+	/**
+	 * @brief 填充子区域，超出图像的部分被裁剪
+	 */
+	void fill(const point_type pos, const extent_type extent, const value_type value) noexcept{
+		const blit_region region = bitmap::clip_(this->extent(), pos, extent, this->extent(), pos);
+		for(size_type y = 0; y < region.height; ++y){
+			bitmap_kernel::fill(this->pixel_at_(region.dst.x, region.dst.y + y), region.width, value);
+		}
+	}
+
+	/**
+	 * @brief 将 src 中以 src_pos 为起点、大小为 extent 的子区域复制到 dst_pos，两侧越界部分均被裁剪
+	 * @warning src 不能为 *this
+	 */
+	void copy_from(const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos) noexcept{
+		this->copy_from_(nullptr, src, src_pos, extent, dst_pos);
+	}
+
+	void copy_from(ccur::thread_pool& pool, const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos){
+		this->copy_from_(&pool, src, src_pos, extent, dst_pos);
+	}
+
+	/**
+	 * @brief 同 copy_from，但以 source-over 混合，两侧均应为预乘 alpha
+	 * @warning src 不能为 *this
+	 */
+	void blend_from(const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos) noexcept{
+		this->blend_from_(nullptr, src, src_pos, extent, dst_pos);
+	}
+
+	void blend_from(ccur::thread_pool& pool, const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos){
+		this->blend_from_(&pool, src, src_pos, extent, dst_pos);
+	}
+
+	/**
+	 * @brief 2x2 盒式滤波缩小一半，奇数边长向下取整，边长为 1 的方向保持不变
+	 *
+	 * 对非预乘的图像，半透明边缘会混入透明像素的颜色，生成 mipmap 前宜先 premultiply_alpha。
+	 */
+	[[nodiscard]] bitmap downscale_half() const{
+		return this->downscale_half_(nullptr);
+	}
+
+	[[nodiscard]] bitmap downscale_half(ccur::thread_pool& pool) const{
+		return this->downscale_half_(&pool);
+	}
+
+	/**
+	 * @brief 逐级 downscale_half 直至 1x1 或达到 max_levels
+	 * @return 第 1 级起的各级 mipmap，不含自身
+	 */
+	[[nodiscard]] std::vector<bitmap> mipmap_chain(const unsigned max_levels = std::numeric_limits<unsigned>::max()) const{
+		return this->mipmap_chain_(nullptr, max_levels);
+	}
+
+	[[nodiscard]] std::vector<bitmap> mipmap_chain(ccur::thread_pool& pool, const unsigned max_levels = std::numeric_limits<unsigned>::max()) const{
+		return this->mipmap_chain_(&pool, max_levels);
+	}
+
+private:
+	struct blit_region{
+		point_type src;
+		point_type dst;
+		size_type width;
+		size_type height;
+	};
+
+	[[nodiscard]] static blit_region clip_(
+		const extent_type src_extent, const point_type src_pos, const extent_type extent,
+		const extent_type dst_extent, const point_type dst_pos) noexcept{
+		const auto remain = [](const size_type total, const size_type pos) noexcept -> size_type{
+			return total > pos ? total - pos : 0;
+		};
+
+		return {
+				src_pos, dst_pos,
+				std::min({extent.x, remain(src_extent.x, src_pos.x), remain(dst_extent.x, dst_pos.x)}),
+				std::min({extent.y, remain(src_extent.y, src_pos.y), remain(dst_extent.y, dst_pos.y)}),
+			};
+	}
+
+	[[nodiscard]] value_type* pixel_at_(const size_type x, const size_type y) noexcept{
+		return data() + static_cast<std::size_t>(y) * width() + x;
+	}
+
+	[[nodiscard]] const value_type* pixel_at_(const size_type x, const size_type y) const noexcept{
+		return data() + static_cast<std::size_t>(y) * width() + x;
+	}
+
+	/**
+	 * @brief 将 [0, rows) 切分为行带交给 fn(begin, end)，pool 为空或像素较少时直接调用
+	 */
+	template <typename Fn>
+	static void for_each_row_band_(ccur::thread_pool* pool, const size_type rows, const size_type row_width, Fn fn){
+		if(rows == 0 || row_width == 0) return;
+
+		if(!pool || pool->size() <= 1 || static_cast<std::size_t>(rows) * row_width < parallel_pixel_threshold){
+			fn(size_type{0}, rows);
+			return;
+		}
+
+		const std::size_t grain = std::max<std::size_t>(1, parallel_pixel_threshold / row_width);
+		pool->parallel_for(0, rows, [&](const std::size_t begin, const std::size_t end){
+			fn(static_cast<size_type>(begin), static_cast<size_type>(end));
+		}, grain);
+	}
+
+	template <typename Kernel>
+	void apply_rows_(ccur::thread_pool* pool, Kernel kernel){
+		bitmap::for_each_row_band_(pool, height(), width(), [&, this](const size_type begin, const size_type end){
+			kernel(this->pixel_at_(0, begin), static_cast<std::size_t>(end - begin) * width());
+		});
+	}
+
+	void premultiply_alpha_(ccur::thread_pool* pool){
+		this->apply_rows_(pool, bitmap_kernel::premultiply);
+	}
+
+	void unpremultiply_alpha_(ccur::thread_pool* pool){
+		this->apply_rows_(pool, bitmap_kernel::unpremultiply);
+	}
+
+	void swizzle_(ccur::thread_pool* pool, const std::array<std::uint8_t, 4>& order){
+		this->apply_rows_(pool, [&](value_type* pixels, const std::size_t count){
+			bitmap_kernel::swizzle(pixels, count, order);
+		});
+	}
+
+	void copy_from_(ccur::thread_pool* pool, const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos){
+		assert(&src != this);
+		const blit_region region = bitmap::clip_(src.extent(), src_pos, extent, this->extent(), dst_pos);
+		bitmap::for_each_row_band_(pool, region.height, region.width, [&, this](const size_type begin, const size_type end){
+			for(size_type y = begin; y < end; ++y){
+				std::memcpy(this->pixel_at_(region.dst.x, region.dst.y + y), src.pixel_at_(region.src.x, region.src.y + y),
+					region.width * sizeof(value_type));
+			}
+		});
+	}
+
+	void blend_from_(ccur::thread_pool* pool, const bitmap& src, const point_type src_pos, const extent_type extent, const point_type dst_pos){
+		assert(&src != this);
+		const blit_region region = bitmap::clip_(src.extent(), src_pos, extent, this->extent(), dst_pos);
+		bitmap::for_each_row_band_(pool, region.height, region.width, [&, this](const size_type begin, const size_type end){
+			for(size_type y = begin; y < end; ++y){
+				bitmap_kernel::blend(this->pixel_at_(region.dst.x, region.dst.y + y), src.pixel_at_(region.src.x, region.src.y + y),
+					region.width);
+			}
+		});
+	}
+
+	[[nodiscard]] bitmap downscale_half_(ccur::thread_pool* pool) const{
+		if(width() == 0 || height() == 0) return {};
+		const size_type w = std::max<size_type>(1, width() / 2);
+		const size_type h = std::max<size_type>(1, height() / 2);
+
+		bitmap rst{w, h};
+		bitmap::for_each_row_band_(pool, h, w, [&, this](const size_type begin, const size_type end){
+			for(size_type y = begin; y < end; ++y){
+				const size_type y0 = std::min(y * 2, height() - 1);
+				const size_type y1 = std::min(y * 2 + 1, height() - 1);
+				bitmap_kernel::downsample(rst.pixel_at_(0, y), w, this->pixel_at_(0, y0), this->pixel_at_(0, y1), width());
+			}
+		});
+		return rst;
+	}
+
+	[[nodiscard]] std::vector<bitmap> mipmap_chain_(ccur::thread_pool* pool, const unsigned max_levels) const{
+		std::vector<bitmap> chain{};
+		const bitmap* last = this;
+		while(chain.size() < max_levels && last->area() > 1){
+			chain.push_back(last->downscale_half_(pool));
+			last = &chain.back();
+		}
+		return chain;
+	}
 };
 
 
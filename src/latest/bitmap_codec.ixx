@@ -0,0 +1,580 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.bitmap_codec;
+
+export import mo_yanxi.bitmap;
+
+import std;
+import mo_yanxi.dim2.tile;
+import mo_yanxi.concurrent.thread_pool;
+
+/**
+ * @brief 类 QOI 的无损 RGBA 编码
+ *
+ * 文件由 20 字节头部与若干行带组成，每个行带为 u32 字节数加独立编码的数据（编码状态在带首重置），
+ * 因此既可逐行流式读写，也可按行带并行编码 / 解码。所有整数均为小端序。
+ *
+ * 带内的操作码与 QOI 相同：INDEX / DIFF / LUMA / RUN / RGB / RGBA，
+ * 区别在于哈希表只在写出新颜色（DIFF / LUMA / RGB / RGBA）时更新，编码与解码两侧严格对称。
+ */
+namespace mo_yanxi::bitmap_codec{
+export
+struct header{
+	static constexpr std::array<std::byte, 4> magic{std::byte{'M'}, std::byte{'Y'}, std::byte{'Q'}, std::byte{'I'}};
+	static constexpr std::uint8_t version = 1;
+	static constexpr std::size_t size_bytes = 20;
+
+	std::uint32_t width{};
+	std::uint32_t height{};
+	std::uint32_t band_height{};
+
+	[[nodiscard]] constexpr std::uint32_t band_count() const noexcept{
+		if(width == 0 || height == 0) return 0;
+		return height / band_height + (height % band_height != 0);
+	}
+
+	[[nodiscard]] constexpr std::uint32_t band_first_row(const std::uint32_t band) const noexcept{
+		return band * band_height;
+	}
+
+	[[nodiscard]] constexpr std::uint32_t band_rows(const std::uint32_t band) const noexcept{
+		return std::min(band_height, height - this->band_first_row(band));
+	}
+
+	constexpr bool operator==(const header&) const noexcept = default;
+};
+
+/**
+ * @brief 默认行带约含的像素数，与 bitmap::parallel_pixel_threshold 一致
+ */
+export constexpr std::size_t default_band_pixels = bitmap::parallel_pixel_threshold;
+
+export
+[[nodiscard]] constexpr std::uint32_t default_band_height(const std::uint32_t width) noexcept{
+	if(width == 0) return 1;
+	return static_cast<std::uint32_t>(std::max<std::size_t>(1, (default_band_pixels + width - 1) / width));
+}
+
+/**
+ * @brief 单次 band_encoder::encode 输入 count 个像素的最坏字节数
+ *
+ * 全部为 RGBA，另加上次调用遗留游程的 1 字节；max_encoded_size(0) 即 finish 所需的空间。
+ */
+export
+[[nodiscard]] constexpr std::size_t max_encoded_size(const std::size_t count) noexcept{
+	return count * 5 + 1;
+}
+
+namespace op{
+	constexpr std::uint8_t index = 0x00;
+	constexpr std::uint8_t diff = 0x40;
+	constexpr std::uint8_t luma = 0x80;
+	constexpr std::uint8_t run = 0xc0;
+	constexpr std::uint8_t rgb = 0xfe;
+	constexpr std::uint8_t rgba = 0xff;
+	constexpr std::uint8_t mask = 0xc0;
+
+	constexpr unsigned max_run = 62;
+}
+
+constexpr color_bits initial_pixel{0, 0, 0, 255};
+
+[[nodiscard]] FORCE_INLINE constexpr unsigned hash(const color_bits px) noexcept{
+	return (px.r * 3u + px.g * 5u + px.b * 7u + px.a * 11u) & 63u;
+}
+
+FORCE_INLINE void store_u32(std::byte* dst, const std::uint32_t value) noexcept{
+	for(unsigned i = 0; i < 4; ++i){
+		dst[i] = static_cast<std::byte>(value >> i * 8);
+	}
+}
+
+[[nodiscard]] FORCE_INLINE std::uint32_t load_u32(const std::byte* src) noexcept{
+	std::uint32_t value{};
+	for(unsigned i = 0; i < 4; ++i){
+		value |= std::to_integer<std::uint32_t>(src[i]) << i * 8;
+	}
+	return value;
+}
+
+/**
+ * @brief 单个行带的流式编码状态，可分多次输入像素
+ */
+export
+class band_encoder{
+	color_bits prev_{initial_pixel};
+	std::array<color_bits, 64> index_{};
+	unsigned run_{};
+
+	FORCE_INLINE std::byte* flush_run_(std::byte* out) noexcept{
+		*out++ = static_cast<std::byte>(op::run | (run_ - 1));
+		run_ = 0;
+		return out;
+	}
+
+public:
+	void reset() noexcept{
+		*this = band_encoder{};
+	}
+
+	/**
+	 * @brief 编码 count 个像素写入 out，尚未结束的游程保留到下次调用或 finish
+	 * @param out 至少有 max_encoded_size(count) 字节可写
+	 * @return 写入后的末尾
+	 */
+	std::byte* encode(const color_bits* RESTRICT pixels, const std::size_t count, std::byte* RESTRICT out) noexcept{
+		for(std::size_t i = 0; i < count; ++i){
+			const color_bits px = pixels[i];
+
+			if(px == prev_){
+				if(++run_ == op::max_run) out = this->flush_run_(out);
+				continue;
+			}
+
+			if(run_) out = this->flush_run_(out);
+
+			const unsigned slot = bitmap_codec::hash(px);
+			if(index_[slot] == px){
+				*out++ = static_cast<std::byte>(op::index | slot);
+				prev_ = px;
+				continue;
+			}
+			index_[slot] = px;
+
+			if(px.a == prev_.a){
+				const auto dr = static_cast<std::int8_t>(px.r - prev_.r);
+				const auto dg = static_cast<std::int8_t>(px.g - prev_.g);
+				const auto db = static_cast<std::int8_t>(px.b - prev_.b);
+				const auto dr_dg = static_cast<std::int8_t>(dr - dg);
+				const auto db_dg = static_cast<std::int8_t>(db - dg);
+
+				if(dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1){
+					*out++ = static_cast<std::byte>(op::diff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+				} else if(dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7){
+					*out++ = static_cast<std::byte>(op::luma | (dg + 32));
+					*out++ = static_cast<std::byte>((dr_dg + 8) << 4 | (db_dg + 8));
+				} else{
+					*out++ = std::byte{op::rgb};
+					*out++ = std::byte{px.r};
+					*out++ = std::byte{px.g};
+					*out++ = std::byte{px.b};
+				}
+			} else{
+				*out++ = std::byte{op::rgba};
+				*out++ = std::byte{px.r};
+				*out++ = std::byte{px.g};
+				*out++ = std::byte{px.b};
+				*out++ = std::byte{px.a};
+			}
+
+			prev_ = px;
+		}
+
+		return out;
+	}
+
+	/**
+	 * @brief 写出未结束的游程
+	 * @param out 至少有 max_encoded_size(0) 字节可写
+	 */
+	std::byte* finish(std::byte* out) noexcept{
+		if(run_) out = this->flush_run_(out);
+		return out;
+	}
+};
+
+/**
+ * @brief 单个行带的流式解码状态，可分多次取出像素；输入损坏或不足时返回 false 而不会越界
+ */
+export
+class band_decoder{
+	color_bits prev_{initial_pixel};
+	std::array<color_bits, 64> index_{};
+	unsigned run_{};
+	const std::byte* cur_{};
+	const std::byte* end_{};
+
+public:
+	[[nodiscard]] band_decoder() = default;
+
+	[[nodiscard]] explicit band_decoder(const std::span<const std::byte> payload) noexcept
+	: cur_(payload.data()), end_(payload.data() + payload.size()){
+	}
+
+	[[nodiscard]] bool decode(color_bits* RESTRICT dst, const std::size_t count) noexcept{
+		std::size_t i = 0;
+		while(i < count){
+			if(run_){
+				const std::size_t n = std::min<std::size_t>(run_, count - i);
+				std::fill_n(dst + i, n, prev_);
+				i += n;
+				run_ -= static_cast<unsigned>(n);
+				continue;
+			}
+
+			if(cur_ == end_) return false;
+			const auto tag = std::to_integer<std::uint8_t>(*cur_++);
+
+			color_bits px = prev_;
+			if(tag == op::rgb){
+				if(end_ - cur_ < 3) return false;
+				px.r = std::to_integer<std::uint8_t>(cur_[0]);
+				px.g = std::to_integer<std::uint8_t>(cur_[1]);
+				px.b = std::to_integer<std::uint8_t>(cur_[2]);
+				cur_ += 3;
+			} else if(tag == op::rgba){
+				if(end_ - cur_ < 4) return false;
+				px.r = std::to_integer<std::uint8_t>(cur_[0]);
+				px.g = std::to_integer<std::uint8_t>(cur_[1]);
+				px.b = std::to_integer<std::uint8_t>(cur_[2]);
+				px.a = std::to_integer<std::uint8_t>(cur_[3]);
+				cur_ += 4;
+			} else{
+				switch(tag & op::mask){
+				case op::index :
+					dst[i++] = prev_ = index_[tag];
+					continue;
+				case op::diff :
+					px.r += static_cast<std::uint8_t>((tag >> 4 & 3) - 2);
+					px.g += static_cast<std::uint8_t>((tag >> 2 & 3) - 2);
+					px.b += static_cast<std::uint8_t>((tag & 3) - 2);
+					break;
+				case op::luma :{
+					if(cur_ == end_) return false;
+					const auto next = std::to_integer<std::uint8_t>(*cur_++);
+					const int dg = (tag & 0x3f) - 32;
+					px.r += static_cast<std::uint8_t>(dg + (next >> 4) - 8);
+					px.g += static_cast<std::uint8_t>(dg);
+					px.b += static_cast<std::uint8_t>(dg + (next & 0x0f) - 8);
+					break;
+				}
+				default :
+					run_ = (tag & 0x3f) + 1u;
+					continue;
+				}
+			}
+
+			index_[bitmap_codec::hash(px)] = px;
+			dst[i++] = prev_ = px;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief 输入与游程均已用尽，用于确认行带恰好被完整解码
+	 */
+	[[nodiscard]] bool exhausted() const noexcept{
+		return cur_ == end_ && run_ == 0;
+	}
+};
+
+/**
+ * @brief 头部与各行带数据的位置，用于按行带随机访问或并行解码
+ */
+export
+struct layout{
+	header info{};
+	std::vector<std::span<const std::byte>> bands{};
+};
+
+export
+[[nodiscard]] std::array<std::byte, header::size_bytes> write_header(const header& info) noexcept{
+	std::array<std::byte, header::size_bytes> rst{};
+	std::ranges::copy(header::magic, rst.begin());
+	rst[4] = std::byte{header::version};
+	bitmap_codec::store_u32(rst.data() + 8, info.width);
+	bitmap_codec::store_u32(rst.data() + 12, info.height);
+	bitmap_codec::store_u32(rst.data() + 16, info.band_height);
+	return rst;
+}
+
+export
+[[nodiscard]] std::optional<header> read_header(const std::span<const std::byte> data) noexcept{
+	if(data.size() < header::size_bytes) return std::nullopt;
+	if(!std::ranges::equal(data.first<4>(), header::magic) || data[4] != std::byte{header::version}) return std::nullopt;
+
+	const header info{
+			bitmap_codec::load_u32(data.data() + 8),
+			bitmap_codec::load_u32(data.data() + 12),
+			bitmap_codec::load_u32(data.data() + 16),
+		};
+	if(info.band_height == 0) return std::nullopt;
+	return info;
+}
+
+/**
+ * @brief 校验头部并定位所有行带，不解码像素
+ *
+ * 每字节至多展开为 62 个像素，像素数超出该上限的行带视为损坏，借此防止伪造的尺寸导致巨量分配。
+ */
+export
+[[nodiscard]] std::optional<layout> parse(const std::span<const std::byte> data){
+	const auto info = bitmap_codec::read_header(data);
+	if(!info) return std::nullopt;
+
+	layout rst{*info};
+	const std::uint32_t count = info->band_count();
+	rst.bands.reserve(std::min<std::size_t>(count, (data.size() - header::size_bytes) / 4));
+
+	std::size_t cursor = header::size_bytes;
+	for(std::uint32_t band = 0; band < count; ++band){
+		if(data.size() - cursor < 4) return std::nullopt;
+		const std::size_t length = bitmap_codec::load_u32(data.data() + cursor);
+		cursor += 4;
+		if(data.size() - cursor < length) return std::nullopt;
+
+		const std::size_t pixels = static_cast<std::size_t>(info->band_rows(band)) * info->width;
+		if(pixels > length * op::max_run) return std::nullopt;
+
+		rst.bands.push_back(data.subspan(cursor, length));
+		cursor += length;
+	}
+
+	return rst;
+}
+
+/**
+ * @brief 将第 band 个行带解码至 dst，dst 为该行带按行主序排列的像素
+ * @return 数据损坏或 dst 不足时为 false
+ */
+export
+[[nodiscard]] bool decode_band(const layout& source, const std::uint32_t band, const std::span<color_bits> dst) noexcept{
+	if(band >= source.bands.size()) return false;
+	const std::size_t pixels = static_cast<std::size_t>(source.info.band_rows(band)) * source.info.width;
+	if(dst.size() < pixels) return false;
+
+	band_decoder decoder{source.bands[band]};
+	return decoder.decode(dst.data(), pixels) && decoder.exhausted();
+}
+
+/**
+ * @brief 将第 band 个行带解码至 dst 中对应的行，dst 宽度须一致且高度足够
+ */
+export
+[[nodiscard]] bool decode_band(const layout& source, const std::uint32_t band, dim2::tile<color_bits>& dst) noexcept{
+	if(dst.width() != source.info.width || band >= source.bands.size()) return false;
+	const std::uint32_t first = source.info.band_first_row(band);
+	if(dst.height() < first + source.info.band_rows(band)) return false;
+
+	return bitmap_codec::decode_band(source, band,
+		std::span{dst.data() + static_cast<std::size_t>(first) * dst.width(), dst.size() - static_cast<std::size_t>(first) * dst.width()});
+}
+
+/**
+ * @brief 逐行输入像素的编码器，输出可直接顺序写入文件
+ *
+ * 先写出 header_bytes()，再依次 push_row 所有行并写出其返回值。
+ */
+export
+class stream_encoder{
+	header info_;
+	band_encoder encoder_{};
+	std::vector<std::byte> buffer_{};
+	std::size_t write_pos_{};
+	std::uint32_t row_{};
+
+public:
+	/**
+	 * @param band_height 为 0 时使用 default_band_height(width)
+	 */
+	[[nodiscard]] explicit stream_encoder(const std::uint32_t width, const std::uint32_t height, const std::uint32_t band_height = 0)
+	: info_{width, height, band_height ? band_height : bitmap_codec::default_band_height(width)}{
+		buffer_.resize(4 + bitmap_codec::max_encoded_size(static_cast<std::size_t>(info_.band_height) * width));
+	}
+
+	[[nodiscard]] const header& info() const noexcept{
+		return info_;
+	}
+
+	[[nodiscard]] std::array<std::byte, header::size_bytes> header_bytes() const noexcept{
+		return bitmap_codec::write_header(info_);
+	}
+
+	/**
+	 * @param row 恰为 width 个像素
+	 * @return 行带结束时为该行带的全部字节，否则为空；有效至下一次调用
+	 */
+	[[nodiscard]] std::span<const std::byte> push_row(const std::span<const color_bits> row) noexcept{
+		assert(row.size() == info_.width);
+		assert(row_ < info_.height);
+
+		if(write_pos_ == 0) write_pos_ = 4;
+		write_pos_ = encoder_.encode(row.data(), row.size(), buffer_.data() + write_pos_) - buffer_.data();
+
+		++row_;
+		if(row_ % info_.band_height != 0 && row_ != info_.height) return {};
+
+		write_pos_ = encoder_.finish(buffer_.data() + write_pos_) - buffer_.data();
+		bitmap_codec::store_u32(buffer_.data(), static_cast<std::uint32_t>(write_pos_ - 4));
+		encoder_.reset();
+		return {buffer_.data(), std::exchange(write_pos_, 0)};
+	}
+
+	[[nodiscard]] bool done() const noexcept{
+		return row_ == info_.height;
+	}
+};
+
+/**
+ * @brief 逐行输出像素的解码器
+ */
+export
+class stream_decoder{
+	header info_{};
+	std::span<const std::byte> data_{};
+	std::size_t cursor_{};
+	band_decoder band_{};
+	std::uint32_t row_{};
+
+public:
+	[[nodiscard]] stream_decoder() = default;
+
+	/**
+	 * @return 头部无效时为空
+	 */
+	[[nodiscard]] static std::optional<stream_decoder> open(const std::span<const std::byte> data) noexcept{
+		const auto info = bitmap_codec::read_header(data);
+		if(!info) return std::nullopt;
+
+		stream_decoder rst{};
+		rst.info_ = *info;
+		rst.data_ = data;
+		rst.cursor_ = header::size_bytes;
+		return rst;
+	}
+
+	[[nodiscard]] const header& info() const noexcept{
+		return info_;
+	}
+
+	[[nodiscard]] std::uint32_t rows_decoded() const noexcept{
+		return row_;
+	}
+
+	/**
+	 * @param row 至少 width 个像素
+	 * @return 已无更多行或数据损坏时为 false
+	 */
+	[[nodiscard]] bool next_row(const std::span<color_bits> row) noexcept{
+		if(row_ >= info_.height || row.size() < info_.width) return false;
+
+		if(row_ % info_.band_height == 0){
+			if(data_.size() - cursor_ < 4) return false;
+			const std::size_t length = bitmap_codec::load_u32(data_.data() + cursor_);
+			cursor_ += 4;
+			if(data_.size() - cursor_ < length) return false;
+
+			band_ = band_decoder{data_.subspan(cursor_, length)};
+			cursor_ += length;
+		}
+
+		if(!band_.decode(row.data(), info_.width)) return false;
+		++row_;
+		return true;
+	}
+};
+
+namespace detail{
+	/**
+	 * @return 行带字节数（含 u32 长度前缀）
+	 */
+	std::size_t encode_band(const dim2::tile<color_bits>& image, const header& info, const std::uint32_t band, std::byte* out) noexcept{
+		band_encoder encoder{};
+		const std::size_t pixels = static_cast<std::size_t>(info.band_rows(band)) * info.width;
+		std::byte* end = encoder.encode(image.data() + static_cast<std::size_t>(info.band_first_row(band)) * info.width, pixels, out + 4);
+		end = encoder.finish(end);
+		bitmap_codec::store_u32(out, static_cast<std::uint32_t>(end - out - 4));
+		return static_cast<std::size_t>(end - out);
+	}
+
+	std::vector<std::byte> encode(ccur::thread_pool* pool, const dim2::tile<color_bits>& image, const std::uint32_t band_height){
+		const header info{image.width(), image.height(), band_height ? band_height : bitmap_codec::default_band_height(image.width())};
+		const std::uint32_t count = info.band_count();
+		const std::size_t band_capacity = 4 + bitmap_codec::max_encoded_size(static_cast<std::size_t>(info.band_height) * info.width);
+
+		std::vector<std::byte> rst;
+		const auto head = bitmap_codec::write_header(info);
+		rst.assign(head.begin(), head.end());
+
+		if(!pool || pool->size() <= 1 || count <= 1 || image.size() < bitmap::parallel_pixel_threshold){
+			const auto scratch = std::make_unique_for_overwrite<std::byte[]>(band_capacity);
+			for(std::uint32_t band = 0; band < count; ++band){
+				const std::size_t length = detail::encode_band(image, info, band, scratch.get());
+				rst.insert(rst.end(), scratch.get(), scratch.get() + length);
+			}
+			return rst;
+		}
+
+		std::vector<std::vector<std::byte>> bands(count);
+		pool->parallel_for(0, count, [&](const std::size_t band){
+			const auto scratch = std::make_unique_for_overwrite<std::byte[]>(band_capacity);
+			const std::size_t length = detail::encode_band(image, info, static_cast<std::uint32_t>(band), scratch.get());
+			bands[band].assign(scratch.get(), scratch.get() + length);
+		}, 1);
+
+		std::size_t total = rst.size();
+		for(const auto& band : bands) total += band.size();
+		rst.reserve(total);
+		for(const auto& band : bands) rst.insert(rst.end(), band.begin(), band.end());
+		return rst;
+	}
+
+	std::optional<bitmap> decode(ccur::thread_pool* pool, const std::span<const std::byte> data){
+		const auto source = bitmap_codec::parse(data);
+		if(!source) return std::nullopt;
+		if(static_cast<std::uint64_t>(source->info.width) * source->info.height > std::numeric_limits<bitmap::size_type>::max()) return std::nullopt;
+
+		bitmap rst{source->info.width, source->info.height};
+		const auto count = static_cast<std::uint32_t>(source->bands.size());
+
+		if(!pool || pool->size() <= 1 || count <= 1 || rst.size() < bitmap::parallel_pixel_threshold){
+			for(std::uint32_t band = 0; band < count; ++band){
+				if(!bitmap_codec::decode_band(*source, band, rst)) return std::nullopt;
+			}
+			return rst;
+		}
+
+		std::atomic_bool failed{};
+		pool->parallel_for(0, count, [&](const std::size_t band){
+			if(!bitmap_codec::decode_band(*source, static_cast<std::uint32_t>(band), rst)){
+				failed.store(true, std::memory_order_relaxed);
+			}
+		}, 1);
+
+		if(failed.load(std::memory_order_relaxed)) return std::nullopt;
+		return rst;
+	}
+}
+
+/**
+ * @param band_height 为 0 时使用 default_band_height(width)
+ */
+export
+[[nodiscard]] std::vector<std::byte> encode(const dim2::tile<color_bits>& image, const std::uint32_t band_height = 0){
+	return detail::encode(nullptr, image, band_height);
+}
+
+/**
+ * @brief 各行带在线程池上并行编码，输出与单线程版本逐字节相同
+ */
+export
+[[nodiscard]] std::vector<std::byte> encode(ccur::thread_pool& pool, const dim2::tile<color_bits>& image, const std::uint32_t band_height = 0){
+	return detail::encode(&pool, image, band_height);
+}
+
+/**
+ * @return 数据损坏时为空
+ */
+export
+[[nodiscard]] std::optional<bitmap> decode(const std::span<const std::byte> data){
+	return detail::decode(nullptr, data);
+}
+
+export
+[[nodiscard]] std::optional<bitmap> decode(ccur::thread_pool& pool, const std::span<const std::byte> data){
+	return detail::decode(&pool, data);
+}
+}
@@ -0,0 +1,411 @@
+module;
+
+#include "mo_yanxi/adapted_attributes.hpp"
+#include <cassert>
+
+export module mo_yanxi.dim2.sparse_grid;
+
+export import mo_yanxi.dim2.tile;
+export import mo_yanxi.math.vector2;
+import mo_yanxi.flat_hash_map;
+import mo_yanxi.algo.radix_sort;
+import std;
+
+namespace mo_yanxi::dim2{
+/**
+ * @brief 将两个 32 位无符号数按位交错，x 占偶数位
+ */
+export
+[[nodiscard]] constexpr std::uint64_t morton_interleave(const std::uint32_t x, const std::uint32_t y) noexcept{
+	constexpr auto spread = [](std::uint64_t v) constexpr noexcept{
+		v = (v | v << 16) & 0x0000'FFFF'0000'FFFFull;
+		v = (v | v << 8) & 0x00FF'00FF'00FF'00FFull;
+		v = (v | v << 4) & 0x0F0F'0F0F'0F0F'0F0Full;
+		v = (v | v << 2) & 0x3333'3333'3333'3333ull;
+		v = (v | v << 1) & 0x5555'5555'5555'5555ull;
+		return v;
+	};
+
+	return spread(x) | spread(y) << 1;
+}
+
+/**
+ * @brief 无边界的稀疏二维网格，按 2^ChunkShift 见方的区块惰性分配
+ *
+ * 值等于 T{} 的格子视为空：区块在首次写入非空值时分配，最后一个非空格子被清空时释放。
+ * 区块以哈希表索引，并缓存最近一次访问的区块，连续访问同一区块时无需查表。
+ * 坐标为有符号 32 位整数，负坐标向下取整到所在区块。
+ *
+ * @warning 非线程安全；只读访问同样会更新区块缓存
+ */
+export
+template <typename T, unsigned ChunkShift = 5>
+	requires (std::default_initializable<T> && std::equality_comparable<T> && ChunkShift > 0 && ChunkShift < 16)
+class sparse_grid{
+public:
+	using value_type = T;
+	using coord_type = std::int32_t;
+	using point_type = math::vector2<coord_type>;
+	using chunk_tile_type = tile<T>;
+
+	static constexpr coord_type chunk_extent = coord_type{1} << ChunkShift;
+	static constexpr coord_type chunk_mask = chunk_extent - 1;
+
+	static constexpr std::array<point_type, 4> neighbors_4{
+			{
+				{0, 1},
+				{1, 0},
+				{0, -1},
+				{-1, 0},
+			}
+		};
+
+	static constexpr std::array<point_type, 8> neighbors_8{
+			{
+				{-1, 1},
+				{0, 1},
+				{1, 1},
+				{1, 0},
+				{1, -1},
+				{0, -1},
+				{-1, -1},
+				{-1, 0},
+			}
+		};
+
+private:
+	struct chunk{
+		chunk_tile_type cells{chunk_extent, chunk_extent, value_type{}};
+		point_type coord;
+		unsigned occupied{};
+
+		[[nodiscard]] explicit chunk(const point_type coord)
+			: coord(coord){
+		}
+
+		[[nodiscard]] FORCE_INLINE value_type& cell(const point_type pos) noexcept{
+			return cells[static_cast<unsigned>(pos.x & chunk_mask), static_cast<unsigned>(pos.y & chunk_mask)];
+		}
+
+		[[nodiscard]] FORCE_INLINE const value_type& cell(const point_type pos) const noexcept{
+			return cells[static_cast<unsigned>(pos.x & chunk_mask), static_cast<unsigned>(pos.y & chunk_mask)];
+		}
+	};
+
+	struct order_entry{
+		std::uint64_t morton;
+		const chunk* target;
+	};
+
+	static constexpr std::uint64_t invalid_key = ~std::uint64_t{};
+
+	flat_hash_map<std::uint64_t, std::unique_ptr<chunk>> chunks_{};
+	std::size_t size_{};
+
+	mutable std::uint64_t cached_key_{invalid_key};
+	mutable chunk* cached_chunk_{};
+
+	mutable std::vector<order_entry> order_{};
+	mutable bool order_dirty_{};
+
+	inline static const value_type empty_value{};
+
+	[[nodiscard]] FORCE_INLINE static bool is_empty_(const value_type& value) noexcept(noexcept(value == empty_value)){
+		return value == empty_value;
+	}
+
+	[[nodiscard]] FORCE_INLINE static constexpr point_type chunk_coord_of_(const point_type pos) noexcept{
+		// 有符号右移向负无穷取整
+		return {pos.x >> ChunkShift, pos.y >> ChunkShift};
+	}
+
+	[[nodiscard]] FORCE_INLINE static constexpr std::uint64_t key_of_(const point_type chunk_coord) noexcept{
+		return static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunk_coord.x)) << 32 | static_cast<std::uint32_t>(chunk_coord.y);
+	}
+
+	[[nodiscard]] static constexpr std::uint64_t morton_of_(const point_type chunk_coord) noexcept{
+		// 翻转符号位，使负坐标排在非负坐标之前
+		constexpr std::uint32_t bias = std::uint32_t{1} << 31;
+		return dim2::morton_interleave(static_cast<std::uint32_t>(chunk_coord.x) ^ bias, static_cast<std::uint32_t>(chunk_coord.y) ^ bias);
+	}
+
+	[[nodiscard]] chunk* find_chunk_(const point_type chunk_coord) const noexcept{
+		const std::uint64_t key = sparse_grid::key_of_(chunk_coord);
+		if(key == cached_key_) return cached_chunk_;
+
+		if(auto* p = chunks_.try_find(key)){
+			cached_key_ = key;
+			cached_chunk_ = p->get();
+			return cached_chunk_;
+		}
+		return nullptr;
+	}
+
+	[[nodiscard]] chunk& acquire_chunk_(const point_type chunk_coord){
+		if(chunk* c = this->find_chunk_(chunk_coord)) return *c;
+
+		const std::uint64_t key = sparse_grid::key_of_(chunk_coord);
+		auto& ptr = chunks_.try_emplace(key, std::make_unique<chunk>(chunk_coord)).first->second;
+		order_dirty_ = true;
+		cached_key_ = key;
+		cached_chunk_ = ptr.get();
+		return *cached_chunk_;
+	}
+
+	void release_chunk_(const chunk& c) noexcept{
+		const std::uint64_t key = sparse_grid::key_of_(c.coord);
+		if(key == cached_key_){
+			cached_key_ = invalid_key;
+			cached_chunk_ = nullptr;
+		}
+		chunks_.erase(key);
+		order_dirty_ = true;
+	}
+
+	FORCE_INLINE void on_cell_changed_(chunk& c, const bool was_empty, const bool now_empty) noexcept{
+		if(was_empty == now_empty) return;
+
+		if(was_empty){
+			++c.occupied;
+			++size_;
+		} else{
+			--c.occupied;
+			--size_;
+			if(c.occupied == 0) this->release_chunk_(c);
+		}
+	}
+
+	std::span<const order_entry> chunk_order_() const{
+		if(order_dirty_){
+			order_.clear();
+			order_.reserve(chunks_.size());
+			for(const auto& [key, ptr] : chunks_){
+				order_.push_back({sparse_grid::morton_of_(ptr->coord), ptr.get()});
+			}
+			algo::radix_sort(order_, &order_entry::morton);
+			order_dirty_ = false;
+		}
+		return order_;
+	}
+
+public:
+	[[nodiscard]] sparse_grid() = default;
+
+	[[nodiscard]] sparse_grid(sparse_grid&& other) noexcept
+		: chunks_(std::move(other.chunks_)), size_(std::exchange(other.size_, 0)), order_dirty_(true){
+		other.clear();
+	}
+
+	sparse_grid& operator=(sparse_grid&& other) noexcept{
+		if(this == &other) return *this;
+		chunks_ = std::move(other.chunks_);
+		size_ = std::exchange(other.size_, 0);
+		cached_key_ = invalid_key;
+		cached_chunk_ = nullptr;
+		order_dirty_ = true;
+		other.clear();
+		return *this;
+	}
+
+	/**
+	 * @brief 非空格子数
+	 */
+	[[nodiscard]] std::size_t size() const noexcept{
+		return size_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return size_ == 0;
+	}
+
+	/**
+	 * @brief 已分配的区块数
+	 */
+	[[nodiscard]] std::size_t chunk_count() const noexcept{
+		return chunks_.size();
+	}
+
+	void clear() noexcept{
+		chunks_.clear();
+		order_.clear();
+		size_ = 0;
+		cached_key_ = invalid_key;
+		cached_chunk_ = nullptr;
+		order_dirty_ = false;
+	}
+
+	/**
+	 * @return 格子的只读引用，所在区块未分配时返回共享的空值
+	 */
+	[[nodiscard]] const value_type& operator[](const coord_type x, const coord_type y) const noexcept{
+		return this->at({x, y});
+	}
+
+	[[nodiscard]] const value_type& at(const point_type pos) const noexcept{
+		if(const chunk* c = this->find_chunk_(sparse_grid::chunk_coord_of_(pos))){
+			return c->cell(pos);
+		}
+		return empty_value;
+	}
+
+	[[nodiscard]] bool contains(const point_type pos) const noexcept{
+		return !sparse_grid::is_empty_(this->at(pos));
+	}
+
+	/**
+	 * @brief 写入格子；写入 T{} 等价于 reset
+	 */
+	template <typename V>
+		requires std::assignable_from<value_type&, V&&>
+	void set(const point_type pos, V&& value){
+		const point_type chunk_coord = sparse_grid::chunk_coord_of_(pos);
+		if(sparse_grid::is_empty_(value)){
+			if(chunk* c = this->find_chunk_(chunk_coord)){
+				value_type& cell = c->cell(pos);
+				const bool was_empty = sparse_grid::is_empty_(cell);
+				cell = std::forward<V>(value);
+				this->on_cell_changed_(*c, was_empty, true);
+			}
+			return;
+		}
+
+		chunk& c = this->acquire_chunk_(chunk_coord);
+		value_type& cell = c.cell(pos);
+		const bool was_empty = sparse_grid::is_empty_(cell);
+		cell = std::forward<V>(value);
+		this->on_cell_changed_(c, was_empty, false);
+	}
+
+	/**
+	 * @brief 清空格子，区块因此变空时一并释放
+	 * @return 格子原先是否非空
+	 */
+	bool reset(const point_type pos){
+		chunk* c = this->find_chunk_(sparse_grid::chunk_coord_of_(pos));
+		if(!c) return false;
+
+		value_type& cell = c->cell(pos);
+		if(sparse_grid::is_empty_(cell)) return false;
+		cell = value_type{};
+		this->on_cell_changed_(*c, false, true);
+		return true;
+	}
+
+	/**
+	 * @brief 就地修改格子，格子所在区块必要时被分配，修改后为空时被释放
+	 */
+	template <std::invocable<value_type&> Fn>
+	void modify(const point_type pos, Fn&& fn){
+		chunk& c = this->acquire_chunk_(sparse_grid::chunk_coord_of_(pos));
+		value_type& cell = c.cell(pos);
+		const bool was_empty = sparse_grid::is_empty_(cell);
+		std::invoke(std::forward<Fn>(fn), cell);
+		const bool now_empty = sparse_grid::is_empty_(cell);
+
+		if(was_empty && now_empty && c.occupied == 0){
+			this->release_chunk_(c);
+			return;
+		}
+		this->on_cell_changed_(c, was_empty, now_empty);
+	}
+
+	/**
+	 * @brief 按 Morton 序逐区块访问，区块内按行优先访问非空格子
+	 * @param fn (point_type pos, const value_type& value)
+	 */
+	template <std::invocable<point_type, const value_type&> Fn>
+	void each(Fn fn) const{
+		for(const order_entry& entry : this->chunk_order_()){
+			const chunk& c = *entry.target;
+			const point_type origin{c.coord.x * chunk_extent, c.coord.y * chunk_extent};
+			for(coord_type y = 0; y < chunk_extent; ++y){
+				for(coord_type x = 0; x < chunk_extent; ++x){
+					const value_type& value = c.cells[static_cast<unsigned>(x), static_cast<unsigned>(y)];
+					if(!sparse_grid::is_empty_(value)) std::invoke(fn, point_type{origin.x + x, origin.y + y}, value);
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief 按 Morton 序访问已分配的区块
+	 * @param fn (point_type chunk_coord, const chunk_tile_type& cells)，cells 以区块内坐标行优先索引
+	 */
+	template <std::invocable<point_type, const chunk_tile_type&> Fn>
+	void each_chunk(Fn fn) const{
+		for(const order_entry& entry : this->chunk_order_()){
+			std::invoke(fn, entry.target->coord, std::as_const(entry.target->cells));
+		}
+	}
+
+	/**
+	 * @brief 访问 [src, end) 内的非空格子，每个区块只查找一次，未分配的区块整体跳过
+	 * @param fn (point_type pos, const value_type& value)
+	 */
+	template <std::invocable<point_type, const value_type&> Fn>
+	void for_each_in_rect(const point_type src, const point_type end, Fn fn) const{
+		if(src.x >= end.x || src.y >= end.y) return;
+
+		const point_type chunk_src = sparse_grid::chunk_coord_of_(src);
+		const point_type chunk_end = sparse_grid::chunk_coord_of_({end.x - 1, end.y - 1});
+
+		for(coord_type cy = chunk_src.y; cy <= chunk_end.y; ++cy){
+			for(coord_type cx = chunk_src.x; cx <= chunk_end.x; ++cx){
+				const chunk* c = this->find_chunk_({cx, cy});
+				if(!c) continue;
+
+				const coord_type ox = cx * chunk_extent, oy = cy * chunk_extent;
+				const coord_type x0 = std::max(src.x - ox, 0), x1 = std::min(end.x - ox, chunk_extent);
+				const coord_type y0 = std::max(src.y - oy, 0), y1 = std::min(end.y - oy, chunk_extent);
+
+				for(coord_type y = y0; y < y1; ++y){
+					for(coord_type x = x0; x < x1; ++x){
+						const value_type& value = c->cells[static_cast<unsigned>(x), static_cast<unsigned>(y)];
+						if(!sparse_grid::is_empty_(value)) std::invoke(fn, point_type{ox + x, oy + y}, value);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief 访问 pos 的各个邻格（包括空格子），可跨越区块边界
+	 *
+	 * pos 周围 3x3 的区块指针在本次调用内按需解析并复用，邻格访问不逐格查表。
+	 *
+	 * @param offsets 相对 pos 的偏移，各分量的绝对值不得超过 chunk_extent
+	 * @param fn (point_type pos, const value_type& value)
+	 */
+	template <std::invocable<point_type, const value_type&> Fn>
+	void for_each_neighbor(const point_type pos, std::span<const point_type> offsets, Fn fn) const{
+		const point_type center = sparse_grid::chunk_coord_of_(pos);
+		std::array<const chunk*, 9> memo{};
+		std::uint16_t resolved{};
+
+		for(const point_type offset : offsets){
+			assert(std::abs(offset.x) <= chunk_extent && std::abs(offset.y) <= chunk_extent);
+
+			const point_type p{pos.x + offset.x, pos.y + offset.y};
+			const point_type chunk_coord = sparse_grid::chunk_coord_of_(p);
+			const unsigned slot = static_cast<unsigned>((chunk_coord.y - center.y + 1) * 3 + (chunk_coord.x - center.x + 1));
+
+			if(!(resolved & (1u << slot))){
+				resolved |= static_cast<std::uint16_t>(1u << slot);
+				memo[slot] = this->find_chunk_(chunk_coord);
+			}
+
+			std::invoke(fn, p, memo[slot] ? memo[slot]->cell(p) : empty_value);
+		}
+	}
+
+	template <std::invocable<point_type, const value_type&> Fn>
+	void for_each_neighbor_4(const point_type pos, Fn fn) const{
+		this->for_each_neighbor(pos, neighbors_4, std::move(fn));
+	}
+
+	template <std::invocable<point_type, const value_type&> Fn>
+	void for_each_neighbor_8(const point_type pos, Fn fn) const{
+		this->for_each_neighbor(pos, neighbors_8, std::move(fn));
+	}
+};
+}
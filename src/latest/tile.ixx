@@ -112,7 +112,7 @@ export namespace mo_yanxi::dim2{
 			}
 
 			constexpr difference_type operator-(const tile_adaptor_iterator other) const noexcept{
-				return std::distance(data, other.data);
+				return data - other.data;
 			}
 
 			decltype(auto) operator[](const difference_type idx) const noexcept{
@@ -615,7 +615,7 @@ export namespace mo_yanxi::dim2{
 			}
 
 			constexpr difference_type operator-(const tile_iterator other) const noexcept{
-				return std::distance(data, other.data);
+				return data - other.data;
 			}
 
 			decltype(auto) operator[](const difference_type idx) const noexcept{
@@ -660,7 +660,7 @@ export namespace mo_yanxi::dim2{
 		/*constexpr*/
 		tile(const tile& other)
 			: tile{other.width(), other.height()}{
-			this->copy(other.data(), this->extent());
+			this->copy(other.data(), this->size());
 		}
 
 		/*constexpr*/
@@ -674,7 +674,7 @@ export namespace mo_yanxi::dim2{
 				this->operator=(tile{other.width(), other.height()});
 			}
 
-			this->copy(other.data(), this->extent());
+			this->copy(other.data(), this->size());
 
 			return *this;
 		}
@@ -0,0 +1,510 @@
+module;
+
+#include "mo_yanxi/adapted_attributes.hpp"
+#include <cassert>
+
+export module mo_yanxi.dim2.tile_layout;
+
+export import mo_yanxi.dim2.tile;
+import ext.dim2.plane_concept;
+import mo_yanxi.math.vector2;
+import std;
+
+namespace mo_yanxi::dim2{
+	namespace layout_detail{
+		[[nodiscard]] CONST_FN FORCE_INLINE constexpr std::uint64_t spread_bits(const std::uint64_t value) noexcept{
+			std::uint64_t v = value & 0xFFFF'FFFFull;
+			v = (v | v << 16) & 0x0000'FFFF'0000'FFFFull;
+			v = (v | v << 8) & 0x00FF'00FF'00FF'00FFull;
+			v = (v | v << 4) & 0x0F0F'0F0F'0F0F'0F0Full;
+			v = (v | v << 2) & 0x3333'3333'3333'3333ull;
+			v = (v | v << 1) & 0x5555'5555'5555'5555ull;
+			return v;
+		}
+
+		[[nodiscard]] CONST_FN FORCE_INLINE constexpr std::uint64_t compact_bits(const std::uint64_t value) noexcept{
+			std::uint64_t v = value & 0x5555'5555'5555'5555ull;
+			v = (v | v >> 1) & 0x3333'3333'3333'3333ull;
+			v = (v | v >> 2) & 0x0F0F'0F0F'0F0F'0F0Full;
+			v = (v | v >> 4) & 0x00FF'00FF'00FF'00FFull;
+			v = (v | v >> 8) & 0x0000'FFFF'0000'FFFFull;
+			v = (v | v >> 16) & 0x0000'0000'FFFF'FFFFull;
+			return v;
+		}
+
+		/**
+		 * @brief 容纳 [0, extent) 所需的二进制位数
+		 */
+		template <std::unsigned_integral T>
+		[[nodiscard]] CONST_FN constexpr unsigned bits_for(const T extent) noexcept{
+			return extent <= 1 ? 0 : static_cast<unsigned>(std::bit_width(static_cast<T>(extent - 1)));
+		}
+
+		template <typename Mapping>
+		concept coord_invertible = requires(const Mapping& mapping, typename Mapping::index_type index){
+			{ mapping.to_coord(index) } -> std::same_as<std::array<typename Mapping::index_type, 2>>;
+		};
+	}
+
+	/**
+	 * @brief 以 2^BlockShift 见方的块存储的二维布局，块内行优先，块之间行优先
+	 *
+	 * 满足 std::mdspan 的 LayoutPolicy 要求，下标顺序与 to_mdspan_row_major 一致，为 (y, x)。
+	 * 宽高不是块边长的整数倍时，末行 / 末列的块含有填充元素，required_span_size 计入填充。
+	 */
+	export
+	template <unsigned BlockShift>
+		requires (BlockShift > 0 && BlockShift < 8)
+	struct tile_layout_blocked{
+		static constexpr unsigned block_shift = BlockShift;
+		static constexpr std::size_t block_extent = std::size_t{1} << BlockShift;
+
+		template <typename Extents>
+			requires (Extents::rank() == 2)
+		class mapping{
+		public:
+			using extents_type = Extents;
+			using index_type = typename extents_type::index_type;
+			using size_type = typename extents_type::size_type;
+			using rank_type = typename extents_type::rank_type;
+			using layout_type = tile_layout_blocked;
+
+		private:
+			static constexpr index_type block_mask = static_cast<index_type>(block_extent - 1);
+
+			ADAPTED_NO_UNIQUE_ADDRESS extents_type extents_{};
+			index_type blocks_per_row_{};
+
+			[[nodiscard]] static constexpr index_type block_count(const index_type extent) noexcept{
+				return static_cast<index_type>((extent + block_mask) >> BlockShift);
+			}
+
+		public:
+			[[nodiscard]] constexpr mapping() noexcept = default;
+
+			[[nodiscard]] constexpr explicit(false) mapping(const extents_type& extents) noexcept
+				: extents_(extents), blocks_per_row_(mapping::block_count(extents.extent(1))){
+			}
+
+			[[nodiscard]] constexpr const extents_type& extents() const noexcept{
+				return extents_;
+			}
+
+			[[nodiscard]] constexpr index_type required_span_size() const noexcept{
+				return static_cast<index_type>(mapping::block_count(extents_.extent(0)) * blocks_per_row_ << (BlockShift * 2));
+			}
+
+			template <std::integral I0, std::integral I1>
+			[[nodiscard]] FORCE_INLINE constexpr index_type operator()(const I0 row, const I1 col) const noexcept{
+				const auto y = static_cast<index_type>(row);
+				const auto x = static_cast<index_type>(col);
+				assert(y < extents_.extent(0) && x < extents_.extent(1));
+
+				const index_type block = (y >> BlockShift) * blocks_per_row_ + (x >> BlockShift);
+				return static_cast<index_type>(block << (BlockShift * 2) | (y & block_mask) << BlockShift | (x & block_mask));
+			}
+
+			/**
+			 * @return 存储下标对应的 {y, x}，填充元素的坐标位于 extents 之外
+			 */
+			[[nodiscard]] constexpr std::array<index_type, 2> to_coord(const index_type index) const noexcept{
+				const index_type block = index >> (BlockShift * 2);
+				const index_type local = index & static_cast<index_type>(block_extent * block_extent - 1);
+				return {
+						static_cast<index_type>((block / blocks_per_row_) << BlockShift | local >> BlockShift),
+						static_cast<index_type>((block % blocks_per_row_) << BlockShift | (local & block_mask))
+					};
+			}
+
+			[[nodiscard]] static constexpr bool is_always_unique() noexcept{ return true; }
+			[[nodiscard]] static constexpr bool is_always_exhaustive() noexcept{ return false; }
+			[[nodiscard]] static constexpr bool is_always_strided() noexcept{ return false; }
+
+			[[nodiscard]] static constexpr bool is_unique() noexcept{ return true; }
+			[[nodiscard]] constexpr bool is_exhaustive() const noexcept{
+				return this->required_span_size() == extents_.extent(0) * extents_.extent(1);
+			}
+			[[nodiscard]] static constexpr bool is_strided() noexcept{ return false; }
+
+			friend constexpr bool operator==(const mapping& lhs, const mapping& rhs) noexcept{
+				return lhs.extents() == rhs.extents();
+			}
+		};
+	};
+
+	export using tile_layout_block8 = tile_layout_blocked<3>;
+	export using tile_layout_block16 = tile_layout_blocked<4>;
+
+	/**
+	 * @brief Morton（Z 序）二维布局
+	 *
+	 * 每维补齐到 2 的幂；两维位数不等时，低位按 x 偶位、y 奇位交错，较长一维多出的高位直接拼接在最高处，
+	 * 因而任意 2^k 见方的对齐子块都是连续的。
+	 *
+	 * @pre 两维补齐后的位数之和小于 index_type 的位数，例如 32 位有符号下标最多容纳 2^31 个存储元素
+	 */
+	export
+	struct tile_layout_morton{
+		template <typename Extents>
+			requires (Extents::rank() == 2)
+		class mapping{
+		public:
+			using extents_type = Extents;
+			using index_type = typename extents_type::index_type;
+			using size_type = typename extents_type::size_type;
+			using rank_type = typename extents_type::rank_type;
+			using layout_type = tile_layout_morton;
+
+		private:
+			ADAPTED_NO_UNIQUE_ADDRESS extents_type extents_{};
+			std::uint8_t bits_y_{};
+			std::uint8_t bits_x_{};
+
+			[[nodiscard]] constexpr unsigned shared_bits() const noexcept{
+				return std::min(bits_x_, bits_y_);
+			}
+
+		public:
+			[[nodiscard]] constexpr mapping() noexcept = default;
+
+			[[nodiscard]] constexpr explicit(false) mapping(const extents_type& extents) noexcept
+				: extents_(extents),
+				  bits_y_(static_cast<std::uint8_t>(layout_detail::bits_for(static_cast<std::make_unsigned_t<index_type>>(extents.extent(0))))),
+				  bits_x_(static_cast<std::uint8_t>(layout_detail::bits_for(static_cast<std::make_unsigned_t<index_type>>(extents.extent(1))))){
+				assert(bits_x_ <= 32 && bits_y_ <= 32);
+				// 补齐后的存储大小 2^(bits_x + bits_y) 须能以 index_type 表示
+				assert(bits_x_ + bits_y_ < std::numeric_limits<index_type>::digits && "morton layout exceeds index_type range");
+			}
+
+			[[nodiscard]] constexpr const extents_type& extents() const noexcept{
+				return extents_;
+			}
+
+			[[nodiscard]] constexpr index_type required_span_size() const noexcept{
+				if(extents_.extent(0) == 0 || extents_.extent(1) == 0) return 0;
+				return static_cast<index_type>(std::uint64_t{1} << (bits_x_ + bits_y_));
+			}
+
+			template <std::integral I0, std::integral I1>
+			[[nodiscard]] FORCE_INLINE constexpr index_type operator()(const I0 row, const I1 col) const noexcept{
+				const auto y = static_cast<std::uint64_t>(row);
+				const auto x = static_cast<std::uint64_t>(col);
+				assert(y < static_cast<std::uint64_t>(extents_.extent(0)) && x < static_cast<std::uint64_t>(extents_.extent(1)));
+
+				const unsigned shared = this->shared_bits();
+				const std::uint64_t low_mask = (std::uint64_t{1} << shared) - 1;
+				const std::uint64_t high = (bits_x_ > bits_y_ ? x : y) >> shared;
+				return static_cast<index_type>(
+					high << (shared * 2) | layout_detail::spread_bits(x & low_mask) | layout_detail::spread_bits(y & low_mask) << 1);
+			}
+
+			/**
+			 * @return 存储下标对应的 {y, x}，填充元素的坐标位于 extents 之外
+			 */
+			[[nodiscard]] constexpr std::array<index_type, 2> to_coord(const index_type index) const noexcept{
+				const unsigned shared = this->shared_bits();
+				const auto i = static_cast<std::uint64_t>(index);
+				const std::uint64_t high = i >> (shared * 2);
+				std::uint64_t x = layout_detail::compact_bits(i);
+				std::uint64_t y = layout_detail::compact_bits(i >> 1);
+				x &= (std::uint64_t{1} << shared) - 1;
+				y &= (std::uint64_t{1} << shared) - 1;
+				(bits_x_ > bits_y_ ? x : y) |= high << shared;
+				return {static_cast<index_type>(y), static_cast<index_type>(x)};
+			}
+
+			[[nodiscard]] static constexpr bool is_always_unique() noexcept{ return true; }
+			[[nodiscard]] static constexpr bool is_always_exhaustive() noexcept{ return false; }
+			[[nodiscard]] static constexpr bool is_always_strided() noexcept{ return false; }
+
+			[[nodiscard]] static constexpr bool is_unique() noexcept{ return true; }
+			[[nodiscard]] constexpr bool is_exhaustive() const noexcept{
+				return this->required_span_size() == extents_.extent(0) * extents_.extent(1);
+			}
+			[[nodiscard]] static constexpr bool is_strided() noexcept{ return false; }
+
+			friend constexpr bool operator==(const mapping& lhs, const mapping& rhs) noexcept{
+				return lhs.extents() == rhs.extents();
+			}
+		};
+	};
+
+	export
+	template <typename Layout, typename SizeType = unsigned>
+	concept tile_layout_policy = layout_detail::coord_invertible<typename Layout::template mapping<std::dextents<SizeType, 2>>>;
+
+	/**
+	 * @brief 按 Layout 存储的 tile，适合访问上下邻格的模板式（stencil）遍历
+	 *
+	 * 存储由 required_span_size 个元素组成，填充元素与有效元素以相同的值初始化，但不参与遍历。
+	 * 与行优先的 tile 之间通过构造函数与 to_row_major 转换。
+	 */
+	export
+	template <typename T, typename Layout = tile_layout_block8, std::unsigned_integral SizeType = unsigned, std::size_t MinAlign = 4>
+		requires tile_layout_policy<Layout, SizeType>
+	struct layout_tile{
+		using value_type = T;
+		using size_type = SizeType;
+		using layout_type = Layout;
+		using extents_type = std::dextents<size_type, 2>;
+		using mapping_type = typename layout_type::template mapping<extents_type>;
+		using row_major_type = tile<T, SizeType, MinAlign>;
+
+	private:
+		mapping_type mapping_{};
+		// 仅作为对齐的存储使用，宽度为 required_span_size，高度为 1
+		row_major_type storage_{};
+
+		template <typename Ty>
+		struct cell_iterator_base{
+			using value_type = std::remove_const_t<Ty>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+			using iterator_concept = std::forward_iterator_tag;
+
+			Ty* data{};
+			const mapping_type* mapping{};
+			size_type index{};
+			size_type last{};
+
+			[[nodiscard]] constexpr cell_iterator_base() noexcept = default;
+
+			[[nodiscard]] constexpr cell_iterator_base(Ty* data, const mapping_type* mapping, const size_type index, const size_type last) noexcept
+				: data(data), mapping(mapping), index(index), last(last){
+				this->skip_padding();
+			}
+
+			constexpr Ty& operator*() const noexcept{
+				return data[index];
+			}
+
+			constexpr Ty* operator->() const noexcept{
+				return data + index;
+			}
+
+			/**
+			 * @brief 当前元素的二维坐标
+			 */
+			[[nodiscard]] constexpr math::vector2<size_type> pos() const noexcept{
+				const auto [y, x] = mapping->to_coord(index);
+				return {x, y};
+			}
+
+			constexpr cell_iterator_base& operator++() noexcept{
+				++index;
+				this->skip_padding();
+				return *this;
+			}
+
+			constexpr cell_iterator_base operator++(int) noexcept{
+				const cell_iterator_base tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			constexpr friend bool operator==(const cell_iterator_base& lhs, const cell_iterator_base& rhs) noexcept{
+				return lhs.index == rhs.index;
+			}
+
+		private:
+			constexpr void skip_padding() noexcept{
+				const auto& ext = mapping->extents();
+				for(; index < last; ++index){
+					const auto [y, x] = mapping->to_coord(index);
+					if(y < ext.extent(0) && x < ext.extent(1)) return;
+				}
+			}
+		};
+
+	public:
+		/**
+		 * @brief 按存储顺序遍历全部有效元素，跳过填充，pos() 给出元素坐标
+		 */
+		using iterator = cell_iterator_base<value_type>;
+		using const_iterator = cell_iterator_base<const value_type>;
+
+		[[nodiscard]] constexpr layout_tile() noexcept = default;
+
+		[[nodiscard]] layout_tile(const size_type width, const size_type height, const value_type& init = value_type{})
+			: mapping_(extents_type{height, width}), storage_{mapping_.required_span_size(), 1, init}{
+		}
+
+		/**
+		 * @brief 由行优先的 tile 转换
+		 */
+		[[nodiscard]] explicit layout_tile(const row_major_type& row_major)
+			: layout_tile(row_major.width(), row_major.height()){
+			this->load_row_major(row_major.data());
+		}
+
+		[[nodiscard]] constexpr size_type width() const noexcept{
+			return mapping_.extents().extent(1);
+		}
+
+		[[nodiscard]] constexpr size_type height() const noexcept{
+			return mapping_.extents().extent(0);
+		}
+
+		[[nodiscard]] constexpr math::vector2<size_type> extent() const noexcept{
+			return {width(), height()};
+		}
+
+		[[nodiscard]] constexpr size_type area() const noexcept{
+			return width() * height();
+		}
+
+		[[nodiscard]] constexpr bool empty() const noexcept{
+			return area() == 0;
+		}
+
+		/**
+		 * @brief 含填充的存储元素数
+		 */
+		[[nodiscard]] constexpr size_type storage_size() const noexcept{
+			return storage_.width();
+		}
+
+		[[nodiscard]] constexpr const mapping_type& mapping() const noexcept{
+			return mapping_;
+		}
+
+		[[nodiscard]] constexpr value_type* data() noexcept{
+			return storage_.data();
+		}
+
+		[[nodiscard]] constexpr const value_type* data() const noexcept{
+			return storage_.data();
+		}
+
+		[[nodiscard]] constexpr size_type to_index(const size_type x, const size_type y) const noexcept{
+			return mapping_(y, x);
+		}
+
+		[[nodiscard]] constexpr value_type& at(const size_type x, const size_type y) noexcept{
+			return data()[this->to_index(x, y)];
+		}
+
+		[[nodiscard]] constexpr const value_type& at(const size_type x, const size_type y) const noexcept{
+			return data()[this->to_index(x, y)];
+		}
+
+		[[nodiscard]] constexpr value_type& at(const position_acquireable<size_type> auto& pos) noexcept{
+			return this->at(pos.x, pos.y);
+		}
+
+		[[nodiscard]] constexpr const value_type& at(const position_acquireable<size_type> auto& pos) const noexcept{
+			return this->at(pos.x, pos.y);
+		}
+
+		[[nodiscard]] constexpr value_type& operator[](const size_type x, const size_type y) noexcept{
+			return this->at(x, y);
+		}
+
+		[[nodiscard]] constexpr const value_type& operator[](const size_type x, const size_type y) const noexcept{
+			return this->at(x, y);
+		}
+
+		[[nodiscard]] constexpr iterator begin() noexcept{
+			return iterator{data(), &mapping_, 0, storage_size()};
+		}
+
+		[[nodiscard]] constexpr iterator end() noexcept{
+			return iterator{data(), &mapping_, storage_size(), storage_size()};
+		}
+
+		[[nodiscard]] constexpr const_iterator begin() const noexcept{
+			return const_iterator{data(), &mapping_, 0, storage_size()};
+		}
+
+		[[nodiscard]] constexpr const_iterator end() const noexcept{
+			return const_iterator{data(), &mapping_, storage_size(), storage_size()};
+		}
+
+		/**
+		 * @brief 下标顺序为 (y, x)，与 tile::to_mdspan_row_major 一致
+		 */
+		[[nodiscard]] constexpr auto to_mdspan() noexcept{
+			return std::mdspan<value_type, extents_type, layout_type>{data(), mapping_};
+		}
+
+		[[nodiscard]] constexpr auto to_mdspan() const noexcept{
+			return std::mdspan<const value_type, extents_type, layout_type>{data(), mapping_};
+		}
+
+		/**
+		 * @brief 按存储顺序访问有效元素，fn(value, x, y)
+		 */
+		template <std::invocable<value_type&, size_type, size_type> Fn>
+		constexpr void each(Fn fn){
+			this->each_impl(*this, fn);
+		}
+
+		template <std::invocable<const value_type&, size_type, size_type> Fn>
+		constexpr void each(Fn fn) const{
+			this->each_impl(*this, fn);
+		}
+
+		/**
+		 * @brief 从 width() * height() 个行优先元素载入
+		 */
+		void load_row_major(const value_type* src){
+			this->each([&, w = static_cast<std::size_t>(width())](value_type& v, const size_type x, const size_type y){
+				v = src[w * y + x];
+			});
+		}
+
+		/**
+		 * @brief 写出 width() * height() 个行优先元素
+		 */
+		void store_row_major(value_type* dst) const{
+			this->each([&, w = static_cast<std::size_t>(width())](const value_type& v, const size_type x, const size_type y){
+				dst[w * y + x] = v;
+			});
+		}
+
+		[[nodiscard]] row_major_type to_row_major() const{
+			row_major_type rst{width(), height()};
+			this->store_row_major(rst.data());
+			return rst;
+		}
+
+	private:
+		template <typename S, typename Fn>
+		static constexpr void each_impl(S& self, Fn& fn){
+			if constexpr (requires{ layout_type::block_shift; }){
+				// 分块布局：逐块按行访问，边缘块裁去填充，无需逐元素反算坐标
+				constexpr size_type block = static_cast<size_type>(layout_type::block_extent);
+				for(size_type by = 0; by < self.height(); by += block){
+					const size_type y_end = std::min<size_type>(by + block, self.height());
+					for(size_type bx = 0; bx < self.width(); bx += block){
+						const size_type x_end = std::min<size_type>(bx + block, self.width());
+						auto* block_data = self.data() + self.to_index(bx, by);
+						for(size_type y = by; y < y_end; ++y){
+							auto* row = block_data + static_cast<std::size_t>(y - by) * block;
+							for(size_type x = bx; x < x_end; ++x){
+								std::invoke(fn, row[x - bx], x, y);
+							}
+						}
+					}
+				}
+			} else{
+				for(auto it = self.begin(); it != self.end(); ++it){
+					const auto p = it.pos();
+					std::invoke(fn, *it, p.x, p.y);
+				}
+			}
+		}
+	};
+
+	export
+	template <typename T, std::unsigned_integral SizeType = unsigned>
+	using block8_tile = layout_tile<T, tile_layout_block8, SizeType>;
+
+	export
+	template <typename T, std::unsigned_integral SizeType = unsigned>
+	using block16_tile = layout_tile<T, tile_layout_block16, SizeType>;
+
+	export
+	template <typename T, std::unsigned_integral SizeType = unsigned>
+	using morton_tile = layout_tile<T, tile_layout_morton, SizeType>;
+}
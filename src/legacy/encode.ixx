@@ -1,39 +1,19 @@
 module;
 
-#if defined(_WIN32) || defined(_WIN64)
-#define WIN_SYS
-#include <Windows.h>
-#else
-
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#ifdef __AVX2__
+#define MO_YANXI_ENCODE_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define MO_YANXI_ENCODE_SSE2
+#include <emmintrin.h>
 #endif
 
 export module mo_yanxi.encode;
 
 import std;
 
-
-template <typename ToType>
-using MultiByteBuffer = std::array<ToType, 4 / sizeof(ToType)>;
-
-template <typename ToType, typename FromType>
-MultiByteBuffer<ToType> convertTo(FromType charCode){
-	MultiByteBuffer<ToType> buffer{};
-#ifdef WIN_SYS
-	int failed{};
-
-	::WideCharToMultiByte(
-		CP_UTF8, 0,
-		reinterpret_cast<wchar_t*>(&charCode), 1,
-		reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(ToType),
-		nullptr, &failed);
-
-	if(failed){
-		//TODO warning or exception here
-	}
-#endif
-	return buffer;
-}
-
 namespace mo_yanxi::encode{
 
 	using CharBuffer = std::array<char, 4>;
@@ -50,9 +30,380 @@ namespace mo_yanxi::encode{
 		}
 	}
 
+	/**
+	 * @brief 批量接口遇到非法输入时的替换字符
+	 */
+	export constexpr char32_t replacement_character = U'\uFFFD';
+
+	namespace detail{
+		[[nodiscard]] FORCE_INLINE constexpr bool is_continuation(const unsigned char c) noexcept{
+			return (c & 0xC0) == 0x80;
+		}
+
+		/**
+		 * @brief 解码一个 UTF-8 序列，拒绝过长编码、代理区与超出 U+10FFFF 的码点
+		 * @return 序列长度，非法或不完整时为 0
+		 */
+		[[nodiscard]] FORCE_INLINE constexpr unsigned decode_one(const unsigned char* p, const std::size_t remain, char32_t& code) noexcept{
+			const unsigned c0 = p[0];
+			if(c0 < 0x80){
+				code = c0;
+				return 1;
+			}
+
+			if(c0 < 0xC2) return 0;
+
+			if(c0 < 0xE0){
+				if(remain < 2 || !detail::is_continuation(p[1])) return 0;
+				code = (c0 & 0x1F) << 6 | (p[1] & 0x3F);
+				return 2;
+			}
+
+			if(c0 < 0xF0){
+				if(remain < 3 || !detail::is_continuation(p[1]) || !detail::is_continuation(p[2])) return 0;
+				if(c0 == 0xE0 && p[1] < 0xA0) return 0;
+				if(c0 == 0xED && p[1] > 0x9F) return 0;
+				code = (c0 & 0x0F) << 12 | (p[1] & 0x3F) << 6 | (p[2] & 0x3F);
+				return 3;
+			}
+
+			if(c0 < 0xF5){
+				if(remain < 4 || !detail::is_continuation(p[1]) || !detail::is_continuation(p[2]) || !detail::is_continuation(p[3])) return 0;
+				if(c0 == 0xF0 && p[1] < 0x90) return 0;
+				if(c0 == 0xF4 && p[1] > 0x8F) return 0;
+				code = (c0 & 0x07) << 18 | (p[1] & 0x3F) << 12 | (p[2] & 0x3F) << 6 | (p[3] & 0x3F);
+				return 4;
+			}
+
+			return 0;
+		}
+
+		[[nodiscard]] FORCE_INLINE constexpr bool is_scalar_value(const char32_t code) noexcept{
+			return code < 0xD800 || (code > 0xDFFF && code <= 0x10FFFF);
+		}
+
+		[[nodiscard]] FORCE_INLINE constexpr unsigned utf_8_size_of(const char32_t code) noexcept{
+			return 1 + (code >= 0x80) + (code >= 0x800) + (code >= 0x10000);
+		}
+
+		/**
+		 * @brief code 须为合法标量值
+		 * @return 写入的字节数
+		 */
+		FORCE_INLINE constexpr unsigned encode_one(const char32_t code, char* out) noexcept{
+			if(code < 0x80){
+				out[0] = static_cast<char>(code);
+				return 1;
+			}
+
+			if(code < 0x800){
+				out[0] = static_cast<char>(0xC0 | code >> 6);
+				out[1] = static_cast<char>(0x80 | (code & 0x3F));
+				return 2;
+			}
+
+			if(code < 0x10000){
+				out[0] = static_cast<char>(0xE0 | code >> 12);
+				out[1] = static_cast<char>(0x80 | (code >> 6 & 0x3F));
+				out[2] = static_cast<char>(0x80 | (code & 0x3F));
+				return 3;
+			}
+
+			out[0] = static_cast<char>(0xF0 | code >> 18);
+			out[1] = static_cast<char>(0x80 | (code >> 12 & 0x3F));
+			out[2] = static_cast<char>(0x80 | (code >> 6 & 0x3F));
+			out[3] = static_cast<char>(0x80 | (code & 0x3F));
+			return 4;
+		}
+
+		/**
+		 * @return 首个非法序列的起始位置，合法时为 end
+		 */
+		[[nodiscard]] constexpr const unsigned char* validate_scalar(const unsigned char* p, const unsigned char* end) noexcept{
+			while(p != end){
+				char32_t code;
+				const unsigned length = detail::decode_one(p, static_cast<std::size_t>(end - p), code);
+				if(!length) return p;
+				p += length;
+			}
+			return end;
+		}
+
+		/**
+		 * @brief 统计非续字节数 (code points) 与四字节首字节数 (需要代理对的码点)
+		 */
+		struct utf_8_counts{
+			std::size_t heads;
+			std::size_t four_byte_heads;
+		};
+
+		[[nodiscard]] inline utf_8_counts count_heads(const unsigned char* p, const unsigned char* end) noexcept{
+			utf_8_counts counts{};
+
+#ifdef MO_YANXI_ENCODE_AVX2
+			const __m256i continuation_max = _mm256_set1_epi8(static_cast<char>(0xBF));
+			const __m256i four_byte_min = _mm256_set1_epi8(static_cast<char>(0xF0 - 1));
+			while(end - p >= 32){
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				// 有符号比较下 0x80..0xBF 即 -128..-65，恰为续字节
+				const auto heads = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, continuation_max)));
+				const auto below_four = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+					_mm256_cmpeq_epi8(_mm256_subs_epu8(v, four_byte_min), _mm256_setzero_si256())));
+				counts.heads += std::popcount(heads);
+				counts.four_byte_heads += 32 - std::popcount(below_four);
+				p += 32;
+			}
+#elif defined(MO_YANXI_ENCODE_SSE2)
+			const __m128i continuation_max = _mm_set1_epi8(static_cast<char>(0xBF));
+			const __m128i four_byte_min = _mm_set1_epi8(static_cast<char>(0xF0 - 1));
+			while(end - p >= 16){
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const auto heads = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, continuation_max)));
+				const auto below_four = static_cast<std::uint32_t>(_mm_movemask_epi8(
+					_mm_cmpeq_epi8(_mm_subs_epu8(v, four_byte_min), _mm_setzero_si128())));
+				counts.heads += std::popcount(heads);
+				counts.four_byte_heads += 16 - std::popcount(below_four);
+				p += 16;
+			}
+#endif
+
+			for(; p != end; ++p){
+				counts.heads += !detail::is_continuation(*p);
+				counts.four_byte_heads += *p >= 0xF0;
+			}
+			return counts;
+		}
+
+		/**
+		 * @return [p, p + 32) 是否全为 ASCII，尾部不足时为 false
+		 */
+		[[nodiscard]] FORCE_INLINE bool ascii_block(const unsigned char* p, const unsigned char* end) noexcept{
+#ifdef MO_YANXI_ENCODE_AVX2
+			return end - p >= 32 && _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) == 0;
+#elif defined(MO_YANXI_ENCODE_SSE2)
+			return end - p >= 32 && (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))
+				| _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)))) == 0;
+#else
+			if(end - p < 32) return false;
+			std::uint64_t bits[4];
+			std::memcpy(bits, p, sizeof(bits));
+			return ((bits[0] | bits[1] | bits[2] | bits[3]) & 0x8080808080808080ull) == 0;
+#endif
+		}
+
+#ifdef MO_YANXI_ENCODE_AVX2
+		/**
+		 * @brief 基于查表的 UTF-8 校验 (Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte")
+		 *
+		 * 每 32 字节用三次 pshufb 分别查询前一字节的高 / 低半字节与当前字节的高半字节，
+		 * 三者按位与后非零即为非法的二字节组合；三、四字节序列的续字节个数另由饱和减法检查。
+		 */
+		class utf_8_checker{
+			static constexpr std::uint8_t too_short = 1 << 0;
+			static constexpr std::uint8_t too_long = 1 << 1;
+			static constexpr std::uint8_t overlong_3 = 1 << 2;
+			static constexpr std::uint8_t too_large = 1 << 3;
+			static constexpr std::uint8_t surrogate = 1 << 4;
+			static constexpr std::uint8_t overlong_2 = 1 << 5;
+			static constexpr std::uint8_t too_large_1000 = 1 << 6;
+			static constexpr std::uint8_t overlong_4 = 1 << 6;
+			static constexpr std::uint8_t two_conts = 1 << 7;
+			static constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+			__m256i error_ = _mm256_setzero_si256();
+			__m256i prev_input_ = _mm256_setzero_si256();
+			__m256i prev_incomplete_ = _mm256_setzero_si256();
+
+			[[nodiscard]] static FORCE_INLINE __m256i table(
+				const std::uint8_t v0, const std::uint8_t v1, const std::uint8_t v2, const std::uint8_t v3,
+				const std::uint8_t v4, const std::uint8_t v5, const std::uint8_t v6, const std::uint8_t v7,
+				const std::uint8_t v8, const std::uint8_t v9, const std::uint8_t v10, const std::uint8_t v11,
+				const std::uint8_t v12, const std::uint8_t v13, const std::uint8_t v14, const std::uint8_t v15) noexcept{
+				return _mm256_broadcastsi128_si256(_mm_setr_epi8(
+					static_cast<char>(v0), static_cast<char>(v1), static_cast<char>(v2), static_cast<char>(v3),
+					static_cast<char>(v4), static_cast<char>(v5), static_cast<char>(v6), static_cast<char>(v7),
+					static_cast<char>(v8), static_cast<char>(v9), static_cast<char>(v10), static_cast<char>(v11),
+					static_cast<char>(v12), static_cast<char>(v13), static_cast<char>(v14), static_cast<char>(v15)));
+			}
+
+			template <int N>
+			[[nodiscard]] static FORCE_INLINE __m256i prev(const __m256i input, const __m256i prev_input) noexcept{
+				return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - N);
+			}
+
+			[[nodiscard]] static FORCE_INLINE __m256i high_nibble(const __m256i v) noexcept{
+				return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+			}
+
+			[[nodiscard]] static FORCE_INLINE __m256i special_cases(const __m256i input, const __m256i prev1) noexcept{
+				const __m256i byte_1_high = _mm256_shuffle_epi8(utf_8_checker::table(
+					too_long, too_long, too_long, too_long,
+					too_long, too_long, too_long, too_long,
+					two_conts, two_conts, two_conts, two_conts,
+					too_short | overlong_2,
+					too_short,
+					too_short | overlong_3 | surrogate,
+					too_short | too_large | too_large_1000 | overlong_4
+				), utf_8_checker::high_nibble(prev1));
+
+				const __m256i byte_1_low = _mm256_shuffle_epi8(utf_8_checker::table(
+					carry | overlong_3 | overlong_2 | overlong_4,
+					carry | overlong_2,
+					carry,
+					carry,
+					carry | too_large,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000 | surrogate,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000
+				), _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+
+				const __m256i byte_2_high = _mm256_shuffle_epi8(utf_8_checker::table(
+					too_short, too_short, too_short, too_short,
+					too_short, too_short, too_short, too_short,
+					too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+					too_long | overlong_2 | two_conts | overlong_3 | too_large,
+					too_long | overlong_2 | two_conts | surrogate | too_large,
+					too_long | overlong_2 | two_conts | surrogate | too_large,
+					too_short, too_short, too_short, too_short
+				), utf_8_checker::high_nibble(input));
+
+				return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+			}
+
+		public:
+			FORCE_INLINE void check(const __m256i input) noexcept{
+				if(_mm256_movemask_epi8(input) == 0){
+					error_ = _mm256_or_si256(error_, prev_incomplete_);
+					prev_incomplete_ = _mm256_setzero_si256();
+					prev_input_ = input;
+					return;
+				}
+
+				const __m256i prev1 = utf_8_checker::prev<1>(input, prev_input_);
+				const __m256i special = utf_8_checker::special_cases(input, prev1);
+
+				// 只有 111_____ / 1111____ 经饱和减法后不小于 0x80，即该位置必须为第 3 / 4 个字节
+				const __m256i is_third = _mm256_subs_epu8(utf_8_checker::prev<2>(input, prev_input_), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				const __m256i is_fourth = _mm256_subs_epu8(utf_8_checker::prev<3>(input, prev_input_), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				const __m256i must_23 = _mm256_and_si256(_mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+				error_ = _mm256_or_si256(error_, _mm256_xor_si256(must_23, special));
+
+				// 块尾三字节中尚未结束的多字节序列
+				const __m256i max_value = _mm256_setr_epi8(
+					-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+					-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+					static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+				prev_incomplete_ = _mm256_subs_epu8(input, max_value);
+				prev_input_ = input;
+			}
+
+			/**
+			 * @brief 输入结束，之前未完成的序列视为错误
+			 */
+			FORCE_INLINE void finish() noexcept{
+				error_ = _mm256_or_si256(error_, prev_incomplete_);
+			}
+
+			[[nodiscard]] FORCE_INLINE bool has_error() const noexcept{
+				return !_mm256_testz_si256(error_, error_);
+			}
+		};
+#endif
+
+		FORCE_INLINE void widen_ascii(const unsigned char* src, char32_t* dst) noexcept{
+#ifdef MO_YANXI_ENCODE_AVX2
+			for(unsigned i = 0; i < 32; i += 8){
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+			}
+#else
+			for(unsigned i = 0; i < 32; ++i) dst[i] = src[i];
+#endif
+		}
+
+		FORCE_INLINE void widen_ascii(const unsigned char* src, char16_t* dst) noexcept{
+#ifdef MO_YANXI_ENCODE_AVX2
+			for(unsigned i = 0; i < 32; i += 16){
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+			}
+#else
+			for(unsigned i = 0; i < 32; ++i) dst[i] = src[i];
+#endif
+		}
+
+		/**
+		 * @brief [src, src + 16) 全为 ASCII 时收窄写入 dst
+		 * @return 尾部不足或含非 ASCII 时为 false，此时不写入
+		 */
+		[[nodiscard]] FORCE_INLINE bool narrow_ascii(const char32_t* src, const char32_t* end, char* dst) noexcept{
+			if(end - src < 16) return false;
+#ifdef MO_YANXI_ENCODE_AVX2
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 8));
+			if(!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_set1_epi32(~0x7F))) return false;
+			// packus 按 128 位通道交错，重排后恢复原顺序
+			const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+				_mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1)));
+			return true;
+#elif defined(MO_YANXI_ENCODE_SSE2)
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12));
+			const __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32(~0x7F));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF) return false;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+			return true;
+#else
+			char32_t high{};
+			for(unsigned i = 0; i < 16; ++i) high |= src[i];
+			if(high >= 0x80) return false;
+			for(unsigned i = 0; i < 16; ++i) dst[i] = static_cast<char>(src[i]);
+			return true;
+#endif
+		}
+
+		[[nodiscard]] FORCE_INLINE bool narrow_ascii(const char16_t* src, const char16_t* end, char* dst) noexcept{
+			if(end - src < 16) return false;
+#ifdef MO_YANXI_ENCODE_AVX2
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+			if(!_mm256_testz_si256(v, _mm256_set1_epi16(static_cast<short>(0xFF80)))) return false;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+			return true;
+#elif defined(MO_YANXI_ENCODE_SSE2)
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8));
+			const __m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) return false;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(a, b));
+			return true;
+#else
+			char16_t high{};
+			for(unsigned i = 0; i < 16; ++i) high |= src[i];
+			if(high >= 0x80) return false;
+			for(unsigned i = 0; i < 16; ++i) dst[i] = static_cast<char>(src[i]);
+			return true;
+#endif
+		}
+	}
+
 	export
-	[[nodiscard]] std::array<char, 4> utf_32_to_8(char32_t val) noexcept{
-		return convertTo<char>(val);
+	/**
+	 * @brief 非法码点（代理区或超出 U+10FFFF）编码为 U+FFFD
+	 */
+	[[nodiscard]] constexpr std::array<char, 4> utf_32_to_8(const char32_t val) noexcept{
+		std::array<char, 4> buffer{};
+		detail::encode_one(detail::is_scalar_value(val) ? val : replacement_character, buffer.data());
+		return buffer;
 	}
 
 	export
@@ -69,7 +420,12 @@ namespace mo_yanxi::encode{
 
 	export
 	constexpr std::size_t count_code_points(std::string_view chars) noexcept{
-		return std::ranges::count_if(chars, isUnicodeHead);
+		if consteval{
+			return std::ranges::count_if(chars, isUnicodeHead);
+		} else{
+			const auto begin = reinterpret_cast<const unsigned char*>(chars.data());
+			return detail::count_heads(begin, begin + chars.size()).heads;
+		}
 	}
 
 	export
@@ -139,22 +495,396 @@ namespace mo_yanxi::encode{
 
 
 	export
-	[[nodiscard]] std::string utf_32_to_8(const std::u32string_view str) noexcept{
-		std::string s;
+	enum struct transcode_status : std::uint8_t{
+		ok,
+		invalid_input,
+		/**
+		 * @brief 输出空间不足，已转换的部分有效，可从 read 处继续
+		 */
+		output_exhausted,
+	};
+
+	export
+	struct transcode_result{
+		/**
+		 * @brief 已消耗的输入单元数，失败时即为出错序列的起始位置
+		 */
+		std::size_t read;
+		std::size_t written;
+		transcode_status status;
+
+		[[nodiscard]] constexpr explicit operator bool() const noexcept{
+			return status == transcode_status::ok;
+		}
+	};
+
+	export
+	/**
+	 * @brief 校验 UTF-8，拒绝过长编码、代理区、超出 U+10FFFF 的码点与截断的序列
+	 * @return 首个非法序列的起始偏移，合法时为 chars.size()
+	 */
+	[[nodiscard]] inline std::size_t validate_utf_8(const std::string_view chars) noexcept{
+		const auto begin = reinterpret_cast<const unsigned char*>(chars.data());
+		const auto end = begin + chars.size();
+		const unsigned char* p = begin;
+
+#ifdef MO_YANXI_ENCODE_AVX2
+		detail::utf_8_checker checker{};
+		for(; end - p >= 32; p += 32){
+			checker.check(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+			if(checker.has_error()) break;
+		}
+
+		if(!checker.has_error()){
+			if(p != end){
+				// 以 0 补齐尾块，截断的序列会因后随 ASCII 而报错
+				alignas(32) std::array<unsigned char, 32> tail{};
+				std::memcpy(tail.data(), p, static_cast<std::size_t>(end - p));
+				checker.check(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail.data())));
+			}
+			checker.finish();
+			if(!checker.has_error()) return chars.size();
+		}
+
+		// 出错块之前的输入除末尾未完成的序列外均合法，从块首前三字节内最后一个首字节开始逐码点定位
+		const unsigned char* from = p;
+		for(const unsigned char* q = p; q != begin && p - q < 3;){
+			if(!detail::is_continuation(*--q)){
+				from = q;
+				break;
+			}
+		}
+		return static_cast<std::size_t>(detail::validate_scalar(from, end) - begin);
+#else
+		while(p != end){
+			if(detail::ascii_block(p, end)){
+				p += 32;
+				continue;
+			}
+
+			const unsigned char* const block_end = p + std::min<std::ptrdiff_t>(32, end - p);
+			while(p < block_end){
+				char32_t code;
+				const unsigned length = detail::decode_one(p, static_cast<std::size_t>(end - p), code);
+				if(!length) return static_cast<std::size_t>(p - begin);
+				p += length;
+			}
+		}
+		return chars.size();
+#endif
+	}
+
+	export
+	/**
+	 * @brief 逐码点的参考实现，结果与 validate_utf_8 一致
+	 */
+	[[nodiscard]] inline std::size_t validate_utf_8_scalar(const std::string_view chars) noexcept{
+		const auto begin = reinterpret_cast<const unsigned char*>(chars.data());
+		return static_cast<std::size_t>(detail::validate_scalar(begin, begin + chars.size()) - begin);
+	}
+
+	export
+	[[nodiscard]] inline bool is_valid_utf_8(const std::string_view chars) noexcept{
+		return encode::validate_utf_8(chars) == chars.size();
+	}
+
+	export
+	/**
+	 * @brief 合法 UTF-8 转为 UTF-16 所需的单元数
+	 */
+	[[nodiscard]] inline std::size_t utf_16_length(const std::string_view chars) noexcept{
+		const auto begin = reinterpret_cast<const unsigned char*>(chars.data());
+		const auto [heads, four_byte_heads] = detail::count_heads(begin, begin + chars.size());
+		return heads + four_byte_heads;
+	}
+
+	export
+	/**
+	 * @brief 转为 UTF-8 所需的字节数，非法码点按 U+FFFD 计
+	 */
+	[[nodiscard]] constexpr std::size_t utf_8_length(const std::u32string_view str) noexcept{
+		std::size_t length{};
+		for(const char32_t code : str){
+			length += detail::is_scalar_value(code) ? detail::utf_8_size_of(code) : 3;
+		}
+		return length;
+	}
+
+	export
+	/**
+	 * @brief 转为 UTF-8 所需的字节数，不成对的代理按 U+FFFD 计
+	 */
+	[[nodiscard]] constexpr std::size_t utf_8_length(const std::u16string_view str) noexcept{
+		std::size_t length{};
+		for(std::size_t i = 0; i < str.size(); ++i){
+			const char16_t unit = str[i];
+			if(unit < 0x80){
+				length += 1;
+			} else if(unit < 0x800){
+				length += 2;
+			} else if(unit <= 0xDBFF && unit >= 0xD800 && i + 1 < str.size() && str[i + 1] >= 0xDC00 && str[i + 1] <= 0xDFFF){
+				length += 4;
+				++i;
+			} else{
+				length += 3;
+			}
+		}
+		return length;
+	}
+
+	export
+	/**
+	 * @brief 严格转换，遇到非法序列或输出已满时停止
+	 *
+	 * 整块 ASCII 输入以 SIMD 批量扩展，其余逐码点解码。dst 的大小取 count_code_points(src) 即可容纳合法输入。
+	 */
+	[[nodiscard]] inline transcode_result utf_8_to_32(const std::string_view src, const std::span<char32_t> dst) noexcept{
+		const auto begin = reinterpret_cast<const unsigned char*>(src.data());
+		const auto end = begin + src.size();
+		const unsigned char* p = begin;
+
+		char32_t* const out_begin = dst.data();
+		char32_t* const out_end = out_begin + dst.size();
+		char32_t* out = out_begin;
+
+		const auto result = [&](const transcode_status status) noexcept{
+			return transcode_result{static_cast<std::size_t>(p - begin), static_cast<std::size_t>(out - out_begin), status};
+		};
+
+		while(p != end){
+			if(out_end - out >= 32 && detail::ascii_block(p, end)){
+				detail::widen_ascii(p, out);
+				p += 32;
+				out += 32;
+				continue;
+			}
+
+			// 非 ASCII 块逐码点处理至块尾，避免对同一块反复检测
+			const unsigned char* const block_end = p + std::min<std::ptrdiff_t>(32, end - p);
+			while(p < block_end){
+				char32_t code;
+				const unsigned length = detail::decode_one(p, static_cast<std::size_t>(end - p), code);
+				if(!length) return result(transcode_status::invalid_input);
+				if(out == out_end) return result(transcode_status::output_exhausted);
+				*out++ = code;
+				p += length;
+			}
+		}
+
+		return result(transcode_status::ok);
+	}
+
+	export
+	/**
+	 * @brief 同 utf_8_to_32，dst 的大小取 utf_16_length(src) 即可容纳合法输入
+	 */
+	[[nodiscard]] inline transcode_result utf_8_to_16(const std::string_view src, const std::span<char16_t> dst) noexcept{
+		const auto begin = reinterpret_cast<const unsigned char*>(src.data());
+		const auto end = begin + src.size();
+		const unsigned char* p = begin;
+
+		char16_t* const out_begin = dst.data();
+		char16_t* const out_end = out_begin + dst.size();
+		char16_t* out = out_begin;
+
+		const auto result = [&](const transcode_status status) noexcept{
+			return transcode_result{static_cast<std::size_t>(p - begin), static_cast<std::size_t>(out - out_begin), status};
+		};
+
+		while(p != end){
+			if(out_end - out >= 32 && detail::ascii_block(p, end)){
+				detail::widen_ascii(p, out);
+				p += 32;
+				out += 32;
+				continue;
+			}
+
+			const unsigned char* const block_end = p + std::min<std::ptrdiff_t>(32, end - p);
+			while(p < block_end){
+				char32_t code;
+				const unsigned length = detail::decode_one(p, static_cast<std::size_t>(end - p), code);
+				if(!length) return result(transcode_status::invalid_input);
+
+				if(code < 0x10000){
+					if(out == out_end) return result(transcode_status::output_exhausted);
+					*out++ = static_cast<char16_t>(code);
+				} else{
+					if(out_end - out < 2) return result(transcode_status::output_exhausted);
+					code -= 0x10000;
+					*out++ = static_cast<char16_t>(0xD800 | code >> 10);
+					*out++ = static_cast<char16_t>(0xDC00 | (code & 0x3FF));
+				}
+				p += length;
+			}
+		}
+
+		return result(transcode_status::ok);
+	}
+
+	export
+	/**
+	 * @brief 严格转换，代理区或超出 U+10FFFF 的码点视为非法；dst 的大小取 utf_8_length(src) 即可
+	 */
+	[[nodiscard]] inline transcode_result utf_32_to_8(const std::u32string_view src, const std::span<char> dst) noexcept{
+		const char32_t* const begin = src.data();
+		const char32_t* const end = begin + src.size();
+		const char32_t* p = begin;
+
+		char* const out_begin = dst.data();
+		char* const out_end = out_begin + dst.size();
+		char* out = out_begin;
+
+		const auto result = [&](const transcode_status status) noexcept{
+			return transcode_result{static_cast<std::size_t>(p - begin), static_cast<std::size_t>(out - out_begin), status};
+		};
+
+		while(p != end){
+			if(out_end - out >= 16 && detail::narrow_ascii(p, end, out)){
+				p += 16;
+				out += 16;
+				continue;
+			}
+
+			const char32_t* const block_end = p + std::min<std::ptrdiff_t>(16, end - p);
+			while(p < block_end){
+				const char32_t code = *p;
+				if(!detail::is_scalar_value(code)) return result(transcode_status::invalid_input);
+				if(static_cast<std::size_t>(out_end - out) < detail::utf_8_size_of(code)) return result(transcode_status::output_exhausted);
+				out += detail::encode_one(code, out);
+				++p;
+			}
+		}
+
+		return result(transcode_status::ok);
+	}
+
+	export
+	/**
+	 * @brief 严格转换，不成对的代理视为非法；dst 的大小取 utf_8_length(src) 即可
+	 */
+	[[nodiscard]] inline transcode_result utf_16_to_8(const std::u16string_view src, const std::span<char> dst) noexcept{
+		const char16_t* const begin = src.data();
+		const char16_t* const end = begin + src.size();
+		const char16_t* p = begin;
+
+		char* const out_begin = dst.data();
+		char* const out_end = out_begin + dst.size();
+		char* out = out_begin;
+
+		const auto result = [&](const transcode_status status) noexcept{
+			return transcode_result{static_cast<std::size_t>(p - begin), static_cast<std::size_t>(out - out_begin), status};
+		};
+
+		while(p != end){
+			if(out_end - out >= 16 && detail::narrow_ascii(p, end, out)){
+				p += 16;
+				out += 16;
+				continue;
+			}
+
+			const char16_t* const block_end = p + std::min<std::ptrdiff_t>(16, end - p);
+			while(p < block_end){
+				char32_t code = *p;
+				unsigned units = 1;
+				if(code >= 0xD800 && code <= 0xDFFF){
+					if(code > 0xDBFF || end - p < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF) return result(transcode_status::invalid_input);
+					code = 0x10000 + ((code - 0xD800) << 10 | (p[1] - 0xDC00));
+					units = 2;
+				}
+
+				if(static_cast<std::size_t>(out_end - out) < detail::utf_8_size_of(code)) return result(transcode_status::output_exhausted);
+				out += detail::encode_one(code, out);
+				p += units;
+			}
+		}
 
-		s.reserve(str.size() * 3);
+		return result(transcode_status::ok);
+	}
 
-		for (const char32_t value : str){
-			switch(const auto buf = utf_32_to_8(value); getUnicodeLength(buf[0])){
-			case 1 : s.push_back(buf[0]); break;
-			case 2 : s.push_back(buf[0]); s.push_back(buf[1]); break;
-			case 3 : s.push_back(buf[0]); s.push_back(buf[1]); s.push_back(buf[2]); break;
-			case 4 : s.push_back(buf[0]); s.push_back(buf[1]); s.push_back(buf[2]); s.push_back(buf[3]); break;
-			default : std::unreachable();
+	namespace detail{
+		/**
+		 * @brief 以 strict 转换，每个非法输入单元替换为一个 U+FFFD
+		 *
+		 * 先按 expected 分配（合法输入的精确长度），仅当输入非法导致空间不足时再按上界 bound 重试。
+		 */
+		template <typename To, typename From, typename Strict>
+		[[nodiscard]] std::basic_string<To> transcode_replacing(
+			const std::basic_string_view<From> src, const std::size_t expected, const std::size_t bound, Strict strict){
+			std::basic_string<To> rst;
+			bool complete{};
+
+			for(const std::size_t capacity : {expected, bound}){
+				rst.resize_and_overwrite(capacity, [&](To* buffer, const std::size_t size){
+					std::size_t read{};
+					std::size_t written{};
+					while(true){
+						const transcode_result r = strict(src.substr(read), std::span{buffer + written, size - written});
+						read += r.read;
+						written += r.written;
+						if(r.status != transcode_status::invalid_input){
+							complete = r.status == transcode_status::ok;
+							return written;
+						}
+
+						if constexpr (std::same_as<To, char>){
+							if(size - written < 3) return written;
+							written += detail::encode_one(replacement_character, buffer + written);
+						} else{
+							if(size == written) return written;
+							buffer[written++] = static_cast<To>(replacement_character);
+						}
+						++read;
+					}
+				});
+
+				if(complete) break;
 			}
+
+			return rst;
 		}
+	}
+
+	export
+	/**
+	 * @brief 非法字节各替换为 U+FFFD
+	 */
+	[[nodiscard]] inline std::u32string to_utf_32(const std::string_view src){
+		return detail::transcode_replacing<char32_t>(src, encode::count_code_points(src), src.size(),
+			[](const std::string_view s, const std::span<char32_t> d) noexcept{ return encode::utf_8_to_32(s, d); });
+	}
+
+	export
+	/**
+	 * @brief 非法字节各替换为 U+FFFD
+	 */
+	[[nodiscard]] inline std::u16string to_utf_16(const std::string_view src){
+		return detail::transcode_replacing<char16_t>(src, encode::utf_16_length(src), src.size(),
+			[](const std::string_view s, const std::span<char16_t> d) noexcept{ return encode::utf_8_to_16(s, d); });
+	}
 
-		return s;
+	export
+	/**
+	 * @brief 非法码点替换为 U+FFFD
+	 */
+	[[nodiscard]] inline std::string to_utf_8(const std::u32string_view src){
+		const std::size_t length = encode::utf_8_length(src);
+		return detail::transcode_replacing<char>(src, length, length,
+			[](const std::u32string_view s, const std::span<char> d) noexcept{ return encode::utf_32_to_8(s, d); });
+	}
+
+	export
+	/**
+	 * @brief 不成对的代理替换为 U+FFFD
+	 */
+	[[nodiscard]] inline std::string to_utf_8(const std::u16string_view src){
+		const std::size_t length = encode::utf_8_length(src);
+		return detail::transcode_replacing<char>(src, length, length,
+			[](const std::u16string_view s, const std::span<char> d) noexcept{ return encode::utf_16_to_8(s, d); });
+	}
+
+	export
+	[[nodiscard]] std::string utf_32_to_8(const std::u32string_view str) noexcept{
+		return encode::to_utf_8(str);
 	}
 }
 
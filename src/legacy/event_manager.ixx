@@ -547,3 +547,252 @@ namespace mo_yanxi::events{
 		}
 	};
 }
+
+namespace mo_yanxi::events{
+	/**
+	 * @brief 小对象内联存储的 void(const T&) 监听器，事件类型在注册时擦除
+	 *
+	 * 调用指针直接存放于对象内，派发时不经过虚表；可调用对象不超过 InlineSize 且移动不抛异常时不分配任何内存。
+	 *
+	 * @tparam InlineSize 内联缓冲大小，默认使整个对象占据一条缓存行
+	 */
+	export
+	template <std::size_t InlineSize = 64 - 2 * sizeof(void*)>
+	class basic_inline_listener{
+		using invoke_fn = void(void* storage, const void* event);
+
+		struct vtable{
+			// 移动构造到 dst 并析构 src
+			void (*relocate)(void* dst, void* src) noexcept;
+			void (*destroy)(void* storage) noexcept;
+		};
+
+		template <typename Fn>
+		static constexpr bool stored_inline =
+			sizeof(Fn) <= InlineSize &&
+			alignof(Fn) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<Fn>;
+
+		template <typename Fn>
+		static constexpr vtable inline_vtable{
+			.relocate = +[](void* dst, void* src) noexcept{
+				Fn* from = static_cast<Fn*>(src);
+				std::construct_at(static_cast<Fn*>(dst), std::move(*from));
+				std::destroy_at(from);
+			},
+			.destroy = +[](void* storage) noexcept{
+				std::destroy_at(static_cast<Fn*>(storage));
+			}
+		};
+
+		template <typename Fn>
+		static constexpr vtable heap_vtable{
+			.relocate = +[](void* dst, void* src) noexcept{
+				*static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+			},
+			.destroy = +[](void* storage) noexcept{
+				delete *static_cast<Fn**>(storage);
+			}
+		};
+
+		// 与 std::function 一致，const 派发允许调用 mutable 的可调用对象
+		alignas(std::max_align_t) mutable std::byte storage_[InlineSize];
+		invoke_fn* invoke_{};
+		const vtable* vtable_{};
+
+	public:
+		static constexpr std::size_t inline_size = InlineSize;
+
+		[[nodiscard]] basic_inline_listener() noexcept = default;
+
+		template <typename T, typename Fn>
+			requires (std::move_constructible<std::decay_t<Fn>> && std::invocable<std::decay_t<Fn>&, const T&>)
+		[[nodiscard]] basic_inline_listener(std::in_place_type_t<T>, Fn&& fn){
+			using fn_type = std::decay_t<Fn>;
+			if constexpr(stored_inline<fn_type>){
+				std::construct_at(reinterpret_cast<fn_type*>(storage_), std::forward<Fn>(fn));
+				invoke_ = +[](void* storage, const void* event){
+					std::invoke(*static_cast<fn_type*>(storage), *static_cast<const T*>(event));
+				};
+				vtable_ = &inline_vtable<fn_type>;
+			} else{
+				*reinterpret_cast<fn_type**>(storage_) = new fn_type(std::forward<Fn>(fn));
+				invoke_ = +[](void* storage, const void* event){
+					std::invoke(**static_cast<fn_type**>(storage), *static_cast<const T*>(event));
+				};
+				vtable_ = &heap_vtable<fn_type>;
+			}
+		}
+
+		basic_inline_listener(const basic_inline_listener&) = delete;
+		basic_inline_listener& operator=(const basic_inline_listener&) = delete;
+
+		basic_inline_listener(basic_inline_listener&& other) noexcept
+			: invoke_(std::exchange(other.invoke_, nullptr)), vtable_(std::exchange(other.vtable_, nullptr)){
+			if(vtable_) vtable_->relocate(storage_, other.storage_);
+		}
+
+		basic_inline_listener& operator=(basic_inline_listener&& other) noexcept{
+			if(this == &other) return *this;
+			this->reset();
+			invoke_ = std::exchange(other.invoke_, nullptr);
+			vtable_ = std::exchange(other.vtable_, nullptr);
+			if(vtable_) vtable_->relocate(storage_, other.storage_);
+			return *this;
+		}
+
+		~basic_inline_listener(){
+			this->reset();
+		}
+
+		void reset() noexcept{
+			if(vtable_){
+				invoke_ = nullptr;
+				std::exchange(vtable_, nullptr)->destroy(storage_);
+			}
+		}
+
+		explicit operator bool() const noexcept{
+			return invoke_ != nullptr;
+		}
+
+		/**
+		 * @warning 事件类型必须与构造时的 T 一致，由 static_event_manager 保证
+		 */
+		FORCE_INLINE void operator()(const void* event) const{
+			assert(invoke_ != nullptr);
+			invoke_(storage_, event);
+		}
+	};
+
+	export using inline_listener = basic_inline_listener<>;
+
+	export using listener_id = std::uint32_t;
+
+	/**
+	 * @brief 事件集合在编译期确定的事件管理器
+	 *
+	 * 每个事件类型在类型列表中的位置即其监听器组的下标，fire 不涉及哈希查找与 std::function，
+	 * 只是一次固定偏移的数组访问加上对连续存储监听器的循环调用。
+	 *
+	 * event_manager 同样按类型列表下标存放监听器组，但不能直接换用 inline_listener：
+	 * - 其元素类型由 select_wrapped_func 固定为 std::function / std::move_only_function，
+	 *   on 还会先把可调用对象包进转发 context 的 lambda，用户对象再小也难以放进包装器的内联缓冲
+	 * - group_at 公开了监听器容器本身，外部可直接增删元素，旁置的标识数组无法保持对齐，因而无法按标识 erase
+	 *
+	 * 本类型不带 context，监听器固定为 inline_listener，容器不对外公开。
+	 *
+	 * @warning 回调中不得对同一事件类型注册或注销监听器
+	 * @tparam EventTs 可派发的事件类型，互不相同
+	 */
+	export
+	template <event_argument... EventTs>
+	struct static_event_manager{
+	private:
+		struct group{
+			std::vector<inline_listener> listeners{};
+			// 与 listeners 一一对应，分开存放以保持派发循环的步长紧凑
+			std::vector<listener_id> ids{};
+		};
+
+		using mapping_type = type_map<group, std::tuple<EventTs...>>;
+
+		mapping_type events{};
+		listener_id last_id_{};
+
+	public:
+		static constexpr std::size_t event_count = sizeof...(EventTs);
+
+		template <typename T>
+		static constexpr bool is_event_valid = mapping_type::template is_type_valid<T>;
+
+		template <typename T>
+			requires (is_event_valid<T>)
+		static constexpr std::size_t index_of = mapping_type::template index_of<T>;
+
+		/**
+		 * @return 用于 erase 的监听器标识，在整个管理器内唯一
+		 */
+		template <event_argument T, typename Func>
+			requires (is_event_valid<T> && std::invocable<std::decay_t<Func>&, const T&>)
+		listener_id on(Func&& func){
+			group& tgt = events.template at<T>();
+
+			// 任一容器插入失败时回滚另一方，保持 listeners 与 ids 一一对应
+			const listener_id id = last_id_ + 1;
+			tgt.ids.push_back(id);
+			try{
+				tgt.listeners.emplace_back(std::in_place_type<T>, std::forward<Func>(func));
+			} catch(...){
+				tgt.ids.pop_back();
+				throw;
+			}
+
+			return last_id_ = id;
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		bool erase(const listener_id id){
+			group& tgt = events.template at<T>();
+
+			if(const auto itr = std::ranges::find(tgt.ids, id); itr != tgt.ids.end()){
+				const auto idx = itr - tgt.ids.begin();
+				tgt.ids.erase(itr);
+				tgt.listeners.erase(tgt.listeners.begin() + idx);
+				return true;
+			}
+
+			return false;
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		void fire(const T& event) const{
+			for(const inline_listener& listener : events.template at<T>().listeners){
+				listener(std::addressof(event));
+			}
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		void operator()(const T& event) const{
+			this->fire(event);
+		}
+
+		template <event_argument T, typename... Args>
+			requires (is_event_valid<T> && std::constructible_from<T, Args&&...>)
+		void emplace_fire(Args&&... args) const{
+			this->fire<T>(T(std::forward<Args>(args)...));
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		void reserve(const std::size_t count){
+			group& tgt = events.template at<T>();
+			tgt.listeners.reserve(count);
+			tgt.ids.reserve(count);
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		[[nodiscard]] std::size_t size() const noexcept{
+			return events.template at<T>().listeners.size();
+		}
+
+		template <event_argument T>
+			requires (is_event_valid<T>)
+		void clear() noexcept{
+			group& tgt = events.template at<T>();
+			tgt.listeners.clear();
+			tgt.ids.clear();
+		}
+
+		void clear() noexcept{
+			for(group& tgt : events.items){
+				tgt.listeners.clear();
+				tgt.ids.clear();
+			}
+		}
+	};
+}
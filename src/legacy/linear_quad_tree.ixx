@@ -0,0 +1,346 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.math.linear_quad_tree;
+
+export import mo_yanxi.math.quad_tree;
+import mo_yanxi.algo.radix_sort;
+import mo_yanxi.concurrent.thread_pool;
+import mo_yanxi.concepts;
+import mo_yanxi.math.vector2;
+import mo_yanxi.math.rect_ortho;
+import mo_yanxi.math;
+import std;
+
+namespace mo_yanxi::math{
+	/**
+	 * @brief 将低 16 位展开到偶数位
+	 */
+	[[nodiscard]] CONST_FN FORCE_INLINE constexpr std::uint32_t morton_spread(std::uint32_t v) noexcept{
+		v &= 0x0000FFFFu;
+		v = (v | (v << 8)) & 0x00FF00FFu;
+		v = (v | (v << 4)) & 0x0F0F0F0Fu;
+		v = (v | (v << 2)) & 0x33333333u;
+		v = (v | (v << 1)) & 0x55555555u;
+		return v;
+	}
+
+	export
+	[[nodiscard]] CONST_FN FORCE_INLINE constexpr std::uint32_t morton_encode(std::uint32_t x, std::uint32_t y) noexcept{
+		return math::morton_spread(x) | (math::morton_spread(y) << 1);
+	}
+
+	/**
+	 * @brief 以 Morton 序存放于连续数组中的线性四叉树，每帧整体重建
+	 *
+	 * - 每个元素按 quad_tree_evaluateable_traits::bound_of 放入能完整容纳其包围盒的最深格子，
+	 *   跨越中线的元素留在祖先格子中，与 quad_tree 的划分规则一致
+	 * - 节点按 (格子最小 Morton 码, 层级) 排序，恰为前序遍历顺序，任一子树在数组中连续，
+	 *   查询时不命中的子树通过 subtree_end 整段跳过
+	 * - 节点包围盒为子树内全部元素包围盒的并集，超出 boundary 的元素同样可被查到
+	 * - rebuild 为 O(n log n)（键排序为基数排序），查询只读，可在多个线程上同时进行
+	 *
+	 * @warning 元素指针在下一次 rebuild/clear 之前需保持有效
+	 */
+	export
+	template <typename ItemTy, arithmetic T = float>
+	struct linear_quad_tree{
+		using rect_type = rect_ortho<T>;
+		using vec_t = vector2<T>;
+		using trait = quad_tree_evaluateable_traits<ItemTy, T>;
+		using size_type = std::uint32_t;
+
+		static constexpr unsigned max_depth_limit = 15;
+		static constexpr unsigned default_depth = 10;
+
+	private:
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		struct entry{
+			// 格子最小 Morton 码 << 8 | 层级
+			std::uint64_t key;
+			ItemTy* item;
+			rect_type bound;
+		};
+
+		struct node{
+			rect_type bound;
+			size_type item_first;
+			size_type item_last;
+			size_type subtree_end;
+		};
+
+		rect_type boundary_;
+		unsigned depth_;
+
+		std::vector<node> nodes_{};
+		std::vector<ItemTy*> items_{};
+		std::vector<rect_type> item_bounds_{};
+
+		// 重建用的缓冲，保留容量供下一帧复用
+		std::vector<entry> entries_{};
+		std::vector<std::uint64_t> node_keys_{};
+		std::vector<size_type> parents_{};
+
+		[[nodiscard]] std::uint32_t cell_of_(double v, double src, double scale) const noexcept{
+			const double rel = (v - src) * scale;
+			const auto cells = static_cast<double>(1u << depth_);
+			if(!(rel > 0)) return 0;
+			if(rel >= cells) return (1u << depth_) - 1;
+			return static_cast<std::uint32_t>(rel);
+		}
+
+		[[nodiscard]] std::uint64_t key_of_(const rect_type& bound) const noexcept{
+			const auto cells = static_cast<double>(1u << depth_);
+			const double scale_x = cells / static_cast<double>(boundary_.width());
+			const double scale_y = cells / static_cast<double>(boundary_.height());
+			const auto src_x = static_cast<double>(boundary_.get_src_x());
+			const auto src_y = static_cast<double>(boundary_.get_src_y());
+
+			const std::uint32_t m0 = math::morton_encode(
+				this->cell_of_(static_cast<double>(bound.get_src_x()), src_x, scale_x),
+				this->cell_of_(static_cast<double>(bound.get_src_y()), src_y, scale_y));
+			const std::uint32_t m1 = math::morton_encode(
+				this->cell_of_(static_cast<double>(bound.get_end_x()), src_x, scale_x),
+				this->cell_of_(static_cast<double>(bound.get_end_y()), src_y, scale_y));
+
+			// 两角 Morton 码的公共前缀即为同时容纳两角的最深格子
+			const unsigned differing_levels = (static_cast<unsigned>(std::bit_width(m0 ^ m1)) + 1) / 2;
+			const unsigned level = depth_ - differing_levels;
+			const std::uint64_t code = differing_levels == 0 ? m0 : (m0 >> (differing_levels * 2)) << (differing_levels * 2);
+			return code << 8 | level;
+		}
+
+		[[nodiscard]] bool is_in_subtree_(std::uint64_t ancestor_key, std::uint64_t key) const noexcept{
+			const std::uint64_t first = ancestor_key >> 8;
+			const unsigned level = static_cast<unsigned>(ancestor_key & 0xFF);
+			const std::uint64_t extent = std::uint64_t{1} << ((depth_ - level) * 2);
+			return (key >> 8) - first < extent;
+		}
+
+		void build_from_entries_(){
+			const auto count = static_cast<size_type>(entries_.size());
+			algo::radix_sort(entries_, &entry::key);
+
+			items_.resize(count);
+			item_bounds_.resize(count);
+			nodes_.clear();
+			node_keys_.clear();
+
+			for(size_type i = 0; i < count;){
+				const std::uint64_t key = entries_[i].key;
+				node n{entries_[i].bound, i, i, npos};
+				for(; i < count && entries_[i].key == key; ++i){
+					items_[i] = entries_[i].item;
+					item_bounds_[i] = entries_[i].bound;
+					n.bound.expand_by(entries_[i].bound);
+				}
+				n.item_last = i;
+				nodes_.push_back(n);
+				node_keys_.push_back(key);
+			}
+
+			// 前序数组上以栈求每个节点的子树末尾与最近的祖先节点
+			const auto node_count = static_cast<size_type>(nodes_.size());
+			parents_.resize(node_count);
+			std::vector<size_type> stack{};
+			for(size_type k = 0; k < node_count; ++k){
+				while(!stack.empty() && !this->is_in_subtree_(node_keys_[stack.back()], node_keys_[k])){
+					nodes_[stack.back()].subtree_end = k;
+					stack.pop_back();
+				}
+				parents_[k] = stack.empty() ? npos : stack.back();
+				stack.push_back(k);
+			}
+			for(const size_type k : stack){
+				nodes_[k].subtree_end = node_count;
+			}
+
+			// 子节点总在父节点之后，逆序合并即得子树包围盒
+			for(size_type k = node_count; k-- > 0;){
+				if(parents_[k] != npos){
+					nodes_[parents_[k]].bound.expand_by(nodes_[k].bound);
+				}
+			}
+		}
+
+		template <typename NodePred, typename ItemPred, typename Fn>
+		bool traverse_(NodePred node_pred, ItemPred item_pred, Fn fn) const{
+			const auto node_count = static_cast<size_type>(nodes_.size());
+			for(size_type k = 0; k < node_count;){
+				const node& n = nodes_[k];
+				if(!node_pred(n.bound)){
+					k = n.subtree_end;
+					continue;
+				}
+
+				for(size_type i = n.item_first; i != n.item_last; ++i){
+					if(item_pred(i) && fn(*items_[i])) return true;
+				}
+				++k;
+			}
+			return false;
+		}
+
+		template <typename Fn>
+		bool query_(const rect_type region, Fn fn) const{
+			return this->traverse_(
+				[&](const rect_type& bound){ return bound.overlap_exclusive(region); },
+				[&](size_type i){ return item_bounds_[i].overlap_exclusive(region); },
+				fn);
+		}
+
+		template <typename Fn>
+		bool query_(const ItemTy& object, Fn fn) const{
+			const rect_type region = trait::bound_of(object);
+			return this->traverse_(
+				[&](const rect_type& bound){ return bound.overlap_exclusive(region); },
+				[&](size_type i){ return item_bounds_[i].overlap_exclusive(region) && trait::is_intersected_between(object, *items_[i]); },
+				fn);
+		}
+
+		template <typename Fn>
+		bool query_(const vec_t point, Fn fn) const requires (trait::has_point_intersect){
+			return this->traverse_(
+				[&](const rect_type& bound){ return bound.contains_loose(point); },
+				[&](size_type i){ return trait::is_intersected_with_point(point, *items_[i]); },
+				fn);
+		}
+
+	public:
+		[[nodiscard]] explicit linear_quad_tree(const rect_type boundary, const unsigned depth = default_depth)
+			: boundary_(boundary), depth_(std::min(depth, max_depth_limit)){
+			assert(boundary.width() > 0 && boundary.height() > 0);
+		}
+
+		[[nodiscard]] rect_type get_boundary() const noexcept{ return boundary_; }
+
+		[[nodiscard]] unsigned depth() const noexcept{ return depth_; }
+
+		[[nodiscard]] size_type size() const noexcept{ return static_cast<size_type>(items_.size()); }
+
+		[[nodiscard]] bool empty() const noexcept{ return items_.empty(); }
+
+		[[nodiscard]] size_type node_count() const noexcept{ return static_cast<size_type>(nodes_.size()); }
+
+		void clear() noexcept{
+			nodes_.clear();
+			items_.clear();
+			item_bounds_.clear();
+		}
+
+		/**
+		 * @brief 以给定元素整体重建
+		 */
+		void rebuild(std::span<ItemTy> items){
+			assert(items.size() < npos);
+			entries_.resize(items.size());
+			for(std::size_t i = 0; i < items.size(); ++i){
+				const rect_type bound = trait::bound_of(items[i]);
+				entries_[i] = {this->key_of_(bound), std::addressof(items[i]), bound};
+			}
+			this->build_from_entries_();
+		}
+
+		void rebuild(std::span<ItemTy* const> items){
+			assert(items.size() < npos);
+			entries_.resize(items.size());
+			for(std::size_t i = 0; i < items.size(); ++i){
+				const rect_type bound = trait::bound_of(*items[i]);
+				entries_[i] = {this->key_of_(bound), items[i], bound};
+			}
+			this->build_from_entries_();
+		}
+
+		/**
+		 * @brief 以给定元素整体重建，包围盒与 Morton 键在线程池上并行计算
+		 */
+		void rebuild(ccur::thread_pool& pool, std::span<ItemTy> items){
+			assert(items.size() < npos);
+			entries_.resize(items.size());
+			pool.parallel_for(0, items.size(), [&, this](std::size_t begin, std::size_t end){
+				for(auto i = begin; i != end; ++i){
+					const rect_type bound = trait::bound_of(items[i]);
+					entries_[i] = {this->key_of_(bound), std::addressof(items[i]), bound};
+				}
+			});
+			this->build_from_entries_();
+		}
+
+		template <std::regular_invocable<ItemTy&> Func>
+		void each(Func func) const{
+			for(ItemTy* item : items_){
+				std::invoke(func, *item);
+			}
+		}
+
+		[[nodiscard]] ItemTy* intersect_any(const ItemTy& object) const{
+			ItemTy* rst{};
+			this->query_(object, [&](ItemTy& item){
+				rst = std::addressof(item);
+				return true;
+			});
+			return rst;
+		}
+
+		[[nodiscard]] ItemTy* intersect_any(const rect_type region) const{
+			ItemTy* rst{};
+			this->query_(region, [&](ItemTy& item){
+				rst = std::addressof(item);
+				return true;
+			});
+			return rst;
+		}
+
+		[[nodiscard]] ItemTy* intersect_any(const vec_t point) const requires (trait::has_point_intersect){
+			ItemTy* rst{};
+			this->query_(point, [&](ItemTy& item){
+				rst = std::addressof(item);
+				return true;
+			});
+			return rst;
+		}
+
+		template <std::invocable<ItemTy&> Func>
+		void intersect_then(const ItemTy& object, Func func) const{
+			this->query_(object, [&](ItemTy& item){
+				std::invoke(func, item);
+				return false;
+			});
+		}
+
+		template <std::invocable<ItemTy&, rect_type> Func>
+		void intersect_then(const rect_type rect, Func func) const{
+			this->query_(rect, [&](ItemTy& item){
+				std::invoke(func, item, rect);
+				return false;
+			});
+		}
+
+		template <std::invocable<ItemTy&, vec_t> Func>
+		void intersect_then(const vec_t point, Func func) const requires (trait::has_point_intersect){
+			this->query_(point, [&](ItemTy& item){
+				std::invoke(func, item, point);
+				return false;
+			});
+		}
+
+		/**
+		 * @brief 批量查询：对 queries 中每个查询（元素、矩形或点）并行执行，每个命中调用 func(query, item)
+		 *
+		 * func 会被多个线程并发调用；查询期间不得 rebuild。
+		 */
+		template <std::ranges::random_access_range Rng, typename Func>
+			requires (std::ranges::sized_range<Rng> && std::invocable<Func&, std::ranges::range_reference_t<Rng>, ItemTy&>)
+		void intersect_then(ccur::thread_pool& pool, Rng&& queries, Func func, std::size_t grain = 0) const{
+			pool.parallel_for_each(queries, [&, this](auto&& query){
+				this->query_(query, [&](ItemTy& item){
+					std::invoke(func, query, item);
+					return false;
+				});
+			}, grain);
+		}
+	};
+}
@@ -65,6 +65,7 @@ namespace mo_yanxi::math{
 
 	// using T = float;
 
+	export
 	template <typename ItemTy, arithmetic T>
 	struct quad_tree_evaluateable_traits{
 		using vec_t = vector2<T>;
@@ -0,0 +1,188 @@
+module;
+
+#include <cassert>
+
+export module mo_yanxi.algo.parallel_timsort;
+
+export import mo_yanxi.algo.timsort;
+import mo_yanxi.concurrent.thread_pool;
+
+import std;
+
+namespace mo_yanxi::algo{
+/**
+ * @brief 低于此长度时并行版本直接退化为串行 timsort
+ */
+export inline constexpr std::size_t parallel_timsort_threshold = 1 << 15;
+
+/**
+ * @brief 稳定合并的划分点（merge path / co-rank）
+ *
+ * 返回合并结果前 diagonal 个元素中来自 a 的数量；相等元素 a 优先，因此划分后逐段合并仍然稳定。
+ */
+template <typename ItA, typename ItB, typename Diff, typename Compare, typename Projection>
+Diff co_rank(ItA a, Diff len_a, ItB b, Diff len_b, Diff diagonal, Compare& comp, Projection& proj){
+	Diff lo = std::max<Diff>(0, diagonal - len_b);
+	Diff hi = std::min(diagonal, len_a);
+	while(lo < hi){
+		const Diff i = lo + (hi - lo) / 2;
+		const Diff j = diagonal - i;
+		// a[i] 排在 b[j - 1] 之前时，a[i] 也应属于前 diagonal 个元素
+		if(j > 0 && !std::invoke(comp, std::invoke(proj, b[j - 1]), std::invoke(proj, a[i]))){
+			lo = i + 1;
+		} else{
+			hi = i;
+		}
+	}
+	return lo;
+}
+
+template <typename ItA, typename ItB, typename Out, typename Compare, typename Projection>
+void move_merge(ItA a, ItA a_last, ItB b, ItB b_last, Out out, Compare& comp, Projection& proj){
+	while(a != a_last && b != b_last){
+		if(std::invoke(comp, std::invoke(proj, *b), std::invoke(proj, *a))){
+			*out = std::ranges::iter_move(b);
+			++b;
+		} else{
+			*out = std::ranges::iter_move(a);
+			++a;
+		}
+		++out;
+	}
+	out = std::ranges::move(a, a_last, out).out;
+	std::ranges::move(b, b_last, out);
+}
+
+/**
+ * @brief 将 src 中以 bounds 划分的有序块两两合并到 dst，合并按 merge path 切分为近似等长的任务
+ */
+template <typename Src, typename Dst, typename Diff, typename Compare, typename Projection>
+void merge_round(ccur::thread_pool& pool, Src src, Dst dst, const std::vector<Diff>& bounds,
+	Diff segment, Compare& comp, Projection& proj){
+	struct task{
+		Diff lo, mid, hi;
+		Diff diagonal_begin, diagonal_end;
+	};
+
+	std::vector<task> tasks;
+	for(std::size_t p = 0; p + 1 < bounds.size(); p += 2){
+		const Diff lo = bounds[p];
+		const Diff mid = bounds[p + 1];
+		const Diff hi = p + 2 < bounds.size() ? bounds[p + 2] : mid;
+		for(Diff d = 0; d < hi - lo; d += segment){
+			tasks.push_back({lo, mid, hi, d, std::min(d + segment, hi - lo)});
+		}
+	}
+
+	pool.parallel_for(0, tasks.size(), [&](std::size_t index){
+		const task& t = tasks[index];
+		const Diff len_a = t.mid - t.lo;
+		const Diff len_b = t.hi - t.mid;
+		const auto a = src + t.lo;
+		const auto b = src + t.mid;
+
+		const Diff ia = algo::co_rank(a, len_a, b, len_b, t.diagonal_begin, comp, proj);
+		const Diff ib = algo::co_rank(a, len_a, b, len_b, t.diagonal_end, comp, proj);
+		algo::move_merge(
+			a + ia, a + ib,
+			b + (t.diagonal_begin - ia), b + (t.diagonal_end - ib),
+			dst + (t.lo + t.diagonal_begin), comp, proj);
+	}, 1);
+}
+
+export
+/**
+ * Stably sorts a range on a thread pool with a comparison function and a projection function.
+ *
+ * 按工作线程数切块并行 timsort，随后逐轮两两合并，每轮按 merge path 切分为等长任务并行执行。
+ * 长度低于 parallel_timsort_threshold 或线程池只有一个线程时退化为串行 timsort。
+ * comp 与 proj 会被多个线程并发调用。
+ */
+template <
+	std::random_access_iterator Iterator,
+	std::sentinel_for<Iterator> Sentinel,
+	typename Compare = std::ranges::less,
+	typename Projection = std::identity>
+	requires std::sortable<Iterator, Compare, Projection>
+auto timsort(ccur::thread_pool& pool, Iterator first, Sentinel last,
+             Compare comp = {}, Projection proj = {})
+	-> Iterator{
+	using value_t = std::iter_value_t<Iterator>;
+	using diff_t = std::iter_difference_t<Iterator>;
+
+	auto last_it = std::ranges::next(first, last);
+	const diff_t count = last_it - first;
+	const auto workers = static_cast<diff_t>(pool.size());
+
+	if(static_cast<std::size_t>(count) < parallel_timsort_threshold || workers < 2){
+		return algo::timsort(first, last_it, std::move(comp), std::move(proj));
+	}
+
+	// 每块至少保留阈值的一部分，避免过细切分
+	const diff_t chunk_count = std::min(workers, std::max<diff_t>(1, count / static_cast<diff_t>(parallel_timsort_threshold / 4)));
+	std::vector<diff_t> bounds(static_cast<std::size_t>(chunk_count) + 1);
+	for(diff_t i = 0; i <= chunk_count; ++i){
+		bounds[static_cast<std::size_t>(i)] = count * i / chunk_count;
+	}
+
+	pool.parallel_for(0, static_cast<std::size_t>(chunk_count), [&](std::size_t i){
+		algo::timsort(first + bounds[i], first + bounds[i + 1], comp, proj);
+	}, 1);
+
+	if(chunk_count == 1) return last_it;
+
+	// 数据在原区间与缓冲区之间交替合并；无法默认构造的类型先整体移入缓冲区
+	std::vector<value_t> buffer;
+	bool in_scratch;
+	if constexpr(std::default_initializable<value_t>){
+		buffer.resize(static_cast<std::size_t>(count));
+		in_scratch = false;
+	} else{
+		buffer.reserve(static_cast<std::size_t>(count));
+		buffer.assign(std::make_move_iterator(first), std::make_move_iterator(last_it));
+		in_scratch = true;
+	}
+
+	const diff_t segment = std::max<diff_t>(4096, count / (workers * 4));
+	const auto scratch = buffer.begin();
+
+	while(bounds.size() > 2){
+		if(in_scratch){
+			algo::merge_round(pool, scratch, first, bounds, segment, comp, proj);
+		} else{
+			algo::merge_round(pool, first, scratch, bounds, segment, comp, proj);
+		}
+		in_scratch = !in_scratch;
+
+		std::vector<diff_t> next;
+		next.reserve(bounds.size() / 2 + 1);
+		for(std::size_t i = 0; i < bounds.size(); i += 2){
+			next.push_back(bounds[i]);
+		}
+		if(next.back() != count) next.push_back(count);
+		bounds = std::move(next);
+	}
+
+	if(in_scratch){
+		pool.parallel_for(0, static_cast<std::size_t>(count), [&](std::size_t begin, std::size_t end){
+			std::ranges::move(scratch + static_cast<diff_t>(begin), scratch + static_cast<diff_t>(end), first + static_cast<diff_t>(begin));
+		}, static_cast<std::size_t>(segment));
+	}
+
+	return last_it;
+}
+
+export
+/**
+ * Stably sorts a range on a thread pool with a comparison function and a projection function.
+ */
+template <
+	std::ranges::random_access_range Range,
+	typename Compare = std::ranges::less,
+	typename Projection = std::identity>
+	requires std::sortable<std::ranges::iterator_t<Range>, Compare, Projection>
+auto timsort(ccur::thread_pool& pool, Range&& range, Compare comp = {}, Projection proj = {})
+	-> std::ranges::borrowed_iterator_t<Range>{
+	return algo::timsort(pool, std::begin(range), std::end(range), comp, proj);
+}
+}
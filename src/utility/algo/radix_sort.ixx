@@ -0,0 +1,238 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.algo.radix_sort;
+
+import mo_yanxi.algo.timsort;
+import mo_yanxi.byte_pool;
+import std;
+
+namespace mo_yanxi::algo{
+/**
+ * @brief 将键映射为保序的无符号整数，radix_sort 按其字节从低到高分配
+ *
+ * 可为自定义键类型特化，需提供 bits_type 与 static bits_type to_bits(T)。
+ */
+export
+template <typename T>
+struct radix_key_traits{};
+
+export
+template <std::unsigned_integral T>
+struct radix_key_traits<T>{
+	using bits_type = T;
+
+	[[nodiscard]] static constexpr bits_type to_bits(T value) noexcept{
+		return value;
+	}
+};
+
+export
+template <std::signed_integral T>
+struct radix_key_traits<T>{
+	using bits_type = std::make_unsigned_t<T>;
+
+	[[nodiscard]] static constexpr bits_type to_bits(T value) noexcept{
+		// 翻转符号位，使负数排在非负数之前
+		return static_cast<bits_type>(static_cast<bits_type>(value) ^ (bits_type{1} << (std::numeric_limits<bits_type>::digits - 1)));
+	}
+};
+
+export
+template <std::floating_point T>
+	requires (std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8))
+struct radix_key_traits<T>{
+	using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+	[[nodiscard]] static constexpr bits_type to_bits(T value) noexcept{
+		// 负数按位取反，非负数翻转符号位；-0.0 排在 +0.0 之前，NaN 按符号位排在两端
+		const auto bits = std::bit_cast<bits_type>(value);
+		const bits_type sign = bits >> (std::numeric_limits<bits_type>::digits - 1);
+		return bits ^ (-sign | (bits_type{1} << (std::numeric_limits<bits_type>::digits - 1)));
+	}
+};
+
+export
+template <typename T>
+	requires std::is_enum_v<T>
+struct radix_key_traits<T>{
+	using bits_type = typename radix_key_traits<std::underlying_type_t<T>>::bits_type;
+
+	[[nodiscard]] static constexpr bits_type to_bits(T value) noexcept{
+		return radix_key_traits<std::underlying_type_t<T>>::to_bits(std::to_underlying(value));
+	}
+};
+
+export
+template <typename T>
+concept radix_key = requires(const T& value){
+	requires std::unsigned_integral<typename radix_key_traits<T>::bits_type>;
+	{ radix_key_traits<T>::to_bits(value) } -> std::same_as<typename radix_key_traits<T>::bits_type>;
+};
+
+export
+template <typename Iterator, typename Projection>
+concept radix_sortable =
+	std::random_access_iterator<Iterator> &&
+	std::permutable<Iterator> &&
+	std::indirectly_unary_invocable<Projection, Iterator> &&
+	radix_key<std::remove_cvref_t<std::indirect_result_t<Projection&, Iterator>>>;
+
+/**
+ * @brief 低于此长度时直接按变换后的键做 timsort
+ */
+export inline constexpr std::size_t radix_sort_threshold = 256;
+
+template <typename Iterator, typename Projection>
+struct radix_key_of{
+	using key_type = std::remove_cvref_t<std::indirect_result_t<Projection&, Iterator>>;
+	using traits = radix_key_traits<key_type>;
+	using bits_type = typename traits::bits_type;
+
+	Projection* proj;
+
+	template <typename T>
+	[[nodiscard]] FORCE_INLINE bits_type operator()(T&& value) const{
+		return traits::to_bits(std::invoke(*proj, std::forward<T>(value)));
+	}
+};
+
+template <typename Src, typename Dst, typename KeyOf>
+void radix_scatter(Src src, Dst dst, std::size_t count, unsigned shift,
+	std::array<std::size_t, 256>& offsets, const KeyOf& key_of){
+	for(std::size_t i = 0; i < count; ++i){
+		const auto digit = static_cast<std::size_t>((key_of(src[i]) >> shift) & 0xFF);
+		dst[offsets[digit]++] = std::ranges::iter_move(src + i);
+	}
+}
+
+/**
+ * @brief 以 scratch 为辅助空间的 LSD 基数排序，每轮按一个字节稳定分配
+ *
+ * 所有字节的直方图在一次遍历中统计；某一字节在全部元素上相同时跳过该轮。
+ */
+template <typename Iterator, typename Scratch, typename Projection>
+void radix_sort_impl(Iterator first, std::size_t count, Scratch scratch, Projection& proj){
+	using key_of_t = radix_key_of<Iterator, Projection>;
+	using bits_type = typename key_of_t::bits_type;
+	constexpr unsigned passes = sizeof(bits_type);
+
+	const key_of_t key_of{&proj};
+
+	std::array<std::array<std::size_t, 256>, passes> histograms{};
+	for(std::size_t i = 0; i < count; ++i){
+		const bits_type bits = key_of(first[i]);
+		for(unsigned p = 0; p < passes; ++p){
+			++histograms[p][static_cast<std::size_t>((bits >> (p * 8)) & 0xFF)];
+		}
+	}
+
+	bool in_scratch = false;
+	for(unsigned p = 0; p < passes; ++p){
+		auto& offsets = histograms[p];
+		if(std::ranges::find(offsets, count) != offsets.end()) continue;
+
+		std::size_t sum = 0;
+		for(auto& c : offsets){
+			sum += std::exchange(c, sum);
+		}
+
+		if(in_scratch){
+			algo::radix_scatter(scratch, first, count, p * 8, offsets, key_of);
+		} else{
+			algo::radix_scatter(first, scratch, count, p * 8, offsets, key_of);
+		}
+		in_scratch = !in_scratch;
+	}
+
+	if(in_scratch){
+		std::ranges::move(scratch, scratch + static_cast<std::ptrdiff_t>(count), first);
+	}
+}
+
+template <typename Iterator, typename Projection>
+bool radix_sort_small(Iterator first, Iterator last, Projection& proj){
+	if(static_cast<std::size_t>(last - first) >= radix_sort_threshold) return false;
+	algo::timsort(first, last, std::ranges::less{}, radix_key_of<Iterator, Projection>{&proj});
+	return true;
+}
+
+export
+/**
+ * @brief 按投影得到的整数 / 浮点 / 枚举键稳定排序（升序），辅助空间由 allocator 提供
+ *
+ * 与 timsort 使用相同的投影约定；键类型可通过特化 radix_key_traits 扩展。
+ */
+template <
+	std::random_access_iterator Iterator,
+	std::sentinel_for<Iterator> Sentinel,
+	typename Projection = std::identity,
+	typename Allocator = std::allocator<std::iter_value_t<Iterator>>>
+	requires radix_sortable<Iterator, Projection> && std::default_initializable<std::iter_value_t<Iterator>> &&
+		requires(Allocator& allocator){ allocator.allocate(std::size_t{1}); }
+auto radix_sort(Iterator first, Sentinel last, Projection proj = {}, const Allocator& allocator = {})
+	-> Iterator{
+	using value_t = std::iter_value_t<Iterator>;
+	using alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<value_t>;
+
+	auto last_it = std::ranges::next(first, last);
+	if(algo::radix_sort_small(first, last_it, proj)) return last_it;
+
+	const auto count = static_cast<std::size_t>(last_it - first);
+	std::vector<value_t, alloc_t> scratch(count, alloc_t(allocator));
+	algo::radix_sort_impl(first, count, scratch.begin(), proj);
+	return last_it;
+}
+
+export
+/**
+ * @brief 同上，辅助空间从 byte_pool 借用
+ */
+template <
+	std::random_access_iterator Iterator,
+	std::sentinel_for<Iterator> Sentinel,
+	typename Projection,
+	typename PoolAlloc>
+	requires radix_sortable<Iterator, Projection> && std::is_trivially_copyable_v<std::iter_value_t<Iterator>>
+auto radix_sort(Iterator first, Sentinel last, Projection proj, byte_pool<PoolAlloc>& pool)
+	-> Iterator{
+	using value_t = std::iter_value_t<Iterator>;
+
+	auto last_it = std::ranges::next(first, last);
+	if(algo::radix_sort_small(first, last_it, proj)) return last_it;
+
+	const auto count = static_cast<std::size_t>(last_it - first);
+	if(count > std::numeric_limits<unsigned>::max() / sizeof(value_t)){
+		return algo::radix_sort(first, last_it, std::move(proj));
+	}
+
+	auto scratch = pool.template borrow<value_t>(static_cast<unsigned>(count));
+	algo::radix_sort_impl(first, count, scratch.data(), proj);
+	return last_it;
+}
+
+export
+template <
+	std::ranges::random_access_range Range,
+	typename Projection = std::identity,
+	typename Allocator = std::allocator<std::ranges::range_value_t<Range>>>
+	requires radix_sortable<std::ranges::iterator_t<Range>, Projection> && std::default_initializable<std::ranges::range_value_t<Range>> &&
+		requires(Allocator& allocator){ allocator.allocate(std::size_t{1}); }
+auto radix_sort(Range&& range, Projection proj = {}, const Allocator& allocator = {})
+	-> std::ranges::borrowed_iterator_t<Range>{
+	return algo::radix_sort(std::ranges::begin(range), std::ranges::end(range), std::move(proj), allocator);
+}
+
+export
+template <
+	std::ranges::random_access_range Range,
+	typename Projection,
+	typename PoolAlloc>
+	requires radix_sortable<std::ranges::iterator_t<Range>, Projection> && std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>
+auto radix_sort(Range&& range, Projection proj, byte_pool<PoolAlloc>& pool)
+	-> std::ranges::borrowed_iterator_t<Range>{
+	return algo::radix_sort(std::ranges::begin(range), std::ranges::end(range), std::move(proj), pool);
+}
+}
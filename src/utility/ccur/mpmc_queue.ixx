@@ -0,0 +1,388 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.concurrent.mpmc_queue;
+
+import std;
+
+namespace mo_yanxi::ccur{
+/**
+ * @brief 定容无锁多生产者多消费者环形队列
+ *
+ * 每个槽位携带序号（Vyukov 有界队列）：
+ * - 序号 == 位置：槽位空闲，可由认领该位置的生产者写入
+ * - 序号 == 位置 + 1：槽位已写入，可由认领该位置的消费者读取
+ * - 读取完成后序号推进为 位置 + 容量，交给下一圈的生产者
+ *
+ * 生产者与消费者只在 CAS 认领位置时竞争，不存在全局锁，也不会分配内存。
+ * 阻塞接口基于 std::atomic::wait，仅在确有等待者时才发出通知。
+ *
+ * @tparam T 元素类型，出队需要可移动构造
+ */
+export
+template <typename T, typename Allocator = std::allocator<T>>
+class mpmc_queue{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using allocator_type = Allocator;
+
+private:
+	struct slot{
+		std::atomic<size_type> sequence;
+		alignas(value_type) std::byte storage[sizeof(value_type)];
+
+		FORCE_INLINE value_type* data() noexcept{
+			return std::launder(reinterpret_cast<value_type*>(storage));
+		}
+	};
+
+	using slot_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<slot>;
+	using slot_traits = std::allocator_traits<slot_allocator>;
+
+	// 通知计数器，32 位以便 atomic::wait 直接落到 futex 上
+	using epoch_type = std::uint32_t;
+
+	struct alignas(std::hardware_destructive_interference_size) position{
+		std::atomic<size_type> value{};
+	};
+
+	struct alignas(std::hardware_destructive_interference_size) waiter_state{
+		std::atomic<epoch_type> epoch{};
+		std::atomic<epoch_type> waiters{};
+	};
+
+	ADAPTED_NO_UNIQUE_ADDRESS slot_allocator allocator_{};
+	slot* slots_{};
+	size_type mask_{};
+
+	position enqueue_pos_{};
+	position dequeue_pos_{};
+
+	waiter_state not_empty_{};
+	waiter_state not_full_{};
+
+public:
+	/**
+	 * @param capacity 容量，向上取整为 2 的幂，至少为 2
+	 */
+	[[nodiscard]] explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type{})
+		: allocator_(alloc){
+		capacity = std::bit_ceil(std::max<size_type>(capacity, 2));
+		slots_ = slot_traits::allocate(allocator_, capacity);
+		mask_ = capacity - 1;
+		for(size_type i = 0; i < capacity; ++i){
+			std::construct_at(slots_ + i)->sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	mpmc_queue(const mpmc_queue&) = delete;
+	mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+	~mpmc_queue(){
+		this->clear();
+		std::destroy_n(slots_, mask_ + 1);
+		slot_traits::deallocate(allocator_, slots_, mask_ + 1);
+	}
+
+	[[nodiscard]] size_type capacity() const noexcept{
+		return mask_ + 1;
+	}
+
+	/**
+	 * @brief 近似元素数量，并发修改时仅供参考
+	 */
+	[[nodiscard]] size_type size() const noexcept{
+		const auto head = dequeue_pos_.value.load(std::memory_order_relaxed);
+		const auto tail = enqueue_pos_.value.load(std::memory_order_relaxed);
+		return tail > head ? std::min(tail - head, this->capacity()) : 0;
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return this->size() == 0;
+	}
+
+	// --- Producer ---
+
+	template <typename... Args>
+		requires std::constructible_from<value_type, Args&&...>
+	[[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>){
+		size_type pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+		slot* s;
+		while(true){
+			s = slots_ + (pos & mask_);
+			const size_type seq = s->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::make_signed_t<size_type>>(seq - pos);
+			if(diff == 0){
+				if(enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			} else if(diff < 0){
+				return false;
+			} else{
+				pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		this->publish_(s, pos, std::forward<Args>(args)...);
+		this->notify_(not_empty_, false);
+		return true;
+	}
+
+	[[nodiscard]] bool try_push(value_type&& value) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		return this->try_emplace(std::move(value));
+	}
+
+	[[nodiscard]] bool try_push(const value_type& value) noexcept(std::is_nothrow_copy_constructible_v<value_type>){
+		return this->try_emplace(value);
+	}
+
+	/**
+	 * @brief 一次认领一段连续位置并批量写入
+	 *
+	 * @return 实际写入的元素数量，可能少于请求数量
+	 */
+	template <std::input_iterator It>
+		requires std::constructible_from<value_type, std::iter_reference_t<It>>
+	size_type try_push_n(It first, size_type count) noexcept(std::is_nothrow_constructible_v<value_type, std::iter_reference_t<It>>){
+		if(count == 0) return 0;
+
+		size_type pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+		size_type claimed;
+		while(true){
+			claimed = this->count_ready_(pos, count, 0);
+			if(claimed == 0){
+				// 首个槽位尚未被上一圈读走，队列已满；或位置已被他人推进
+				const auto seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+				if(static_cast<std::make_signed_t<size_type>>(seq - pos) < 0) return 0;
+				pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+				continue;
+			}
+			// 槽位对生产者的就绪状态只会被认领该位置的生产者改变，CAS 成功即独占整段
+			if(enqueue_pos_.value.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)){
+				break;
+			}
+		}
+
+		for(size_type i = 0; i < claimed; ++i, ++first){
+			this->publish_(slots_ + ((pos + i) & mask_), pos + i, *first);
+		}
+		this->notify_(not_empty_, claimed > 1);
+		return claimed;
+	}
+
+	template <std::ranges::input_range Rng>
+		requires std::constructible_from<value_type, std::ranges::range_reference_t<Rng>>
+	size_type try_push_n(Rng&& range){
+		if constexpr(std::ranges::sized_range<Rng>){
+			return this->try_push_n(std::ranges::begin(range), static_cast<size_type>(std::ranges::size(range)));
+		} else{
+			size_type count = 0;
+			for(auto&& value : range){
+				if(!this->try_emplace(std::forward<decltype(value)>(value))) break;
+				++count;
+			}
+			return count;
+		}
+	}
+
+	template <typename... Args>
+		requires std::constructible_from<value_type, Args&&...>
+	void emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>){
+		// try_emplace 仅在认领成功后才转发参数，失败重试不会消耗参数
+		this->wait_until_(not_full_, [&]{ return this->try_emplace(std::forward<Args>(args)...); });
+	}
+
+	void push(value_type&& value) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		this->wait_until_(not_full_, [&]{ return this->try_emplace(std::move(value)); });
+	}
+
+	void push(const value_type& value) noexcept(std::is_nothrow_copy_constructible_v<value_type>){
+		this->wait_until_(not_full_, [&]{ return this->try_emplace(value); });
+	}
+
+	// --- Consumer ---
+
+	[[nodiscard]] std::optional<value_type> try_consume() noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		std::optional<value_type> rst{};
+		this->try_pop_impl_([&](value_type&& value){ rst.emplace(std::move(value)); });
+		return rst;
+	}
+
+	/**
+	 * @brief 批量出队，写入输出迭代器
+	 *
+	 * @return 实际取出的元素数量
+	 */
+	template <std::weakly_incrementable OutIt>
+		requires std::indirectly_writable<OutIt, value_type&&>
+	size_type try_pop_n(OutIt out, size_type max_count) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		if(max_count == 0) return 0;
+
+		size_type pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+		size_type claimed;
+		while(true){
+			claimed = this->count_ready_(pos, max_count, 1);
+			if(claimed == 0){
+				const auto seq = slots_[pos & mask_].sequence.load(std::memory_order_acquire);
+				if(static_cast<std::make_signed_t<size_type>>(seq - (pos + 1)) < 0) return 0;
+				pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+				continue;
+			}
+			if(dequeue_pos_.value.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)){
+				break;
+			}
+		}
+
+		for(size_type i = 0; i < claimed; ++i){
+			this->retire_(slots_ + ((pos + i) & mask_), pos + i, [&](value_type&& value){
+				*out = std::move(value);
+				++out;
+			});
+		}
+		this->notify_(not_full_, claimed > 1);
+		return claimed;
+	}
+
+	/**
+	 * @brief 阻塞直到取得元素
+	 */
+	value_type consume() noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		std::optional<value_type> rst{};
+		this->wait_until_(not_empty_, [&]{
+			return this->try_pop_impl_([&](value_type&& value){ rst.emplace(std::move(value)); });
+		});
+		return std::move(*rst);
+	}
+
+	/**
+	 * @brief 阻塞直到取得元素或 exit_pred 成立
+	 *
+	 * exit_pred 只在被唤醒后重新检查，改变退出条件后需调用 notify()。
+	 */
+	template <std::predicate<> ExitPred>
+	[[nodiscard]] std::optional<value_type> consume(ExitPred exit_pred) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		std::optional<value_type> rst{};
+		this->wait_until_(not_empty_, [&]{
+			return this->try_pop_impl_([&](value_type&& value){ rst.emplace(std::move(value)); }) || exit_pred();
+		});
+		return rst;
+	}
+
+	template <std::predicate<> ExitPred>
+	[[nodiscard]] bool pop_front(ExitPred exit_pred) noexcept{
+		bool popped = false;
+		this->wait_until_(not_empty_, [&]{
+			popped = this->try_pop_impl_([](value_type&&) noexcept{});
+			return popped || exit_pred();
+		});
+		return popped;
+	}
+
+	/**
+	 * @brief 唤醒所有阻塞的消费者，使其重新检查退出条件
+	 */
+	void notify() noexcept{
+		not_empty_.epoch.fetch_add(1, std::memory_order_release);
+		not_empty_.epoch.notify_all();
+	}
+
+	/**
+	 * @brief 丢弃所有当前可见的元素
+	 */
+	void clear() noexcept{
+		while(this->try_pop_impl_([](value_type&&) noexcept{})){}
+	}
+
+private:
+	template <typename... Args>
+	FORCE_INLINE void publish_(slot* s, size_type pos, Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>){
+		if constexpr(std::is_nothrow_constructible_v<value_type, Args&&...>){
+			std::construct_at(reinterpret_cast<value_type*>(s->storage), std::forward<Args>(args)...);
+		} else{
+			try{
+				std::construct_at(reinterpret_cast<value_type*>(s->storage), std::forward<Args>(args)...);
+			} catch(...){
+				// 位置已被认领，无法回退；构造失败时终止是唯一不破坏队列序号的选择
+				std::terminate();
+			}
+		}
+		s->sequence.store(pos + 1, std::memory_order_release);
+	}
+
+	template <typename Fn>
+	FORCE_INLINE void retire_(slot* s, size_type pos, Fn&& fn) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		value_type* value = s->data();
+		std::invoke(fn, std::move(*value));
+		std::destroy_at(value);
+		s->sequence.store(pos + this->capacity(), std::memory_order_release);
+	}
+
+	template <typename Fn>
+	bool try_pop_impl_(Fn&& fn) noexcept(std::is_nothrow_move_constructible_v<value_type>){
+		size_type pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+		slot* s;
+		while(true){
+			s = slots_ + (pos & mask_);
+			const size_type seq = s->sequence.load(std::memory_order_acquire);
+			const auto diff = static_cast<std::make_signed_t<size_type>>(seq - (pos + 1));
+			if(diff == 0){
+				if(dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			} else if(diff < 0){
+				return false;
+			} else{
+				pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		this->retire_(s, pos, std::forward<Fn>(fn));
+		this->notify_(not_full_, false);
+		return true;
+	}
+
+	/**
+	 * @brief 统计自 pos 起连续就绪的槽位数
+	 * @param offset 生产者为 0（等待空闲），消费者为 1（等待写入）
+	 */
+	FORCE_INLINE size_type count_ready_(size_type pos, size_type limit, size_type offset) const noexcept{
+		limit = std::min(limit, this->capacity());
+		size_type count = 0;
+		for(; count < limit; ++count){
+			const auto p = pos + count;
+			if(slots_[p & mask_].sequence.load(std::memory_order_acquire) != p + offset) break;
+		}
+		return count;
+	}
+
+	FORCE_INLINE static void notify_(waiter_state& state, bool all) noexcept{
+		// 与 wait_until_ 中的栅栏配对：要么等待者看到新状态，要么此处看到等待者
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(state.waiters.load(std::memory_order_relaxed) == 0) [[likely]] return;
+
+		state.epoch.fetch_add(1, std::memory_order_release);
+		if(all){
+			state.epoch.notify_all();
+		} else{
+			state.epoch.notify_one();
+		}
+	}
+
+	template <std::predicate<> Fn>
+	static void wait_until_(waiter_state& state, Fn&& try_once) noexcept(std::is_nothrow_invocable_v<Fn&>){
+		if(try_once()) return;
+
+		state.waiters.fetch_add(1, std::memory_order_relaxed);
+		while(true){
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto epoch = state.epoch.load(std::memory_order_acquire);
+			if(try_once()) break;
+			state.epoch.wait(epoch, std::memory_order_acquire);
+		}
+		state.waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+};
+}
@@ -75,6 +75,21 @@ public:
 		m_cond.notify_one();
 	}
 
+	/**
+	 * @brief 在队列锁内执行 fn 后唤醒消费者
+	 *
+	 * 用于修改 consume(exit_pred) 的退出条件：若在锁外修改再 notify，
+	 * 消费者可能在检查条件之后、进入等待之前错过这次唤醒。
+	 */
+	template <std::invocable<> Fn>
+	void notify_after(Fn fn) noexcept(std::is_nothrow_invocable_v<Fn&>){
+		{
+			std::lock_guard lock(m_mutex);
+			std::invoke(fn);
+		}
+		m_cond.notify_one();
+	}
+
 	template <std::predicate<> ExitPred>
 	[[nodiscard]] std::optional<value_type> consume(ExitPred exit_pred) noexcept(std::is_nothrow_move_constructible_v<value_type>){
 		std::unique_lock lock(m_mutex);
@@ -0,0 +1,131 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.concurrent.small_task;
+
+import std;
+
+namespace mo_yanxi::ccur{
+/**
+ * @brief 仅可移动的 void() 类型擦除任务，小对象内联存储
+ *
+ * 与 std::packaged_task 不同，不分配共享状态；可调用对象不超过 InlineSize 且移动不抛异常时不分配任何内存。
+ * 需要返回值时由调用方自行携带 promise。
+ *
+ * @tparam InlineSize 内联缓冲大小，默认使整个对象占据一条缓存行
+ */
+export
+template <std::size_t InlineSize = 64 - sizeof(void*)>
+class basic_small_task{
+	struct vtable{
+		void (*invoke)(void* storage);
+		// 移动构造到 dst 并析构 src
+		void (*relocate)(void* dst, void* src) noexcept;
+		void (*destroy)(void* storage) noexcept;
+	};
+
+	template <typename Fn>
+	static constexpr bool stored_inline =
+		sizeof(Fn) <= InlineSize &&
+		alignof(Fn) <= alignof(std::max_align_t) &&
+		std::is_nothrow_move_constructible_v<Fn>;
+
+	template <typename Fn>
+	static constexpr vtable inline_vtable{
+		.invoke = +[](void* storage){
+			std::invoke(*static_cast<Fn*>(storage));
+		},
+		.relocate = +[](void* dst, void* src) noexcept{
+			Fn* from = static_cast<Fn*>(src);
+			std::construct_at(static_cast<Fn*>(dst), std::move(*from));
+			std::destroy_at(from);
+		},
+		.destroy = +[](void* storage) noexcept{
+			std::destroy_at(static_cast<Fn*>(storage));
+		}
+	};
+
+	template <typename Fn>
+	static constexpr vtable heap_vtable{
+		.invoke = +[](void* storage){
+			std::invoke(**static_cast<Fn**>(storage));
+		},
+		.relocate = +[](void* dst, void* src) noexcept{
+			*static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+		},
+		.destroy = +[](void* storage) noexcept{
+			delete *static_cast<Fn**>(storage);
+		}
+	};
+
+	alignas(std::max_align_t) std::byte storage_[InlineSize];
+	const vtable* vtable_{};
+
+public:
+	static constexpr std::size_t inline_size = InlineSize;
+
+	[[nodiscard]] basic_small_task() noexcept = default;
+
+	[[nodiscard]] explicit(false) basic_small_task(std::nullptr_t) noexcept{
+	}
+
+	template <typename Fn>
+		requires (!std::same_as<std::remove_cvref_t<Fn>, basic_small_task> &&
+			std::move_constructible<std::decay_t<Fn>> && std::invocable<std::decay_t<Fn>&>)
+	[[nodiscard]] explicit(false) basic_small_task(Fn&& fn){
+		using fn_type = std::decay_t<Fn>;
+		if constexpr(stored_inline<fn_type>){
+			std::construct_at(reinterpret_cast<fn_type*>(storage_), std::forward<Fn>(fn));
+			vtable_ = &inline_vtable<fn_type>;
+		} else{
+			*reinterpret_cast<fn_type**>(storage_) = new fn_type(std::forward<Fn>(fn));
+			vtable_ = &heap_vtable<fn_type>;
+		}
+	}
+
+	basic_small_task(const basic_small_task&) = delete;
+	basic_small_task& operator=(const basic_small_task&) = delete;
+
+	basic_small_task(basic_small_task&& other) noexcept
+		: vtable_(std::exchange(other.vtable_, nullptr)){
+		if(vtable_) vtable_->relocate(storage_, other.storage_);
+	}
+
+	basic_small_task& operator=(basic_small_task&& other) noexcept{
+		if(this == &other) return *this;
+		this->reset();
+		vtable_ = std::exchange(other.vtable_, nullptr);
+		if(vtable_) vtable_->relocate(storage_, other.storage_);
+		return *this;
+	}
+
+	~basic_small_task(){
+		this->reset();
+	}
+
+	void reset() noexcept{
+		if(vtable_){
+			std::exchange(vtable_, nullptr)->destroy(storage_);
+		}
+	}
+
+	explicit operator bool() const noexcept{
+		return vtable_ != nullptr;
+	}
+
+	void operator()(){
+		assert(vtable_ != nullptr);
+		vtable_->invoke(storage_);
+	}
+
+	friend void swap(basic_small_task& lhs, basic_small_task& rhs) noexcept{
+		basic_small_task temp{std::move(lhs)};
+		lhs = std::move(rhs);
+		rhs = std::move(temp);
+	}
+};
+
+export using small_task = basic_small_task<>;
+}
@@ -0,0 +1,519 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.concurrent.thread_pool;
+
+export import mo_yanxi.concurrent.small_task;
+import mo_yanxi.concurrent.work_stealing_deque;
+import mo_yanxi.concurrent.mpmc_queue;
+
+import std;
+
+namespace mo_yanxi::ccur{
+export class task_group;
+
+/**
+ * @brief 工作窃取线程池
+ *
+ * - 每个工作线程持有一个 Chase-Lev 双端队列，本线程派生的任务压入自身队列底部
+ * - 外部线程提交的任务进入全局注入队列（无锁 mpmc_queue）
+ * - 空闲线程依次尝试：自身队列 -> 注入队列 -> 随机窃取其他线程，仍无任务时基于 atomic::wait 休眠
+ * - join / parallel_for 的子任务分配在调用方栈上，等待期间调用线程会执行其他任务
+ *
+ * 不需要返回值时使用 submit（small_task，无共享状态）；需要 future 时使用 async。
+ *
+ * @warning 析构会等待所有已提交任务执行完毕，析构开始后不得再提交任务。
+ */
+export
+class thread_pool{
+public:
+	using size_type = std::size_t;
+
+	static constexpr size_type default_injection_capacity = 1 << 12;
+
+private:
+	friend task_group;
+
+	struct job{
+		void (*execute)(job*) noexcept;
+	};
+
+	// 0 未完成，1 正在通知，2 已完成；等待方只有见到 2 后才可销毁所在对象
+	struct completion{
+		std::atomic<std::uint32_t> state{};
+
+		void signal() noexcept{
+			state.store(1, std::memory_order_release);
+			state.notify_all();
+			state.store(2, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool ready() const noexcept{
+			return state.load(std::memory_order_acquire) != 0;
+		}
+
+		void wait() const noexcept{
+			state.wait(0, std::memory_order_acquire);
+			while(state.load(std::memory_order_acquire) != 2){
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	template <typename Fn>
+	struct stack_job : job{
+		Fn* fn;
+		completion done{};
+		std::exception_ptr exception{};
+
+		[[nodiscard]] explicit stack_job(Fn& fn) noexcept
+			: job{&stack_job::execute_}, fn(std::addressof(fn)){
+		}
+
+	private:
+		static void execute_(job* self) noexcept{
+			auto& s = static_cast<stack_job&>(*self);
+			try{
+				std::invoke(*s.fn);
+			} catch(...){
+				s.exception = std::current_exception();
+			}
+			s.done.signal();
+		}
+	};
+
+	struct group_state{
+		std::atomic<size_type> pending{};
+		// 正在执行完成通知的任务数，归零前 group_state 不可销毁
+		std::atomic<std::uint32_t> notifying{};
+		std::atomic_flag has_exception{};
+		std::exception_ptr exception{};
+
+		void finish(std::exception_ptr ex) noexcept{
+			if(ex && !has_exception.test_and_set(std::memory_order_acq_rel)){
+				exception = std::move(ex);
+			}
+			notifying.fetch_add(1, std::memory_order_relaxed);
+			if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1){
+				pending.notify_all();
+			}
+			notifying.fetch_sub(1, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool idle() const noexcept{
+			return pending.load(std::memory_order_acquire) == 0;
+		}
+
+		void settle() const noexcept{
+			while(notifying.load(std::memory_order_acquire) != 0){
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	struct task_job : job{
+		small_task task{};
+		group_state* group{};
+		task_job* next_free{};
+
+		[[nodiscard]] task_job() noexcept
+			: job{&task_job::execute_}{
+		}
+
+	private:
+		static void execute_(job* self) noexcept{
+			auto* tj = static_cast<task_job*>(self);
+			std::exception_ptr ex{};
+			if(tj->group){
+				try{
+					tj->task();
+				} catch(...){
+					ex = std::current_exception();
+				}
+			} else{
+				// 无人等待的任务，异常无处传递
+				tj->task();
+			}
+
+			group_state* group = tj->group;
+			thread_pool::recycle_(tj);
+			if(group) group->finish(std::move(ex));
+		}
+	};
+
+	struct alignas(std::hardware_destructive_interference_size) worker{
+		thread_pool* pool;
+		size_type index;
+		work_stealing_deque<job*> deque{};
+		std::uint64_t rng;
+		task_job* free_list{};
+		size_type free_count{};
+
+		[[nodiscard]] worker(thread_pool* pool, size_type index) noexcept
+			: pool(pool), index(index), rng(0x9E3779B97F4A7C15ULL * (index + 1)){
+		}
+
+		~worker(){
+			while(free_list){
+				delete std::exchange(free_list, free_list->next_free);
+			}
+		}
+
+		FORCE_INLINE std::uint64_t next_random() noexcept{
+			rng ^= rng << 13;
+			rng ^= rng >> 7;
+			rng ^= rng << 17;
+			return rng;
+		}
+	};
+
+	static constexpr size_type max_free_jobs = 256;
+	static constexpr unsigned spin_before_sleep = 64;
+
+	static inline thread_local worker* current_ = nullptr;
+
+	std::vector<std::unique_ptr<worker>> workers_{};
+	mpmc_queue<job*> injection_;
+	std::vector<std::jthread> threads_{};
+
+	alignas(std::hardware_destructive_interference_size) std::atomic<std::uint32_t> wake_epoch_{};
+	std::atomic<std::uint32_t> sleepers_{};
+	std::atomic_bool stopping_{};
+
+public:
+	/**
+	 * @param thread_count 工作线程数，0 时使用硬件并发数
+	 * @param injection_capacity 全局注入队列容量，满时外部提交将阻塞
+	 */
+	[[nodiscard]] explicit thread_pool(
+		size_type thread_count = 0,
+		size_type injection_capacity = default_injection_capacity)
+		: injection_(injection_capacity){
+		if(thread_count == 0){
+			thread_count = std::max<size_type>(1, std::thread::hardware_concurrency());
+		}
+
+		workers_.reserve(thread_count);
+		for(size_type i = 0; i < thread_count; ++i){
+			workers_.push_back(std::make_unique<worker>(this, i));
+		}
+
+		threads_.reserve(thread_count);
+		for(size_type i = 0; i < thread_count; ++i){
+			threads_.emplace_back([this, i]{
+				this->run_(*workers_[i]);
+			});
+		}
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool(){
+		stopping_.store(true, std::memory_order_release);
+		wake_epoch_.fetch_add(1, std::memory_order_release);
+		wake_epoch_.notify_all();
+		threads_.clear();
+	}
+
+	[[nodiscard]] size_type size() const noexcept{
+		return workers_.size();
+	}
+
+	[[nodiscard]] bool in_worker_thread() const noexcept{
+		return current_ && current_->pool == this;
+	}
+
+	/**
+	 * @brief 提交不需要返回值的任务
+	 *
+	 * @warning 任务抛出的异常无处传递，将导致 std::terminate
+	 */
+	template <typename Fn>
+		requires std::constructible_from<small_task, Fn&&>
+	void submit(Fn&& fn){
+		this->spawn_(this->make_task_job_(small_task{std::forward<Fn>(fn)}, nullptr));
+	}
+
+	/**
+	 * @brief 提交任务并通过 future 获取结果或异常
+	 */
+	template <typename Fn>
+		requires (std::move_constructible<std::decay_t<Fn>> && std::invocable<std::decay_t<Fn>&>)
+	[[nodiscard]] auto async(Fn&& fn){
+		using result_type = std::invoke_result_t<std::decay_t<Fn>&>;
+		std::packaged_task<result_type()> task{std::forward<Fn>(fn)};
+		auto future = task.get_future();
+		this->submit(std::move(task));
+		return future;
+	}
+
+	/**
+	 * @brief 并行执行两个函数，全部完成后返回
+	 *
+	 * 右侧函数以栈上任务形式压入本线程队列以供窃取，左侧函数在当前线程直接执行。
+	 * 两者的异常在返回前重新抛出（左侧优先）。
+	 */
+	template <std::invocable FnL, std::invocable FnR>
+	void join(FnL&& lhs, FnR&& rhs){
+		if(!this->in_worker_thread()){
+			auto fn = [&]{ this->join(lhs, rhs); };
+			this->run_in_pool_(fn);
+			return;
+		}
+
+		worker& w = *current_;
+		stack_job<std::remove_reference_t<FnR>> rhs_job{rhs};
+		w.deque.push(&rhs_job);
+		this->wake_one_();
+
+		std::exception_ptr lhs_exception{};
+		try{
+			std::invoke(lhs);
+		} catch(...){
+			lhs_exception = std::current_exception();
+		}
+
+		// 未被窃取时 rhs_job 仍在队列中（位于左侧新派生任务之下），依次弹出执行
+		while(!rhs_job.done.ready()){
+			const auto j = w.deque.pop();
+			if(!j) break;
+			(*j)->execute(*j);
+		}
+
+		if(!rhs_job.done.ready()){
+			this->help_until_(w, [&]{ return rhs_job.done.ready(); }, [&]{ rhs_job.done.wait(); });
+		}
+		rhs_job.done.wait();
+
+		if(lhs_exception) std::rethrow_exception(lhs_exception);
+		if(rhs_job.exception) std::rethrow_exception(rhs_job.exception);
+	}
+
+	/**
+	 * @brief 对 [first, last) 二分派生任务
+	 *
+	 * @param fn 可按 fn(i) 逐下标调用，或按 fn(begin, end) 逐块调用
+	 * @param grain 单个任务的最小区间长度，0 时按线程数的 8 倍切分
+	 */
+	template <typename Fn>
+		requires (std::invocable<Fn&, size_type> || std::invocable<Fn&, size_type, size_type>)
+	void parallel_for(size_type first, size_type last, Fn&& fn, size_type grain = 0){
+		if(first >= last) return;
+		if(grain == 0){
+			grain = std::max<size_type>(1, (last - first) / (this->size() * 8));
+		}
+		this->parallel_for_impl_(first, last, fn, grain);
+	}
+
+	template <std::ranges::random_access_range Rng, typename Fn>
+		requires (std::ranges::sized_range<Rng> && std::invocable<Fn&, std::ranges::range_reference_t<Rng>>)
+	void parallel_for_each(Rng&& range, Fn&& fn, size_type grain = 0){
+		auto itr = std::ranges::begin(range);
+		this->parallel_for(0, static_cast<size_type>(std::ranges::size(range)), [&](size_type begin, size_type end){
+			for(auto i = begin; i != end; ++i){
+				std::invoke(fn, itr[static_cast<std::ranges::range_difference_t<Rng>>(i)]);
+			}
+		}, grain);
+	}
+
+private:
+	template <typename Fn>
+	void parallel_for_impl_(size_type first, size_type last, Fn& fn, size_type grain){
+		if(last - first <= grain){
+			if constexpr(std::invocable<Fn&, size_type, size_type>){
+				std::invoke(fn, first, last);
+			} else{
+				for(auto i = first; i != last; ++i){
+					std::invoke(fn, i);
+				}
+			}
+			return;
+		}
+
+		const size_type mid = first + (last - first) / 2;
+		this->join(
+			[&]{ this->parallel_for_impl_(first, mid, fn, grain); },
+			[&]{ this->parallel_for_impl_(mid, last, fn, grain); });
+	}
+
+	template <typename Fn>
+	void run_in_pool_(Fn& fn){
+		stack_job<Fn> j{fn};
+		injection_.push(&j);
+		this->wake_one_();
+		j.done.wait();
+		if(j.exception) std::rethrow_exception(j.exception);
+	}
+
+	task_job* make_task_job_(small_task&& task, group_state* group){
+		task_job* tj;
+		if(worker* w = current_; w && w->free_list){
+			tj = std::exchange(w->free_list, w->free_list->next_free);
+			--w->free_count;
+		} else{
+			tj = new task_job{};
+		}
+		tj->task = std::move(task);
+		tj->group = group;
+		return tj;
+	}
+
+	static void recycle_(task_job* tj) noexcept{
+		tj->task.reset();
+		if(worker* w = current_; w && w->free_count < max_free_jobs){
+			tj->next_free = std::exchange(w->free_list, tj);
+			++w->free_count;
+		} else{
+			delete tj;
+		}
+	}
+
+	void spawn_(job* j){
+		if(this->in_worker_thread()){
+			current_->deque.push(j);
+		} else{
+			injection_.push(j);
+		}
+		this->wake_one_();
+	}
+
+	void wake_one_() noexcept{
+		// 与 run_ 中休眠前的栅栏配对
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(sleepers_.load(std::memory_order_relaxed) == 0) return;
+		wake_epoch_.fetch_add(1, std::memory_order_release);
+		wake_epoch_.notify_one();
+	}
+
+	job* find_work_(worker& w) noexcept{
+		if(const auto j = w.deque.pop()) return *j;
+		if(const auto j = injection_.try_consume()) return *j;
+
+		const size_type count = workers_.size();
+		const size_type start = static_cast<size_type>(w.next_random() % count);
+		for(size_type i = 0; i < count; ++i){
+			const size_type victim = (start + i) % count;
+			if(victim == w.index) continue;
+			if(const auto j = workers_[victim]->deque.steal()) return *j;
+		}
+		return nullptr;
+	}
+
+	template <std::predicate<> Done, std::invocable<> Block>
+	void help_until_(worker& w, Done done, Block block) noexcept{
+		unsigned idle = 0;
+		while(!done()){
+			if(job* j = this->find_work_(w)){
+				j->execute(j);
+				idle = 0;
+			} else if(++idle < spin_before_sleep){
+				std::this_thread::yield();
+			} else{
+				block();
+				idle = 0;
+			}
+		}
+	}
+
+	void run_(worker& w) noexcept{
+		current_ = &w;
+
+		while(true){
+			if(job* j = this->find_work_(w)){
+				j->execute(j);
+				continue;
+			}
+
+			job* found = nullptr;
+			for(unsigned i = 0; i < spin_before_sleep && !found; ++i){
+				std::this_thread::yield();
+				found = this->find_work_(w);
+			}
+			if(found){
+				found->execute(found);
+				continue;
+			}
+
+			sleepers_.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto epoch = wake_epoch_.load(std::memory_order_acquire);
+			found = this->find_work_(w);
+			if(!found && !stopping_.load(std::memory_order_acquire)){
+				wake_epoch_.wait(epoch, std::memory_order_acquire);
+			}
+			sleepers_.fetch_sub(1, std::memory_order_relaxed);
+
+			if(found){
+				found->execute(found);
+			} else if(stopping_.load(std::memory_order_acquire)){
+				// 再确认一次，确保退出前注入队列与自身队列已清空
+				if(job* j = this->find_work_(w)){
+					j->execute(j);
+					continue;
+				}
+				break;
+			}
+		}
+
+		current_ = nullptr;
+	}
+};
+
+/**
+ * @brief 一组动态派生的任务，wait 时等待全部完成并重新抛出首个异常
+ *
+ * 在工作线程上 wait 会执行其他任务而非阻塞。
+ */
+export
+class task_group{
+	thread_pool* pool_;
+	thread_pool::group_state state_{};
+
+public:
+	[[nodiscard]] explicit task_group(thread_pool& pool) noexcept
+		: pool_(std::addressof(pool)){
+	}
+
+	task_group(const task_group&) = delete;
+	task_group& operator=(const task_group&) = delete;
+
+	~task_group(){
+		this->wait_impl_();
+	}
+
+	template <typename Fn>
+		requires std::constructible_from<small_task, Fn&&>
+	void run(Fn&& fn){
+		state_.pending.fetch_add(1, std::memory_order_relaxed);
+		pool_->spawn_(pool_->make_task_job_(small_task{std::forward<Fn>(fn)}, &state_));
+	}
+
+	void wait(){
+		this->wait_impl_();
+		if(state_.exception){
+			auto ex = std::exchange(state_.exception, nullptr);
+			state_.has_exception.clear(std::memory_order_relaxed);
+			std::rethrow_exception(std::move(ex));
+		}
+	}
+
+private:
+	void wait_impl_() noexcept{
+		const auto block = [this]{
+			if(const auto p = state_.pending.load(std::memory_order_acquire); p != 0){
+				state_.pending.wait(p, std::memory_order_acquire);
+			}
+		};
+
+		if(pool_->in_worker_thread()){
+			pool_->help_until_(*thread_pool::current_, [this]{ return state_.idle(); }, block);
+		} else{
+			while(!state_.idle()) block();
+		}
+		state_.settle();
+	}
+};
+}
@@ -0,0 +1,152 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.concurrent.work_stealing_deque;
+
+import std;
+
+namespace mo_yanxi::ccur{
+/**
+ * @brief Chase-Lev 工作窃取双端队列
+ *
+ * - 所有者线程在底部 push/pop（LIFO），其他线程从顶部 steal（FIFO）
+ * - 所有者操作在无竞争时不含 RMW，仅在争抢最后一个元素时 CAS
+ * - 扩容时旧环形数组保留到析构，窃取者可能仍在读取
+ *
+ * 内存序遵循 Lê 等人的 C11 形式化版本（PPoPP'13）。
+ *
+ * @tparam T 需可平凡复制且其原子类型无锁，通常为指针
+ */
+export
+template <typename T>
+	requires (std::is_trivially_copyable_v<T> && std::atomic<T>::is_always_lock_free)
+class work_stealing_deque{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+
+private:
+	using index_type = std::int64_t;
+
+	struct ring{
+		index_type capacity;
+		index_type mask;
+		std::unique_ptr<std::atomic<value_type>[]> data;
+
+		[[nodiscard]] explicit ring(index_type capacity)
+			: capacity(capacity), mask(capacity - 1), data(std::make_unique<std::atomic<value_type>[]>(static_cast<size_type>(capacity))){
+		}
+
+		FORCE_INLINE value_type get(index_type i) const noexcept{
+			return data[i & mask].load(std::memory_order_relaxed);
+		}
+
+		FORCE_INLINE void put(index_type i, value_type value) noexcept{
+			data[i & mask].store(value, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] std::unique_ptr<ring> grow(index_type bottom, index_type top) const{
+			auto next = std::make_unique<ring>(capacity * 2);
+			for(index_type i = top; i != bottom; ++i){
+				next->put(i, this->get(i));
+			}
+			return next;
+		}
+	};
+
+	alignas(std::hardware_destructive_interference_size) std::atomic<index_type> top_{};
+	alignas(std::hardware_destructive_interference_size) std::atomic<index_type> bottom_{};
+	std::atomic<ring*> ring_{};
+
+	// 仅所有者访问：当前及已退役的全部环形数组
+	std::vector<std::unique_ptr<ring>> rings_{};
+
+public:
+	[[nodiscard]] explicit work_stealing_deque(size_type initial_capacity = 256){
+		rings_.push_back(std::make_unique<ring>(static_cast<index_type>(std::bit_ceil(std::max<size_type>(initial_capacity, 2)))));
+		ring_.store(rings_.back().get(), std::memory_order_relaxed);
+	}
+
+	work_stealing_deque(const work_stealing_deque&) = delete;
+	work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+	/**
+	 * @brief 近似元素数量
+	 */
+	[[nodiscard]] size_type size() const noexcept{
+		const auto b = bottom_.load(std::memory_order_relaxed);
+		const auto t = top_.load(std::memory_order_relaxed);
+		return static_cast<size_type>(b > t ? b - t : 0);
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return this->size() == 0;
+	}
+
+	/**
+	 * @warning 仅所有者线程可调用
+	 */
+	void push(value_type value){
+		const index_type b = bottom_.load(std::memory_order_relaxed);
+		const index_type t = top_.load(std::memory_order_acquire);
+		ring* r = ring_.load(std::memory_order_relaxed);
+
+		if(b - t > r->capacity - 1) [[unlikely]] {
+			rings_.push_back(r->grow(b, t));
+			r = rings_.back().get();
+			ring_.store(r, std::memory_order_release);
+		}
+
+		r->put(b, value);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom_.store(b + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @warning 仅所有者线程可调用
+	 */
+	[[nodiscard]] std::optional<value_type> pop() noexcept{
+		const index_type b = bottom_.load(std::memory_order_relaxed) - 1;
+		ring* r = ring_.load(std::memory_order_relaxed);
+		bottom_.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		index_type t = top_.load(std::memory_order_relaxed);
+
+		if(t > b){
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		value_type value = r->get(b);
+		if(t == b){
+			// 最后一个元素，与窃取者竞争
+			const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			if(!won) return std::nullopt;
+		}
+		return value;
+	}
+
+	/**
+	 * @brief 从顶部窃取一个元素，可由任意线程调用
+	 *
+	 * 返回空既可能是队列为空，也可能是与其他线程竞争失败。
+	 */
+	[[nodiscard]] std::optional<value_type> steal() noexcept{
+		index_type t = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const index_type b = bottom_.load(std::memory_order_acquire);
+
+		if(t >= b) return std::nullopt;
+
+		const ring* r = ring_.load(std::memory_order_acquire);
+		value_type value = r->get(t);
+		if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+			return std::nullopt;
+		}
+		return value;
+	}
+};
+}
@@ -0,0 +1,346 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.arena;
+
+export import mo_yanxi.byte_pool;
+
+import std;
+
+namespace mo_yanxi{
+/**
+ * @brief 单调分配器的回退位置，由 basic_monotonic_arena::mark 取得
+ */
+export
+struct arena_marker{
+	std::size_t chunk;
+	std::size_t offset;
+};
+
+/**
+ * @brief 以 byte_pool 为块来源的单调（bump）内存资源
+ *
+ * - 分配仅移动游标，单独释放为空操作，内存在 rewind/reset 时整体回收
+ * - 回收后的块保留在 arena 中供后续复用，release/release_unused 才归还给池
+ * - 超过块大小的请求单独向池申请一块
+ * - 启用 MO_YANXI_UTILITY_ENABLE_CHECK 时，回收的内存被填充为毒值，
+ *   再次分配时校验毒值以发现 reset 之后的写入，释放已回收的内存会直接终止
+ *
+ * 典型用法为每帧一次 reset，帧内临时容器通过 arena_allocator 或 std::pmr 容器分配。
+ *
+ * @warning 非线程安全；池的生命周期需长于 arena
+ */
+export
+template <typename Pool = byte_pool<>>
+class basic_monotonic_arena : public std::pmr::memory_resource{
+public:
+	using pool_type = Pool;
+	using size_type = std::size_t;
+
+	static constexpr size_type default_chunk_size = 64 * 1024;
+
+private:
+	static constexpr std::byte poison_value{0xDD};
+
+	struct chunk{
+		byte_buffer<std::byte> buffer;
+		size_type used;
+		// 曾经使用过的最高位置，[used, dirty) 在检查模式下为毒值
+		size_type dirty;
+
+		[[nodiscard]] FORCE_INLINE size_type capacity() const noexcept{
+			return buffer.capacity();
+		}
+	};
+
+	pool_type* pool_;
+	size_type chunk_size_;
+	std::vector<chunk> chunks_{};
+	size_type current_{};
+
+	FORCE_INLINE static void poison_(chunk& c, size_type from) noexcept{
+#if MO_YANXI_UTILITY_ENABLE_CHECK
+		std::ranges::fill(c.buffer.data() + from, c.buffer.data() + c.used, poison_value);
+#endif
+	}
+
+	static void verify_poison_(const chunk& c, size_type from, size_type to) noexcept{
+#if MO_YANXI_UTILITY_ENABLE_CHECK
+		if(c.dirty <= from) return;
+		const auto* first = c.buffer.data() + from;
+		const auto* last = c.buffer.data() + std::min(to, c.dirty);
+		if(const auto* p = std::ranges::find_if(first, last, [](std::byte b){ return b != poison_value; }); p < last){
+			std::println(std::cerr, "Arena Memory Written After Reset: {:p}", static_cast<const void*>(p));
+			std::terminate();
+		}
+#endif
+	}
+
+	FORCE_INLINE static void* try_bump_(chunk& c, size_type bytes, size_type align) noexcept{
+		const auto base = reinterpret_cast<std::uintptr_t>(c.buffer.data());
+		const auto aligned = (base + c.used + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+		const auto offset = static_cast<size_type>(aligned - base);
+		if(offset + bytes > c.capacity()) return nullptr;
+
+		verify_poison_(c, c.used, offset + bytes);
+		c.used = offset + bytes;
+		c.dirty = std::max(c.dirty, c.used);
+		return c.buffer.data() + offset;
+	}
+
+	void* allocate_slow_(size_type bytes, size_type align){
+		// 池提供的块至少按 new 的默认对齐对齐
+		const size_type worst = bytes + (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? align - 1 : 0);
+		const size_type next = chunks_.empty() ? 0 : current_ + 1;
+
+		for(size_type i = next; i < chunks_.size(); ++i){
+			if(chunks_[i].capacity() >= worst){
+				std::swap(chunks_[i], chunks_[next]);
+				current_ = next;
+				return try_bump_(chunks_[next], bytes, align);
+			}
+		}
+
+		const size_type request = std::max(chunk_size_, worst);
+		if(request > std::numeric_limits<unsigned>::max()){
+			throw std::bad_alloc{};
+		}
+
+		const auto buffer = pool_->acquire_raw(static_cast<unsigned>(request));
+		try{
+			chunks_.insert(chunks_.begin() + static_cast<std::ptrdiff_t>(next), chunk{buffer, 0, 0});
+		} catch(...){
+			pool_->retire_raw(buffer);
+			throw;
+		}
+		current_ = next;
+		return try_bump_(chunks_[next], bytes, align);
+	}
+
+	void check_owned_(const void* p, size_type bytes) const noexcept{
+#if MO_YANXI_UTILITY_ENABLE_CHECK
+		const auto* ptr = static_cast<const std::byte*>(p);
+		if(!chunks_.empty()){
+			for(size_type i = 0; i <= current_; ++i){
+				const auto& c = chunks_[i];
+				if(ptr >= c.buffer.data() && ptr + bytes <= c.buffer.data() + c.used) return;
+			}
+		}
+		std::println(std::cerr, "Deallocate Arena Memory After Reset Or Not Owned: {:p}", p);
+		std::terminate();
+#endif
+	}
+
+protected:
+	void* do_allocate(size_type bytes, size_type align) override{
+		return this->allocate_bytes(bytes, align);
+	}
+
+	void do_deallocate(void* p, size_type bytes, size_type align) override{
+		this->deallocate_bytes(p, bytes, align);
+	}
+
+	[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+		return this == &other;
+	}
+
+public:
+	[[nodiscard]] explicit basic_monotonic_arena(pool_type& pool, size_type chunk_size = default_chunk_size)
+		: pool_(&pool), chunk_size_(std::max<size_type>(chunk_size, 1)){
+	}
+
+	basic_monotonic_arena(const basic_monotonic_arena&) = delete;
+	basic_monotonic_arena& operator=(const basic_monotonic_arena&) = delete;
+
+	~basic_monotonic_arena() override{
+		this->release();
+	}
+
+	/**
+	 * @brief 非虚的分配入口，arena_allocator 直接调用以避免虚派发
+	 */
+	[[nodiscard]] FORCE_INLINE void* allocate_bytes(size_type bytes, size_type align = alignof(std::max_align_t)){
+		assert(std::has_single_bit(align));
+		if(bytes == 0) bytes = 1;
+		if(!chunks_.empty()){
+			if(void* p = try_bump_(chunks_[current_], bytes, align)) [[likely]] return p;
+		}
+		return this->allocate_slow_(bytes, align);
+	}
+
+	/**
+	 * @brief 单独释放不回收内存，仅在检查模式下校验指针仍处于有效区间
+	 */
+	FORCE_INLINE void deallocate_bytes(void* p, size_type bytes, size_type align = alignof(std::max_align_t)) noexcept{
+		(void)align;
+		this->check_owned_(p, bytes == 0 ? 1 : bytes);
+	}
+
+	[[nodiscard]] arena_marker mark() const noexcept{
+		if(chunks_.empty()) return {};
+		return {current_, chunks_[current_].used};
+	}
+
+	/**
+	 * @brief 回退到 marker，之后分配的内存全部失效
+	 */
+	void rewind(arena_marker marker) noexcept{
+		if(chunks_.empty()){
+			assert(marker.chunk == 0 && marker.offset == 0);
+			return;
+		}
+		assert(marker.chunk <= current_);
+		assert(marker.chunk < current_ || marker.offset <= chunks_[current_].used);
+
+		for(size_type i = marker.chunk + 1; i <= current_; ++i){
+			basic_monotonic_arena::poison_(chunks_[i], 0);
+			chunks_[i].used = 0;
+		}
+
+		chunk& c = chunks_[marker.chunk];
+		basic_monotonic_arena::poison_(c, marker.offset);
+		c.used = marker.offset;
+		current_ = marker.chunk;
+	}
+
+	/**
+	 * @brief 回收全部内存，块保留供复用
+	 */
+	void reset() noexcept{
+		this->rewind({});
+	}
+
+	/**
+	 * @brief 回收全部内存并将所有块归还给池
+	 */
+	void release() noexcept{
+		for(const auto& c : chunks_){
+			pool_->retire_raw(c.buffer);
+		}
+		chunks_.clear();
+		current_ = 0;
+	}
+
+	/**
+	 * @brief 将当前块之后未使用的块归还给池
+	 */
+	void release_unused() noexcept{
+		if(chunks_.empty()) return;
+		for(size_type i = current_ + 1; i < chunks_.size(); ++i){
+			pool_->retire_raw(chunks_[i].buffer);
+		}
+		chunks_.erase(chunks_.begin() + static_cast<std::ptrdiff_t>(current_ + 1), chunks_.end());
+		if(current_ == 0 && chunks_.front().used == 0){
+			this->release();
+		}
+	}
+
+	[[nodiscard]] size_type bytes_used() const noexcept{
+		if(chunks_.empty()) return 0;
+		size_type rst{};
+		for(size_type i = 0; i <= current_; ++i){
+			rst += chunks_[i].used;
+		}
+		return rst;
+	}
+
+	[[nodiscard]] size_type bytes_reserved() const noexcept{
+		size_type rst{};
+		for(const auto& c : chunks_){
+			rst += c.capacity();
+		}
+		return rst;
+	}
+
+	[[nodiscard]] size_type chunk_count() const noexcept{
+		return chunks_.size();
+	}
+
+	[[nodiscard]] size_type chunk_size() const noexcept{
+		return chunk_size_;
+	}
+
+	[[nodiscard]] pool_type& pool() const noexcept{
+		return *pool_;
+	}
+};
+
+export using monotonic_arena = basic_monotonic_arena<>;
+
+/**
+ * @brief 作用域内的临时分配，析构时回退到构造时的位置
+ */
+export
+template <typename Pool>
+class arena_scope{
+	basic_monotonic_arena<Pool>* arena_;
+	arena_marker marker_;
+
+public:
+	[[nodiscard]] explicit arena_scope(basic_monotonic_arena<Pool>& arena) noexcept
+		: arena_(&arena), marker_(arena.mark()){
+	}
+
+	arena_scope(const arena_scope&) = delete;
+	arena_scope& operator=(const arena_scope&) = delete;
+
+	~arena_scope(){
+		arena_->rewind(marker_);
+	}
+};
+
+/**
+ * @brief 绑定到 basic_monotonic_arena 的标准分配器，不经过 memory_resource 的虚函数
+ */
+export
+template <typename T, typename Pool = byte_pool<>>
+class arena_allocator{
+	template <typename U, typename P>
+	friend class arena_allocator;
+
+	basic_monotonic_arena<Pool>* arena_;
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	template <typename U>
+	struct rebind{
+		using other = arena_allocator<U, Pool>;
+	};
+
+	[[nodiscard]] explicit(false) arena_allocator(basic_monotonic_arena<Pool>& arena) noexcept
+		: arena_(&arena){
+	}
+
+	template <typename U>
+	[[nodiscard]] explicit(false) arena_allocator(const arena_allocator<U, Pool>& other) noexcept
+		: arena_(other.arena_){
+	}
+
+	[[nodiscard]] T* allocate(size_type n){
+		if(n > std::numeric_limits<size_type>::max() / sizeof(T)){
+			throw std::bad_array_new_length{};
+		}
+		return static_cast<T*>(arena_->allocate_bytes(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept{
+		arena_->deallocate_bytes(p, n * sizeof(T), alignof(T));
+	}
+
+	[[nodiscard]] basic_monotonic_arena<Pool>& arena() const noexcept{
+		return *arena_;
+	}
+
+	template <typename U>
+	[[nodiscard]] bool operator==(const arena_allocator<U, Pool>& other) const noexcept{
+		return arena_ == other.arena_;
+	}
+};
+}
@@ -27,7 +27,10 @@ namespace mo_yanxi {
     export template <typename Alloc = std::allocator<std::byte>>
     struct byte_pool;
 
-    export template <typename T, typename Alloc>
+    export template <typename Alloc = std::allocator<std::byte>>
+    struct concurrent_byte_pool;
+
+    export template <typename T, typename Alloc, typename Pool = byte_pool<Alloc>>
     struct byte_borrow;
 
     export template <typename T>
@@ -41,7 +44,10 @@ namespace mo_yanxi {
         template <typename Alloc>
         friend struct byte_pool;
 
-        template <typename U, typename Alloc>
+        template <typename Alloc>
+        friend struct concurrent_byte_pool;
+
+        template <typename U, typename Alloc, typename Pool>
         friend struct byte_borrow;
 
         template <typename U>
@@ -126,10 +132,10 @@ namespace mo_yanxi {
         }
     };
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Pool>
     struct byte_borrow {
     private:
-        using pool_t = byte_pool<Alloc>;
+        using pool_t = Pool;
         pool_t* owner_{};
         byte_buffer<T> array_{};
 
@@ -173,7 +179,7 @@ namespace mo_yanxi {
             return *this;
         }
 
-        constexpr byte_pool<Alloc>& owner() const noexcept {
+        constexpr pool_t& owner() const noexcept {
             assert(owner_ != nullptr);
             return *owner_;
         }
@@ -392,11 +398,441 @@ namespace mo_yanxi {
         }
     };
 
+    /**
+     * @brief 线程缓存基类，由线程局部注册表持有，用于线程退出时归还缓存
+     */
+    struct pool_thread_cache_base {
+        // 仅在线程退出与池析构时使用，常规路径无锁
+        std::mutex mutex{};
+        bool detached{false};
+
+        virtual void flush_on_thread_exit() noexcept = 0;
+        virtual ~pool_thread_cache_base() = default;
+    };
+
+    struct pool_thread_cache_registry {
+        struct entry {
+            std::uint64_t pool_id;
+            std::shared_ptr<pool_thread_cache_base> cache;
+        };
+
+        std::vector<entry> entries{};
+        std::uint64_t last_id{};
+        pool_thread_cache_base* last_cache{};
+
+        pool_thread_cache_base* find(std::uint64_t pool_id) noexcept {
+            if (last_id == pool_id && last_cache) return last_cache;
+            for (const auto& e : entries) {
+                if (e.pool_id == pool_id) {
+                    last_id = pool_id;
+                    last_cache = e.cache.get();
+                    return last_cache;
+                }
+            }
+            return nullptr;
+        }
+
+        void add(std::uint64_t pool_id, std::shared_ptr<pool_thread_cache_base> cache) {
+            // 顺带清理已析构池遗留的条目
+            std::erase_if(entries, [](const entry& e) {
+                std::lock_guard lock{e.cache->mutex};
+                return e.cache->detached;
+            });
+            last_id = pool_id;
+            last_cache = cache.get();
+            entries.push_back({pool_id, std::move(cache)});
+        }
+
+        ~pool_thread_cache_registry() {
+            for (const auto& e : entries) {
+                std::lock_guard lock{e.cache->mutex};
+                if (!e.cache->detached) {
+                    e.cache->flush_on_thread_exit();
+                    e.cache->detached = true;
+                }
+            }
+        }
+    };
+
+    thread_local pool_thread_cache_registry thread_cache_registry_{};
+
+    inline std::atomic<std::uint64_t> concurrent_pool_id_counter_{1};
+
+    export
+    struct byte_pool_class_statistics {
+        unsigned capacity_bytes;
+        std::uint64_t acquires;
+        std::uint64_t retires;
+        std::uint64_t system_allocations;
+        std::uint64_t system_deallocations;
+        std::size_t depot_cached;
+
+        [[nodiscard]] constexpr std::uint64_t outstanding() const noexcept {
+            return acquires - retires;
+        }
+
+        constexpr byte_pool_class_statistics& operator+=(const byte_pool_class_statistics& other) noexcept {
+            acquires += other.acquires;
+            retires += other.retires;
+            system_allocations += other.system_allocations;
+            system_deallocations += other.system_deallocations;
+            depot_cached += other.depot_cached;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief 线程安全的字节池：线程局部弹匣 + 按尺寸分级的共享仓库
+     *
+     * - 每个线程对每个尺寸级别持有一个小弹匣，常规 acquire/retire 不加锁、不含原子 RMW
+     * - 弹匣空时从仓库批量补充一半，满时批量归还一半，仓库按尺寸级别各自加锁
+     * - 任意线程都可以归还其他线程借出的缓冲，缓冲进入归还线程的弹匣
+     * - 线程退出时其弹匣自动归还仓库
+     *
+     * 尺寸级别与 byte_pool 一致：512B 到 16MB 共 16 级，更大的请求直接走分配器。
+     *
+     * @warning 分配器需是线程安全的；trim() 只能回收仓库与当前线程弹匣中的缓冲。
+     */
+    template <typename Alloc>
+    struct concurrent_byte_pool {
+        using allocator_type = Alloc;
+
+    private:
+        using alloc_traits = std::allocator_traits<allocator_type>;
+
+        static constexpr unsigned MIN_SHIFT = 9;
+        static constexpr unsigned BUCKET_CNT = 16;
+        static constexpr unsigned MAGAZINE_CAPACITY = 32;
+
+        // 大尺寸级别的弹匣更小，避免每个线程囤积过多内存
+        FORCE_INLINE static constexpr unsigned magazine_capacity(unsigned idx) noexcept {
+            return std::max(2u, MAGAZINE_CAPACITY >> (idx / 3));
+        }
+
+        FORCE_INLINE constexpr static unsigned get_bucket_index(unsigned capacity) noexcept {
+            return std::countr_zero(capacity) - MIN_SHIFT;
+        }
+
+        struct class_counters {
+            // 仅由所属线程写入，读取方可并发读取
+            std::atomic<std::uint64_t> acquires{};
+            std::atomic<std::uint64_t> retires{};
+
+            FORCE_INLINE static void bump(std::atomic<std::uint64_t>& counter) noexcept {
+                counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        };
+
+        struct magazine {
+            std::array<std::byte*, MAGAZINE_CAPACITY> items;
+            unsigned count{};
+        };
+
+        struct thread_cache final : pool_thread_cache_base {
+            concurrent_byte_pool* pool;
+            std::array<magazine, BUCKET_CNT> magazines{};
+            std::array<class_counters, BUCKET_CNT> counters{};
+
+            [[nodiscard]] explicit thread_cache(concurrent_byte_pool* pool) noexcept : pool(pool) {}
+
+            void flush_on_thread_exit() noexcept override {
+                pool->drain_cache_(*this);
+            }
+        };
+
+        struct alignas(std::hardware_destructive_interference_size) depot {
+            mutable std::mutex mutex{};
+            std::vector<std::byte*> items{};
+
+            std::atomic<std::uint64_t> system_allocations{};
+            std::atomic<std::uint64_t> system_deallocations{};
+            // 已退出线程的计数，线程退出时并入
+            std::atomic<std::uint64_t> retired_acquires{};
+            std::atomic<std::uint64_t> retired_retires{};
+        };
+
+        ADAPTED_NO_UNIQUE_ADDRESS allocator_type allocator_{};
+        std::uint64_t id_{concurrent_pool_id_counter_.fetch_add(1, std::memory_order_relaxed)};
+        std::array<depot, BUCKET_CNT> depots_{};
+
+        mutable std::mutex registry_mutex_{};
+        std::vector<std::shared_ptr<thread_cache>> caches_{};
+
+        std::byte* alloc_sys_(unsigned capacity_bytes) {
+            return std::to_address(alloc_traits::allocate(allocator_, capacity_bytes));
+        }
+
+        void dealloc_sys_(std::byte* ptr, unsigned capacity_bytes) noexcept {
+            alloc_traits::deallocate(allocator_, ptr, capacity_bytes);
+        }
+
+        thread_cache& local_cache_() {
+            if (auto* cache = thread_cache_registry_.find(id_)) [[likely]] {
+                return static_cast<thread_cache&>(*cache);
+            }
+
+            auto cache = std::make_shared<thread_cache>(this);
+            {
+                std::lock_guard lock{registry_mutex_};
+                // 已退出线程的弹匣与计数已并入仓库，顺带移除其缓存，避免线程更替时 caches_ 无限增长
+                std::erase_if(caches_, [](const std::shared_ptr<thread_cache>& c) {
+                    std::lock_guard cache_lock{c->mutex};
+                    return c->detached;
+                });
+                caches_.push_back(cache);
+            }
+            thread_cache_registry_.add(id_, cache);
+            return *cache;
+        }
+
+        // 从仓库取出至多一半弹匣容量的缓冲
+        unsigned refill_(magazine& mag, unsigned idx) {
+            depot& d = depots_[idx];
+            const unsigned want = magazine_capacity(idx) / 2;
+            std::lock_guard lock{d.mutex};
+            const auto take = static_cast<unsigned>(std::min<std::size_t>(want, d.items.size()));
+            std::ranges::copy(d.items.end() - take, d.items.end(), mag.items.data() + mag.count);
+            d.items.resize(d.items.size() - take);
+            mag.count += take;
+            return take;
+        }
+
+        // 将弹匣中较早放入的一半归还仓库
+        void flush_(magazine& mag, unsigned idx, unsigned keep) noexcept {
+            depot& d = depots_[idx];
+            const unsigned give = mag.count - keep;
+            {
+                std::lock_guard lock{d.mutex};
+                try {
+                    d.items.insert(d.items.end(), mag.items.data(), mag.items.data() + give);
+                } catch (...) {
+                    for (unsigned i = 0; i < give; ++i) {
+                        this->dealloc_sys_(mag.items[i], 1u << (idx + MIN_SHIFT));
+                        d.system_deallocations.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            std::ranges::copy(mag.items.data() + give, mag.items.data() + mag.count, mag.items.data());
+            mag.count = keep;
+        }
+
+        void drain_cache_(thread_cache& cache) noexcept {
+            for (unsigned idx = 0; idx < BUCKET_CNT; ++idx) {
+                if (cache.magazines[idx].count) this->flush_(cache.magazines[idx], idx, 0);
+                depots_[idx].retired_acquires.fetch_add(cache.counters[idx].acquires.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                depots_[idx].retired_retires.fetch_add(cache.counters[idx].retires.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                cache.counters[idx].acquires.store(0, std::memory_order_relaxed);
+                cache.counters[idx].retires.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        [[nodiscard]] concurrent_byte_pool() = default;
+
+        [[nodiscard]] explicit concurrent_byte_pool(const allocator_type& allocator)
+            : allocator_(allocator) {}
+
+        concurrent_byte_pool(const concurrent_byte_pool&) = delete;
+        concurrent_byte_pool& operator=(const concurrent_byte_pool&) = delete;
+
+        ~concurrent_byte_pool() {
+            {
+                std::lock_guard registry_lock{registry_mutex_};
+                for (const auto& cache : caches_) {
+                    std::lock_guard lock{cache->mutex};
+                    if (!cache->detached) {
+                        this->drain_cache_(*cache);
+                        cache->detached = true;
+                    }
+                }
+                caches_.clear();
+            }
+
+#ifdef MO_YANXI_BYTE_POOL_LEAK_CHECK
+            for (unsigned idx = 0; idx < BUCKET_CNT; ++idx) {
+                if (const auto stat = this->class_statistics(idx); stat.outstanding() != 0) {
+                    std::println(std::cerr, "Leak On Concurrent Byte Pool Detected. Class: {}B, Count: {}", stat.capacity_bytes, stat.outstanding());
+                    std::terminate();
+                }
+            }
+#endif
+
+            for (unsigned idx = 0; idx < BUCKET_CNT; ++idx) {
+                for (std::byte* ptr : depots_[idx].items) {
+                    this->dealloc_sys_(ptr, 1u << (idx + MIN_SHIFT));
+                }
+                depots_[idx].items.clear();
+            }
+        }
+
+        template <typename T = std::byte>
+        [[nodiscard]] byte_borrow<T, Alloc, concurrent_byte_pool> borrow(unsigned count) {
+            return byte_borrow<T, Alloc, concurrent_byte_pool>{this, acquire<T>(count)};
+        }
+
+        [[nodiscard]] raw_buffer acquire_raw(unsigned size_bytes) {
+            if (size_bytes == 0) [[unlikely]] {
+                return {};
+            }
+
+            const unsigned capacity = std::max(1u << MIN_SHIFT, std::bit_ceil(size_bytes));
+
+            if (capacity > (1u << (MIN_SHIFT + BUCKET_CNT - 1))) [[unlikely]] {
+                return raw_buffer::make_(this->alloc_sys_(capacity), size_bytes, capacity);
+            }
+
+            const unsigned idx = get_bucket_index(capacity);
+            thread_cache& cache = this->local_cache_();
+            magazine& mag = cache.magazines[idx];
+            class_counters::bump(cache.counters[idx].acquires);
+
+            if (mag.count == 0 && this->refill_(mag, idx) == 0) {
+                depots_[idx].system_allocations.fetch_add(1, std::memory_order_relaxed);
+                return raw_buffer::make_(this->alloc_sys_(capacity), size_bytes, capacity);
+            }
+
+            return raw_buffer::make_(mag.items[--mag.count], size_bytes, capacity);
+        }
+
+        void retire_raw(raw_buffer byte_array) noexcept {
+            if (!byte_array) return;
+            const unsigned cap = byte_array.capacity();
+            if (cap < (1u << MIN_SHIFT) || std::popcount(cap) != 1 || get_bucket_index(cap) >= BUCKET_CNT) {
+                this->dealloc_sys_(byte_array.data(), cap);
+                return;
+            }
+
+            const unsigned idx = get_bucket_index(cap);
+            thread_cache* cache;
+            try {
+                cache = &this->local_cache_();
+            } catch (...) {
+                // 无法建立线程缓存时直接放回仓库
+                depot& d = depots_[idx];
+                std::lock_guard lock{d.mutex};
+                try {
+                    d.items.push_back(byte_array.data());
+                } catch (...) {
+                    this->dealloc_sys_(byte_array.data(), cap);
+                    d.system_deallocations.fetch_add(1, std::memory_order_relaxed);
+                }
+                d.retired_retires.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            magazine& mag = cache->magazines[idx];
+            class_counters::bump(cache->counters[idx].retires);
+            if (mag.count == magazine_capacity(idx)) {
+                this->flush_(mag, idx, magazine_capacity(idx) / 2);
+            }
+            mag.items[mag.count++] = byte_array.data();
+        }
+
+        template <typename T = std::byte>
+        byte_buffer<T> acquire(unsigned count) {
+            auto buf = static_cast<byte_buffer<T>>(acquire_raw(count * sizeof(T)));
+            if constexpr (!IMPLICIT_LIFETIME_PRED(T)) {
+                std::ranges::uninitialized_default_construct(buf.to_span());
+            }
+            return buf;
+        }
+
+        template <typename T = std::byte>
+        void retire(byte_buffer<T> buffer) noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                buffer.destruct_();
+            }
+            this->retire_raw(buffer.as_bytes());
+        }
+
+        /**
+         * @brief 归还当前线程的弹匣，并释放仓库中超出 keep_count 的缓冲（优先释放大尺寸级别）
+         */
+        void trim(std::size_t keep_count = 0) noexcept {
+            if (auto* cache = thread_cache_registry_.find(id_)) {
+                auto& local = static_cast<thread_cache&>(*cache);
+                for (unsigned idx = 0; idx < BUCKET_CNT; ++idx) {
+                    if (local.magazines[idx].count) this->flush_(local.magazines[idx], idx, 0);
+                }
+            }
+
+            std::size_t current = this->cached_count();
+            for (unsigned idx = BUCKET_CNT; idx-- > 0 && current > keep_count;) {
+                depot& d = depots_[idx];
+                std::lock_guard lock{d.mutex};
+                while (!d.items.empty() && current > keep_count) {
+                    this->dealloc_sys_(d.items.back(), 1u << (idx + MIN_SHIFT));
+                    d.items.pop_back();
+                    d.system_deallocations.fetch_add(1, std::memory_order_relaxed);
+                    --current;
+                }
+            }
+        }
+
+        /**
+         * @brief 仓库中缓存的缓冲数，不含各线程弹匣
+         */
+        [[nodiscard]] std::size_t cached_count() const noexcept {
+            std::size_t total = 0;
+            for (const auto& d : depots_) {
+                std::lock_guard lock{d.mutex};
+                total += d.items.size();
+            }
+            return total;
+        }
+
+        [[nodiscard]] static constexpr unsigned class_count() noexcept {
+            return BUCKET_CNT;
+        }
+
+        /**
+         * @brief 已登记的线程缓存数，已退出的线程在下一个新线程登记时移除
+         */
+        [[nodiscard]] std::size_t thread_cache_count() const noexcept {
+            std::lock_guard lock{registry_mutex_};
+            return caches_.size();
+        }
+
+        [[nodiscard]] byte_pool_class_statistics class_statistics(unsigned idx) const {
+            assert(idx < BUCKET_CNT);
+            const depot& d = depots_[idx];
+            byte_pool_class_statistics stat{
+                .capacity_bytes = 1u << (idx + MIN_SHIFT),
+                .acquires = d.retired_acquires.load(std::memory_order_relaxed),
+                .retires = d.retired_retires.load(std::memory_order_relaxed),
+                .system_allocations = d.system_allocations.load(std::memory_order_relaxed),
+                .system_deallocations = d.system_deallocations.load(std::memory_order_relaxed),
+                .depot_cached = 0
+            };
+            {
+                std::lock_guard lock{d.mutex};
+                stat.depot_cached = d.items.size();
+            }
+            std::lock_guard lock{registry_mutex_};
+            for (const auto& cache : caches_) {
+                stat.acquires += cache->counters[idx].acquires.load(std::memory_order_relaxed);
+                stat.retires += cache->counters[idx].retires.load(std::memory_order_relaxed);
+            }
+            return stat;
+        }
+
+        /**
+         * @brief 全部尺寸级别的汇总，capacity_bytes 恒为 0
+         */
+        [[nodiscard]] byte_pool_class_statistics statistics() const {
+            byte_pool_class_statistics rst{};
+            for (unsigned idx = 0; idx < BUCKET_CNT; ++idx) {
+                rst += this->class_statistics(idx);
+            }
+            return rst;
+        }
+    };
+
     // --- 实现 acquire_new 并在扩容时跳过不必要的初始化 ---
 
-    template <typename T, typename Alloc>
+    template <typename T, typename Alloc, typename Pool>
     template <bool reserve_current>
-    constexpr void byte_borrow<T, Alloc>::resize(unsigned count) {
+    constexpr void byte_borrow<T, Alloc, Pool>::resize(unsigned count) {
         assert(owner_ != nullptr);
         // 1. 如果已有空间足够
         if (count <= array_.capacity()) {
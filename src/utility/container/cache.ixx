@@ -1,3 +1,10 @@
+module;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MO_YANXI_CACHE_SSE2
+#include <emmintrin.h>
+#endif
+
 export module mo_yanxi.cache;
 
 import mo_yanxi.meta_programming;
@@ -15,6 +22,227 @@ namespace mo_yanxi {
         constexpr ~slot_t() noexcept {}
     };
 
+    template <typename K>
+    concept lru_std_hashable = requires(const K& key){
+        { std::hash<K>{}(key) } -> std::convertible_to<std::size_t>;
+    };
+
+    // 可在常量求值中计算哈希的键类型，其余类型只能在运行期建立索引
+    template <typename K>
+    constexpr bool lru_constexpr_hashable = std::integral<K> || std::is_enum_v<K>;
+
+    template <typename K>
+    constexpr std::size_t lru_hash(const K& key) noexcept(lru_constexpr_hashable<K> || noexcept(std::hash<K>{}(key))) {
+        std::uint64_t x;
+        if constexpr (std::is_enum_v<K>) {
+            x = static_cast<std::uint64_t>(std::to_underlying(key));
+        } else if constexpr (std::integral<K>) {
+            x = static_cast<std::uint64_t>(key);
+        } else {
+            x = static_cast<std::uint64_t>(std::hash<K>{}(key));
+        }
+        // fmix64，std::hash 对整数通常为恒等映射
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    /**
+     * @brief 小容量索引：每个槽位一个字节的哈希标签，查找时按 16 字节一组并行比较
+     *
+     * 标签最高位恒为 1，0 表示空槽位；填充字节恒为 0，不会产生匹配。
+     */
+    template <std::size_t N, typename SizeTy>
+    struct lru_tag_index {
+        static constexpr std::size_t tag_count = (N + 15) / 16 * 16;
+        static constexpr SizeTy npos = std::numeric_limits<SizeTy>::max();
+
+        alignas(16) std::array<std::uint8_t, tag_count> tags{};
+
+        static constexpr std::uint8_t tag_of(std::size_t hash) noexcept {
+            return static_cast<std::uint8_t>((hash >> (sizeof(std::size_t) * 8 - 7)) | 0x80);
+        }
+
+        constexpr void clear() noexcept {
+            tags.fill(0);
+        }
+
+        constexpr void insert(SizeTy slot, std::size_t hash) noexcept {
+            tags[slot] = tag_of(hash);
+        }
+
+        constexpr void erase(SizeTy slot, std::size_t) noexcept {
+            tags[slot] = 0;
+        }
+
+        template <typename Eq>
+        constexpr SizeTy find(std::size_t hash, Eq eq) const {
+            const std::uint8_t tag = tag_of(hash);
+#ifdef MO_YANXI_CACHE_SSE2
+            if !consteval {
+                const __m128i pattern = _mm_set1_epi8(static_cast<char>(tag));
+                for (std::size_t base = 0; base < tag_count; base += 16) {
+                    const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i*>(tags.data() + base));
+                    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, pattern)));
+                    for (; mask; mask &= mask - 1) {
+                        const auto slot = static_cast<SizeTy>(base + std::countr_zero(mask));
+                        if (eq(slot)) return slot;
+                    }
+                }
+                return npos;
+            }
+#endif
+            for (std::size_t i = 0; i < N; ++i) {
+                if (tags[i] == tag && eq(static_cast<SizeTy>(i))) return static_cast<SizeTy>(i);
+            }
+            return npos;
+        }
+    };
+
+    /**
+     * @brief 大容量索引：存放槽位下标的线性探测表，负载因子不超过 1/2，删除采用回移
+     */
+    template <std::size_t N, typename SizeTy>
+    struct lru_hash_index {
+        static constexpr std::size_t table_size = std::bit_ceil(N * 2);
+        static constexpr std::size_t mask = table_size - 1;
+        static constexpr SizeTy npos = std::numeric_limits<SizeTy>::max();
+
+        std::array<SizeTy, table_size> table = make_empty_table();
+        std::array<std::size_t, N> hashes{};
+
+        static constexpr std::array<SizeTy, table_size> make_empty_table() noexcept {
+            std::array<SizeTy, table_size> rst{};
+            rst.fill(npos);
+            return rst;
+        }
+
+        constexpr void clear() noexcept {
+            table.fill(npos);
+        }
+
+        constexpr void insert(SizeTy slot, std::size_t hash) noexcept {
+            hashes[slot] = hash;
+            std::size_t pos = hash & mask;
+            while (table[pos] != npos) pos = (pos + 1) & mask;
+            table[pos] = slot;
+        }
+
+        constexpr void erase(SizeTy slot, std::size_t hash) noexcept {
+            std::size_t hole = hash & mask;
+            while (table[hole] != slot) hole = (hole + 1) & mask;
+
+            for (std::size_t next = (hole + 1) & mask; table[next] != npos; next = (next + 1) & mask) {
+                const std::size_t home = hashes[table[next]] & mask;
+                if (((next - hole) & mask) <= ((next - home) & mask)) {
+                    table[hole] = table[next];
+                    hole = next;
+                }
+            }
+            table[hole] = npos;
+        }
+
+        template <typename Eq>
+        constexpr SizeTy find(std::size_t hash, Eq eq) const {
+            for (std::size_t pos = hash & mask; table[pos] != npos; pos = (pos + 1) & mask) {
+                const SizeTy slot = table[pos];
+                if (hashes[slot] == hash && eq(slot)) return slot;
+            }
+            return npos;
+        }
+    };
+
+    inline constexpr std::size_t lru_scan_limit = 64;
+
+    /**
+     * @brief LRU 容器的键索引，键不可哈希时退化为链表遍历
+     *
+     * 对只能在运行期哈希的键，常量求值期间的修改会使索引失效，运行期首次修改时重建。
+     */
+    template <typename K, std::size_t N, typename SizeTy,
+        bool Enabled = lru_std_hashable<K> || lru_constexpr_hashable<K>>
+    struct lru_lookup {
+        static constexpr SizeTy npos = std::numeric_limits<SizeTy>::max();
+
+        std::conditional_t<(N <= lru_scan_limit), lru_tag_index<N, SizeTy>, lru_hash_index<N, SizeTy>> index{};
+        bool valid = true;
+
+        [[nodiscard]] constexpr bool ready() const noexcept {
+            if constexpr (lru_constexpr_hashable<K>) {
+                return true;
+            } else {
+                if consteval {
+                    return false;
+                } else {
+                    return valid;
+                }
+            }
+        }
+
+        template <typename Eq>
+        [[nodiscard]] constexpr SizeTy find(const K& key, Eq eq) const {
+            return index.find(lru_hash(key), eq);
+        }
+
+        template <typename KeyOf>
+        constexpr void insert(SizeTy slot, const K& key, const std::bitset<N>& active, KeyOf key_of) {
+            if (this->sync(active, key_of)) index.insert(slot, lru_hash(key));
+        }
+
+        template <typename KeyOf>
+        constexpr void erase(SizeTy slot, const K& key, const std::bitset<N>& active, KeyOf key_of) {
+            if (this->sync(active, key_of)) index.erase(slot, lru_hash(key));
+        }
+
+        constexpr void clear() noexcept {
+            index.clear();
+            valid = true;
+        }
+
+    private:
+        template <typename KeyOf>
+        constexpr bool sync(const std::bitset<N>& active, KeyOf key_of) {
+            if constexpr (lru_constexpr_hashable<K>) {
+                return true;
+            } else {
+                if consteval {
+                    valid = false;
+                    return false;
+                } else {
+                    if (!valid) {
+                        index.clear();
+                        for (std::size_t i = 0; i < N; ++i) {
+                            if (active.test(i)) index.insert(static_cast<SizeTy>(i), lru_hash(key_of(static_cast<SizeTy>(i))));
+                        }
+                        valid = true;
+                    }
+                    return true;
+                }
+            }
+        }
+    };
+
+    template <typename K, std::size_t N, typename SizeTy>
+    struct lru_lookup<K, N, SizeTy, false> {
+        static constexpr SizeTy npos = std::numeric_limits<SizeTy>::max();
+
+        [[nodiscard]] constexpr bool ready() const noexcept { return false; }
+
+        template <typename Eq>
+        [[nodiscard]] constexpr SizeTy find(const K&, Eq) const noexcept { return npos; }
+
+        template <typename KeyOf>
+        constexpr void insert(SizeTy, const K&, const std::bitset<N>&, KeyOf) noexcept {}
+
+        template <typename KeyOf>
+        constexpr void erase(SizeTy, const K&, const std::bitset<N>&, KeyOf) noexcept {}
+
+        constexpr void clear() noexcept {}
+    };
+
     /**
      * @brief 基于 SoA 布局与 Union 存储的 Constexpr LRU 缓存
      */
@@ -47,6 +275,8 @@ namespace mo_yanxi {
 
         std::bitset<N> active_mask_;
 
+        lru_lookup<K, N, size_type> lookup_{};
+
     public:
         constexpr lru_cache() {
             for (size_type i = 0; i < N; ++i) {
@@ -77,6 +307,7 @@ namespace mo_yanxi {
             free_head_ = other.free_head_;
             size_ = other.size_;
             links_ = other.links_;
+            lookup_ = other.lookup_;
 
             for (size_type i = 0; i < N; ++i) {
                 if (other.active_mask_.test(i)) {
@@ -88,6 +319,7 @@ namespace mo_yanxi {
             }
 
             other.active_mask_.reset();
+            other.lookup_.clear();
             other.size_ = 0;
             other.head_ = invalid_index;
             other.tail_ = invalid_index;
@@ -117,6 +349,7 @@ namespace mo_yanxi {
                 free_head_ = other.free_head_;
                 size_ = other.size_;
                 links_ = other.links_;
+                lookup_ = other.lookup_;
 
                 for (size_type i = 0; i < N; ++i) {
                     if (other.active_mask_.test(i)) {
@@ -127,6 +360,7 @@ namespace mo_yanxi {
                 }
 
                 other.active_mask_.reset();
+                other.lookup_.clear();
                 other.size_ = 0;
                 other.head_ = invalid_index;
                 other.tail_ = invalid_index;
@@ -142,6 +376,7 @@ namespace mo_yanxi {
             free_head_ = other.free_head_;
             size_ = other.size_;
             links_ = other.links_;
+            lookup_ = other.lookup_;
 
             for (size_type i = 0; i < N; ++i) {
                 if (other.active_mask_.test(i)) {
@@ -167,6 +402,7 @@ namespace mo_yanxi {
                 }
             }
             active_mask_.reset();
+            lookup_.clear();
             size_ = 0;
         }
 
@@ -204,13 +440,16 @@ namespace mo_yanxi {
             }
 
             if (is_eviction) {
+                this->lookup_.erase(target_idx, *this->get_key_ptr(target_idx), this->active_mask_, this->key_of());
                 std::destroy_at(this->get_key_ptr(target_idx));
                 std::destroy_at(this->get_val_ptr(target_idx));
+                this->active_mask_.reset(target_idx);
             }
 
             std::construct_at(this->get_raw_key_ptr(target_idx), std::move(key));
             std::construct_at(this->get_raw_val_ptr(target_idx), std::forward<Args>(args)...);
 
+            this->lookup_.insert(target_idx, *this->get_key_ptr(target_idx), this->active_mask_, this->key_of());
             this->active_mask_.set(target_idx);
             this->push_front(target_idx);
         }
@@ -243,14 +482,7 @@ namespace mo_yanxi {
         }
 
         [[nodiscard]] constexpr bool contains(const K& key) const {
-            size_type curr = this->head_;
-            while (curr != invalid_index) {
-                if (*this->get_key_ptr(curr) == key) {
-                    return true;
-                }
-                curr = this->links_[curr].next;
-            }
-            return false;
+            return this->find_index(key) != invalid_index;
         }
 
         [[nodiscard]] constexpr size_type size() const noexcept { return this->size_; }
@@ -285,7 +517,15 @@ namespace mo_yanxi {
             return std::launder(&values_storage_[idx].value);
         }
 
+        constexpr auto key_of() const noexcept {
+            return [this](size_type idx) -> const K& { return *this->get_key_ptr(idx); };
+        }
+
         constexpr size_type find_index(const K& key) const {
+            if (this->lookup_.ready()) {
+                return this->lookup_.find(key, [&, this](size_type idx) { return *this->get_key_ptr(idx) == key; });
+            }
+
             size_type curr = this->head_;
             while (curr != invalid_index) {
                 if (*this->get_key_ptr(curr) == key) {
@@ -365,6 +605,8 @@ namespace mo_yanxi {
 
         std::bitset<N> active_mask_;
 
+        lru_lookup<T, N, size_type> lookup_{};
+
     public:
         constexpr lru_set() {
             for (size_type i = 0; i < N; ++i) {
@@ -423,11 +665,14 @@ namespace mo_yanxi {
             }
 
             if (is_eviction) {
+                this->lookup_.erase(target_idx, *this->get_ptr(target_idx), this->active_mask_, this->key_of());
                 std::destroy_at(this->get_ptr(target_idx));
+                this->active_mask_.reset(target_idx);
                 // 此时不需要 deallocate，因为我们马上复用该位置
             }
 
             std::construct_at(this->get_raw_ptr(target_idx), std::move(temp_val));
+            this->lookup_.insert(target_idx, *this->get_ptr(target_idx), this->active_mask_, this->key_of());
             this->active_mask_.set(target_idx);
             this->push_front(target_idx);
         }
@@ -439,6 +684,7 @@ namespace mo_yanxi {
                 return false;
             }
 
+            this->lookup_.erase(idx, *this->get_ptr(idx), this->active_mask_, this->key_of());
             std::destroy_at(this->get_ptr(idx));
             this->active_mask_.reset(idx);
             this->remove_node(idx);
@@ -480,7 +726,15 @@ namespace mo_yanxi {
         constexpr T* get_ptr(size_type idx) { return std::launder(&storage_[idx].value); }
         constexpr const T* get_ptr(size_type idx) const { return std::launder(&storage_[idx].value); }
 
+        constexpr auto key_of() const noexcept {
+            return [this](size_type idx) -> const T& { return *this->get_ptr(idx); };
+        }
+
         constexpr size_type find_index(const T& key) const {
+            if (this->lookup_.ready()) {
+                return this->lookup_.find(key, [&, this](size_type idx) { return *this->get_ptr(idx) == key; });
+            }
+
             size_type curr = this->head_;
             while (curr != invalid_index) {
                 if (*this->get_ptr(curr) == key) return curr;
@@ -495,6 +749,7 @@ namespace mo_yanxi {
             free_head_ = other.free_head_;
             size_ = other.size_;
             links_ = other.links_;
+            lookup_ = other.lookup_;
             for (size_type i = 0; i < N; ++i) {
                 if (other.active_mask_.test(i)) {
                     std::construct_at(get_raw_ptr(i), std::move(*other.get_ptr(i)));
@@ -502,6 +757,7 @@ namespace mo_yanxi {
                 }
             }
             other.active_mask_.reset();
+            other.lookup_.clear();
             other.size_ = 0;
             other.head_ = invalid_index;
             other.tail_ = invalid_index;
@@ -515,6 +771,7 @@ namespace mo_yanxi {
                 }
             }
             active_mask_.reset();
+            lookup_.clear();
             size_ = 0;
         }
 
@@ -0,0 +1,341 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.cache.map.concurrent;
+
+export import mo_yanxi.cache.map;
+
+import std;
+
+namespace mo_yanxi{
+export
+struct lru_shard_statistics{
+	std::uint64_t hits;
+	std::uint64_t misses;
+	std::uint64_t evictions;
+	std::size_t size;
+	std::size_t capacity;
+
+	constexpr lru_shard_statistics& operator+=(const lru_shard_statistics& other) noexcept{
+		hits += other.hits;
+		misses += other.misses;
+		evictions += other.evictions;
+		size += other.size;
+		capacity += other.capacity;
+		return *this;
+	}
+
+	[[nodiscard]] constexpr double hit_rate() const noexcept{
+		const auto total = hits + misses;
+		return total == 0 ? 0. : static_cast<double>(hits) / static_cast<double>(total);
+	}
+};
+
+/**
+ * @brief 按键哈希分片的线程安全 LRU 缓存
+ *
+ * - 每个分片持有独立的互斥锁与 mapped_lru_cache，不同分片上的操作互不阻塞
+ * - 分片由混合后哈希的高位选取，分片内部的哈希表使用低位，二者互不相关
+ * - 批量接口按分片归组，每个分片只加锁一次
+ * - get_or_compute 对同一键的并发加载去重，只有一个线程执行计算，其余线程等待其结果
+ *
+ * 为保证线程安全，所有读取接口均返回值的拷贝。
+ */
+export
+template <
+	typename KeyType,
+	typename ValueType,
+	typename Hash = std::hash<KeyType>,
+	template <typename...> class MapTemplate = std::unordered_map,
+	template <typename...> class NodeTemplate = std::vector
+>
+	requires (std::copy_constructible<ValueType>)
+class sharded_lru_cache{
+public:
+	using key_type = KeyType;
+	using value_type = ValueType;
+	using hasher = Hash;
+	using size_type = std::size_t;
+
+private:
+	using cache_type = mapped_lru_cache<key_type, value_type, MapTemplate, NodeTemplate>;
+
+	struct alignas(std::hardware_destructive_interference_size) shard{
+		mutable std::mutex mutex{};
+		cache_type cache;
+		// 正在计算中的键，等待方共享同一结果
+		std::unordered_map<key_type, std::shared_future<value_type>, hasher> loading{};
+
+		std::atomic<std::uint64_t> hits{};
+		std::atomic<std::uint64_t> misses{};
+		std::atomic<std::uint64_t> evictions{};
+
+		[[nodiscard]] explicit shard(std::uint32_t capacity)
+			: cache(capacity){
+		}
+
+		std::optional<value_type> get_locked(const key_type& key){
+			if(const value_type* p = cache.get_ptr(key)){
+				hits.fetch_add(1, std::memory_order_relaxed);
+				return *p;
+			}
+			misses.fetch_add(1, std::memory_order_relaxed);
+			return std::nullopt;
+		}
+
+		void put_locked(const key_type& key, const value_type& value){
+			if(cache.size() == cache.capacity() && !cache.contains(key)){
+				evictions.fetch_add(1, std::memory_order_relaxed);
+			}
+			cache.put(key, value);
+		}
+	};
+
+	ADAPTED_NO_UNIQUE_ADDRESS hasher hasher_{};
+	std::vector<std::unique_ptr<shard>> shards_{};
+	unsigned shard_shift_{};
+
+	[[nodiscard]] size_type shard_index_of(const key_type& key) const{
+		if(shard_shift_ == std::numeric_limits<std::uint64_t>::digits) return 0;
+		auto x = static_cast<std::uint64_t>(std::invoke(hasher_, key));
+		// murmur3 fmix64，单次乘法时小整数键的高位几乎相同
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return static_cast<size_type>(x >> shard_shift_);
+	}
+
+	[[nodiscard]] shard& shard_of(const key_type& key) const{
+		return *shards_[this->shard_index_of(key)];
+	}
+
+	// 按分片归组后的处理顺序，同一分片内保持原始顺序
+	template <typename IndexOf>
+	[[nodiscard]] static std::vector<std::pair<size_type, size_type>> group_by_shard(size_type count, IndexOf index_of){
+		std::vector<std::pair<size_type, size_type>> order;
+		order.reserve(count);
+		for(size_type i = 0; i < count; ++i){
+			order.emplace_back(index_of(i), i);
+		}
+		std::ranges::stable_sort(order, {}, &std::pair<size_type, size_type>::first);
+		return order;
+	}
+
+	// 批量接口先暂存输入元素：左值保存引用，纯右值保存副本
+	template <typename Ref>
+	using stash_t = std::conditional_t<std::is_lvalue_reference_v<Ref>,
+		std::reference_wrapper<std::remove_reference_t<Ref>>, std::remove_cvref_t<Ref>>;
+
+	template <std::ranges::input_range Rng>
+	[[nodiscard]] static auto stash(const Rng& range){
+		using ref_t = std::ranges::range_reference_t<const Rng&>;
+		std::vector<stash_t<ref_t>> rst;
+		if constexpr(std::ranges::sized_range<const Rng&>){
+			rst.reserve(std::ranges::size(range));
+		}
+		for(auto&& elem : range){
+			rst.push_back(stash_t<ref_t>(std::forward<decltype(elem)>(elem)));
+		}
+		return rst;
+	}
+
+	template <typename T>
+	[[nodiscard]] static const T& unstash(const T& elem) noexcept{
+		return elem;
+	}
+
+	template <typename T>
+	[[nodiscard]] static const T& unstash(const std::reference_wrapper<T>& elem) noexcept{
+		return elem.get();
+	}
+
+public:
+	/**
+	 * @param capacity 总容量，平均分配到各分片
+	 * @param shard_count 分片数，向上取整为 2 的幂；0 时取硬件并发数的 2 倍
+	 */
+	[[nodiscard]] explicit sharded_lru_cache(std::uint32_t capacity, size_type shard_count = 0, const hasher& hash = hasher{})
+		: hasher_(hash){
+		assert(capacity > 0 && "Cache capacity must be greater than 0");
+		if(shard_count == 0){
+			shard_count = std::max<size_type>(1, std::thread::hardware_concurrency()) * 2;
+		}
+		shard_count = std::bit_ceil(std::min<size_type>(shard_count, capacity));
+		if(shard_count > capacity) shard_count >>= 1;
+
+		shard_shift_ = static_cast<unsigned>(std::numeric_limits<std::uint64_t>::digits - std::countr_zero(shard_count));
+		const auto per_shard = static_cast<std::uint32_t>((capacity + shard_count - 1) / shard_count);
+
+		shards_.reserve(shard_count);
+		for(size_type i = 0; i < shard_count; ++i){
+			shards_.push_back(std::make_unique<shard>(per_shard));
+		}
+	}
+
+	[[nodiscard]] size_type shard_count() const noexcept{
+		return shards_.size();
+	}
+
+	[[nodiscard]] size_type capacity() const noexcept{
+		const shard& s = *shards_.front();
+		std::lock_guard lock{s.mutex};
+		return shards_.size() * s.cache.capacity();
+	}
+
+	[[nodiscard]] size_type size() const noexcept{
+		size_type rst{};
+		for(const auto& s : shards_){
+			std::lock_guard lock{s->mutex};
+			rst += s->cache.size();
+		}
+		return rst;
+	}
+
+	[[nodiscard]] std::optional<value_type> get(const key_type& key){
+		shard& s = this->shard_of(key);
+		std::lock_guard lock{s.mutex};
+		return s.get_locked(key);
+	}
+
+	void put(const key_type& key, const value_type& value){
+		shard& s = this->shard_of(key);
+		std::lock_guard lock{s.mutex};
+		s.put_locked(key, value);
+	}
+
+	/**
+	 * @brief 批量查询，结果与输入键一一对应
+	 */
+	template <std::ranges::input_range Rng>
+		requires std::convertible_to<std::ranges::range_reference_t<const Rng&>, key_type>
+	[[nodiscard]] std::vector<std::optional<value_type>> get_many(const Rng& keys){
+		const auto stashed = sharded_lru_cache::stash(keys);
+		std::vector<std::optional<value_type>> rst(stashed.size());
+		const auto order = sharded_lru_cache::group_by_shard(stashed.size(), [&, this](size_type i){
+			return this->shard_index_of(sharded_lru_cache::unstash(stashed[i]));
+		});
+
+		for(auto itr = order.begin(); itr != order.end();){
+			const auto cur = itr->first;
+			shard& s = *shards_[cur];
+			std::lock_guard lock{s.mutex};
+			for(; itr != order.end() && itr->first == cur; ++itr){
+				rst[itr->second] = s.get_locked(sharded_lru_cache::unstash(stashed[itr->second]));
+			}
+		}
+		return rst;
+	}
+
+	/**
+	 * @brief 批量写入，元素需可按 std::get<0> / std::get<1> 取出键与值
+	 */
+	template <std::ranges::input_range Rng>
+		requires requires(const std::remove_cvref_t<std::ranges::range_reference_t<const Rng&>>& elem){
+			{ std::get<0>(elem) } -> std::convertible_to<key_type>;
+			{ std::get<1>(elem) } -> std::convertible_to<value_type>;
+		}
+	void put_many(const Rng& entries){
+		const auto stashed = sharded_lru_cache::stash(entries);
+		const auto order = sharded_lru_cache::group_by_shard(stashed.size(), [&, this](size_type i){
+			return this->shard_index_of(std::get<0>(sharded_lru_cache::unstash(stashed[i])));
+		});
+
+		for(auto itr = order.begin(); itr != order.end();){
+			const auto cur = itr->first;
+			shard& s = *shards_[cur];
+			std::lock_guard lock{s.mutex};
+			for(; itr != order.end() && itr->first == cur; ++itr){
+				const auto& elem = sharded_lru_cache::unstash(stashed[itr->second]);
+				s.put_locked(std::get<0>(elem), std::get<1>(elem));
+			}
+		}
+	}
+
+	/**
+	 * @brief 查询，未命中时调用 fn(key) 计算并写入
+	 *
+	 * 同一键的并发调用只会执行一次计算；计算在锁外进行，不阻塞同分片的其他键。
+	 * 计算抛出的异常会传递给所有等待该键的调用方，且结果不会写入缓存。
+	 *
+	 * @warning fn 内不得对同一键再次调用 get_or_compute，否则将永久等待自身的计算结果
+	 */
+	template <std::invocable<const key_type&> Fn>
+		requires std::convertible_to<std::invoke_result_t<Fn&, const key_type&>, value_type>
+	value_type get_or_compute(const key_type& key, Fn&& fn){
+		shard& s = this->shard_of(key);
+		std::promise<value_type> promise;
+
+		{
+			std::unique_lock lock{s.mutex};
+			if(auto cached = s.get_locked(key)){
+				return std::move(*cached);
+			}
+
+			if(auto itr = s.loading.find(key); itr != s.loading.end()){
+				auto future = itr->second;
+				lock.unlock();
+				return future.get();
+			}
+
+			s.loading.try_emplace(key, promise.get_future().share());
+		}
+
+		try{
+			value_type value = std::invoke(fn, key);
+			{
+				std::lock_guard lock{s.mutex};
+				s.put_locked(key, value);
+				s.loading.erase(key);
+			}
+			promise.set_value(value);
+			return value;
+		} catch(...){
+			{
+				std::lock_guard lock{s.mutex};
+				s.loading.erase(key);
+			}
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+	}
+
+	void clear(){
+		for(auto& s : shards_){
+			std::lock_guard lock{s->mutex};
+			s->cache = cache_type{static_cast<std::uint32_t>(s->cache.capacity())};
+		}
+	}
+
+	[[nodiscard]] lru_shard_statistics shard_statistics(size_type index) const{
+		const shard& s = *shards_[index];
+		std::lock_guard lock{s.mutex};
+		return {
+			s.hits.load(std::memory_order_relaxed),
+			s.misses.load(std::memory_order_relaxed),
+			s.evictions.load(std::memory_order_relaxed),
+			s.cache.size(),
+			s.cache.capacity()
+		};
+	}
+
+	[[nodiscard]] lru_shard_statistics statistics() const{
+		lru_shard_statistics rst{};
+		for(size_type i = 0; i < shards_.size(); ++i){
+			rst += this->shard_statistics(i);
+		}
+		return rst;
+	}
+
+	void reset_statistics() noexcept{
+		for(auto& s : shards_){
+			s->hits.store(0, std::memory_order_relaxed);
+			s->misses.store(0, std::memory_order_relaxed);
+			s->evictions.store(0, std::memory_order_relaxed);
+		}
+	}
+};
+}
@@ -0,0 +1,825 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#if defined(__AVX2__)
+#define MO_YANXI_FLAT_HASH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MO_YANXI_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#endif
+
+export module mo_yanxi.flat_hash_map;
+
+import std;
+
+namespace mo_yanxi{
+namespace flat_hash_detail{
+	/**
+	 * @brief 控制字节：最高位为 1 表示空槽，否则低 7 位保存哈希的 H2 标签
+	 *
+	 * 删除使用回移（backward shift），表中不存在墓碑状态。
+	 */
+	using ctrl_t = std::int8_t;
+	inline constexpr ctrl_t ctrl_empty = std::numeric_limits<ctrl_t>::min();
+
+	template <typename T>
+	concept transparent_functor = requires{
+		typename T::is_transparent;
+	};
+
+	template <typename MaskTy, unsigned Shift>
+	struct bit_mask{
+		MaskTy mask;
+
+		FORCE_INLINE constexpr explicit operator bool() const noexcept{
+			return mask != 0;
+		}
+
+		FORCE_INLINE constexpr unsigned lowest() const noexcept{
+			return static_cast<unsigned>(std::countr_zero(mask)) >> Shift;
+		}
+
+		FORCE_INLINE constexpr void pop() noexcept{
+			mask &= mask - 1;
+		}
+	};
+
+#if defined(MO_YANXI_FLAT_HASH_AVX2)
+	struct group{
+		static constexpr std::size_t width = 32;
+		__m256i ctrl;
+
+		FORCE_INLINE explicit group(const ctrl_t* pos) noexcept
+			: ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))){
+		}
+
+		FORCE_INLINE bit_mask<std::uint32_t, 0> match(ctrl_t tag) const noexcept{
+			return {static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(tag), ctrl)))};
+		}
+
+		FORCE_INLINE bit_mask<std::uint32_t, 0> match_empty() const noexcept{
+			return {static_cast<std::uint32_t>(_mm256_movemask_epi8(ctrl))};
+		}
+	};
+#elif defined(MO_YANXI_FLAT_HASH_SSE2)
+	struct group{
+		static constexpr std::size_t width = 16;
+		__m128i ctrl;
+
+		FORCE_INLINE explicit group(const ctrl_t* pos) noexcept
+			: ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))){
+		}
+
+		FORCE_INLINE bit_mask<std::uint32_t, 0> match(ctrl_t tag) const noexcept{
+			return {static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), ctrl)))};
+		}
+
+		FORCE_INLINE bit_mask<std::uint32_t, 0> match_empty() const noexcept{
+			return {static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl))};
+		}
+	};
+#else
+	// SWAR 回退：8 字节一组，匹配位位于每字节最高位
+	struct group{
+		static constexpr std::size_t width = 8;
+		static constexpr std::uint64_t lsbs = 0x0101010101010101ULL;
+		static constexpr std::uint64_t msbs = 0x8080808080808080ULL;
+		std::uint64_t ctrl;
+
+		FORCE_INLINE explicit group(const ctrl_t* pos) noexcept{
+			std::memcpy(&ctrl, pos, sizeof(ctrl));
+			if constexpr(std::endian::native == std::endian::big){
+				ctrl = std::byteswap(ctrl);
+			}
+		}
+
+		// 可能有假阳性（仅出现在满槽上），调用方总会再比较键
+		FORCE_INLINE bit_mask<std::uint64_t, 3> match(ctrl_t tag) const noexcept{
+			const std::uint64_t x = ctrl ^ (lsbs * static_cast<std::uint8_t>(tag));
+			return {(x - lsbs) & ~x & msbs};
+		}
+
+		FORCE_INLINE bit_mask<std::uint64_t, 3> match_empty() const noexcept{
+			return {ctrl & msbs};
+		}
+	};
+#endif
+
+	// std::hash 对整数通常是恒等映射，拆分 H1/H2 前需要充分混合
+	FORCE_INLINE constexpr std::size_t mix(std::size_t value) noexcept{
+		auto x = static_cast<std::uint64_t>(value);
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return static_cast<std::size_t>(x);
+	}
+
+	template <typename T>
+	struct arrow_proxy{
+		T value;
+
+		constexpr const T* operator->() const noexcept{
+			return std::addressof(value);
+		}
+	};
+}
+
+/**
+ * @brief 基于 SIMD 控制字节探测的开放寻址哈希表
+ *
+ * - 控制字节、键、值分三段连续存储（SoA），探测只触及控制字节与键
+ * - 线性探测，每次以一组（SSE2 16 / AVX2 32 / SWAR 8）控制字节比较标签
+ * - 删除采用回移，不产生墓碑，长期增删不会退化
+ * - 哈希器与比较器均声明 is_transparent 时支持异构查找
+ *
+ * @warning 插入、扩容与删除都会移动元素，引用与迭代器均不稳定。
+ */
+export
+template <
+	typename Key, typename Val,
+	typename Hash = std::hash<Key>,
+	typename KeyEqual = std::equal_to<Key>,
+	typename Allocator = std::allocator<std::pair<const Key, Val>>>
+class flat_hash_map{
+	static_assert(std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Val>,
+		"flat_hash_map relocates elements on rehash and erase");
+
+public:
+	using key_type = Key;
+	using mapped_type = Val;
+	using value_type = std::pair<const key_type, mapped_type>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = Allocator;
+	using reference = std::pair<const key_type&, mapped_type&>;
+	using const_reference = std::pair<const key_type&, const mapped_type&>;
+
+	static constexpr size_type group_width = flat_hash_detail::group::width;
+
+	// 线性探测下未命中的期望探测长度约为 (1 + 1 / (1 - a)^2) / 2，0.8 时约 13 个槽位，即一到两次组比较
+	static constexpr size_type max_load_num = 4;
+	static constexpr size_type max_load_den = 5;
+
+private:
+	using ctrl_t = flat_hash_detail::ctrl_t;
+	using group = flat_hash_detail::group;
+	static constexpr ctrl_t ctrl_empty = flat_hash_detail::ctrl_empty;
+
+	using alloc_traits = std::allocator_traits<allocator_type>;
+	using ctrl_allocator = typename alloc_traits::template rebind_alloc<ctrl_t>;
+	using key_allocator = typename alloc_traits::template rebind_alloc<key_type>;
+	using mapped_allocator = typename alloc_traits::template rebind_alloc<mapped_type>;
+	using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+	using key_traits = std::allocator_traits<key_allocator>;
+	using mapped_traits = std::allocator_traits<mapped_allocator>;
+
+	static_assert(std::is_pointer_v<typename ctrl_traits::pointer> && std::is_pointer_v<typename key_traits::pointer> &&
+		std::is_pointer_v<typename mapped_traits::pointer>, "flat_hash_map requires allocators with raw pointers");
+
+	template <typename K>
+	static constexpr bool is_lookup_key =
+		std::same_as<std::remove_cvref_t<K>, key_type> ||
+		(flat_hash_detail::transparent_functor<hasher> && flat_hash_detail::transparent_functor<key_equal> &&
+			std::is_invocable_r_v<std::size_t, const hasher&, const K&> &&
+			std::is_invocable_r_v<bool, const key_equal&, const key_type&, const K&>);
+
+	template <bool Const>
+	struct iterator_base{
+		using owner_type = std::conditional_t<Const, const flat_hash_map, flat_hash_map>;
+		using value_type = flat_hash_map::value_type;
+		using reference = std::conditional_t<Const, flat_hash_map::const_reference, flat_hash_map::reference>;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+		using iterator_concept = std::forward_iterator_tag;
+
+		[[nodiscard]] iterator_base() = default;
+
+		[[nodiscard]] iterator_base(owner_type* owner, size_type index) noexcept
+			: owner_(owner), index_(index){
+		}
+
+		[[nodiscard]] explicit(false) iterator_base(const iterator_base<false>& other) noexcept requires(Const)
+			: owner_(other.owner_), index_(other.index_){
+		}
+
+		reference operator*() const noexcept{
+			return reference{owner_->keys_[index_], owner_->values_[index_]};
+		}
+
+		flat_hash_detail::arrow_proxy<reference> operator->() const noexcept{
+			return {**this};
+		}
+
+		iterator_base& operator++() noexcept{
+			++index_;
+			skip_empty_();
+			return *this;
+		}
+
+		iterator_base operator++(int) noexcept{
+			auto itr = *this;
+			++*this;
+			return itr;
+		}
+
+		friend bool operator==(const iterator_base& lhs, const iterator_base& rhs) noexcept{
+			return lhs.index_ == rhs.index_;
+		}
+
+	private:
+		friend flat_hash_map;
+		template <bool>
+		friend struct iterator_base;
+
+		owner_type* owner_{};
+		size_type index_{};
+
+		void skip_empty_() noexcept{
+			while(index_ < owner_->capacity_ && owner_->ctrl_[index_] == ctrl_empty){
+				++index_;
+			}
+		}
+	};
+
+public:
+	using iterator = iterator_base<false>;
+	using const_iterator = iterator_base<true>;
+
+	[[nodiscard]] flat_hash_map() = default;
+
+	[[nodiscard]] explicit flat_hash_map(
+		size_type bucket_count,
+		const hasher& hash = hasher{},
+		const key_equal& equal = key_equal{},
+		const allocator_type& alloc = allocator_type{})
+		: hasher_(hash), equal_(equal), allocator_(alloc){
+		this->reserve(bucket_count);
+	}
+
+	[[nodiscard]] explicit flat_hash_map(const allocator_type& alloc)
+		: allocator_(alloc){
+	}
+
+	[[nodiscard]] flat_hash_map(std::initializer_list<value_type> list)
+		: flat_hash_map(list.size()){
+		for(const auto& [k, v] : list){
+			this->try_emplace(k, v);
+		}
+	}
+
+	flat_hash_map(const flat_hash_map& other)
+		: hasher_(other.hasher_), equal_(other.equal_),
+		  allocator_(alloc_traits::select_on_container_copy_construction(other.allocator_)){
+		this->copy_from_(other);
+	}
+
+	flat_hash_map(flat_hash_map&& other) noexcept
+		: hasher_(std::move(other.hasher_)), equal_(std::move(other.equal_)), allocator_(std::move(other.allocator_)),
+		  ctrl_(std::exchange(other.ctrl_, nullptr)),
+		  keys_(std::exchange(other.keys_, nullptr)),
+		  values_(std::exchange(other.values_, nullptr)),
+		  capacity_(std::exchange(other.capacity_, 0)),
+		  size_(std::exchange(other.size_, 0)),
+		  growth_left_(std::exchange(other.growth_left_, 0)){
+	}
+
+	flat_hash_map& operator=(const flat_hash_map& other){
+		if(this == &other) return *this;
+		flat_hash_map temp{other};
+		this->swap(temp);
+		return *this;
+	}
+
+	flat_hash_map& operator=(flat_hash_map&& other) noexcept{
+		if(this == &other) return *this;
+		this->release_();
+		hasher_ = std::move(other.hasher_);
+		equal_ = std::move(other.equal_);
+		if constexpr(alloc_traits::propagate_on_container_move_assignment::value){
+			allocator_ = std::move(other.allocator_);
+		}
+		ctrl_ = std::exchange(other.ctrl_, nullptr);
+		keys_ = std::exchange(other.keys_, nullptr);
+		values_ = std::exchange(other.values_, nullptr);
+		capacity_ = std::exchange(other.capacity_, 0);
+		size_ = std::exchange(other.size_, 0);
+		growth_left_ = std::exchange(other.growth_left_, 0);
+		return *this;
+	}
+
+	~flat_hash_map(){
+		this->release_();
+	}
+
+	void swap(flat_hash_map& other) noexcept{
+		std::ranges::swap(hasher_, other.hasher_);
+		std::ranges::swap(equal_, other.equal_);
+		if constexpr(alloc_traits::propagate_on_container_swap::value){
+			std::ranges::swap(allocator_, other.allocator_);
+		}
+		std::ranges::swap(ctrl_, other.ctrl_);
+		std::ranges::swap(keys_, other.keys_);
+		std::ranges::swap(values_, other.values_);
+		std::ranges::swap(capacity_, other.capacity_);
+		std::ranges::swap(size_, other.size_);
+		std::ranges::swap(growth_left_, other.growth_left_);
+	}
+
+	friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept{
+		lhs.swap(rhs);
+	}
+
+	// --- Iterators ---
+
+	[[nodiscard]] iterator begin() noexcept{
+		iterator itr{this, 0};
+		if(capacity_) itr.skip_empty_();
+		return itr;
+	}
+
+	[[nodiscard]] const_iterator begin() const noexcept{
+		const_iterator itr{this, 0};
+		if(capacity_) itr.skip_empty_();
+		return itr;
+	}
+
+	[[nodiscard]] iterator end() noexcept{ return iterator{this, capacity_}; }
+	[[nodiscard]] const_iterator end() const noexcept{ return const_iterator{this, capacity_}; }
+	[[nodiscard]] const_iterator cbegin() const noexcept{ return this->begin(); }
+	[[nodiscard]] const_iterator cend() const noexcept{ return this->end(); }
+
+	// --- Capacity ---
+
+	[[nodiscard]] bool empty() const noexcept{ return size_ == 0; }
+	[[nodiscard]] size_type size() const noexcept{ return size_; }
+	[[nodiscard]] size_type capacity() const noexcept{ return capacity_; }
+	[[nodiscard]] size_type bucket_count() const noexcept{ return capacity_; }
+
+	[[nodiscard]] size_type max_size() const noexcept{
+		return std::min(key_traits::max_size(key_allocator{allocator_}), mapped_traits::max_size(mapped_allocator{allocator_})) / 2;
+	}
+
+	[[nodiscard]] float load_factor() const noexcept{
+		return capacity_ == 0 ? 0.f : static_cast<float>(size_) / static_cast<float>(capacity_);
+	}
+
+	[[nodiscard]] static constexpr float max_load_factor() noexcept{
+		return static_cast<float>(max_load_num) / static_cast<float>(max_load_den);
+	}
+
+	[[nodiscard]] hasher hash_function() const{ return hasher_; }
+	[[nodiscard]] key_equal key_eq() const{ return equal_; }
+	[[nodiscard]] allocator_type get_allocator() const noexcept{ return allocator_; }
+
+	// --- Modifiers ---
+
+	void clear() noexcept{
+		if(size_ == 0) return;
+		this->destroy_all_();
+		std::ranges::fill_n(ctrl_, capacity_ + group_width, ctrl_empty);
+		size_ = 0;
+		growth_left_ = growth_limit_(capacity_);
+	}
+
+	/**
+	 * @brief 预留至少可容纳 count 个元素而无需扩容的空间
+	 */
+	void reserve(size_type count){
+		if(count <= size_ + growth_left_) return;
+		this->rehash_(capacity_for_(count));
+	}
+
+	void rehash(size_type count){
+		const auto target = std::max(capacity_for_(size_), count == 0 ? 0 : normalize_capacity_(count));
+		if(target == 0){
+			this->release_();
+			return;
+		}
+		if(target != capacity_) this->rehash_(target);
+	}
+
+	template <typename K, typename... Args>
+		requires (is_lookup_key<K> && std::constructible_from<key_type, K&&> && std::constructible_from<mapped_type, Args&&...>)
+	std::pair<iterator, bool> try_emplace(K&& key, Args&&... args){
+		return this->try_emplace_impl_(std::forward<K>(key), std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+		requires (std::constructible_from<mapped_type, Args&&...>)
+	std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args){
+		return this->try_emplace_impl_(std::move(key), std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+		requires (std::constructible_from<mapped_type, Args&&...>)
+	std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args){
+		return this->try_emplace_impl_(key, std::forward<Args>(args)...);
+	}
+
+	template <typename K, typename... Args>
+		requires (std::constructible_from<key_type, K&&> && std::constructible_from<mapped_type, Args&&...>)
+	std::pair<iterator, bool> emplace(K&& key, Args&&... args){
+		if constexpr(is_lookup_key<K>){
+			return this->try_emplace_impl_(std::forward<K>(key), std::forward<Args>(args)...);
+		} else{
+			return this->try_emplace_impl_(key_type(std::forward<K>(key)), std::forward<Args>(args)...);
+		}
+	}
+
+	std::pair<iterator, bool> insert(const value_type& value){
+		return this->try_emplace_impl_(value.first, value.second);
+	}
+
+	std::pair<iterator, bool> insert(value_type&& value){
+		return this->try_emplace_impl_(value.first, std::move(value.second));
+	}
+
+	template <typename K, typename M>
+		requires (std::constructible_from<key_type, K&&> && std::assignable_from<mapped_type&, M&&>)
+	std::pair<iterator, bool> insert_or_assign(K&& key, M&& value){
+		if constexpr(is_lookup_key<K>){
+			auto rst = this->try_emplace_impl_(std::forward<K>(key), std::forward<M>(value));
+			if(!rst.second) values_[rst.first.index_] = std::forward<M>(value);
+			return rst;
+		} else{
+			return this->insert_or_assign(key_type(std::forward<K>(key)), std::forward<M>(value));
+		}
+	}
+
+	template <typename K>
+		requires (std::constructible_from<key_type, K&&> && std::default_initializable<mapped_type>)
+	mapped_type& operator[](K&& key){
+		if constexpr(is_lookup_key<K>){
+			return values_[this->try_emplace_impl_(std::forward<K>(key)).first.index_];
+		} else{
+			return values_[this->try_emplace_impl_(key_type(std::forward<K>(key))).first.index_];
+		}
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	size_type erase(const K& key){
+		const auto idx = this->find_index_(key);
+		if(idx == capacity_) return 0;
+		this->erase_at_(idx);
+		return 1;
+	}
+
+	/**
+	 * @brief 删除迭代器所指元素
+	 *
+	 * 回移可能把后续元素移入当前槽位，因此不返回后继迭代器；批量删除请使用 erase_if。
+	 */
+	void erase(const_iterator pos){
+		assert(pos.owner_ == this && pos.index_ < capacity_ && ctrl_[pos.index_] != ctrl_empty);
+		this->erase_at_(pos.index_);
+	}
+
+	template <std::predicate<const key_type&, mapped_type&> Pred>
+	size_type erase_if(Pred pred){
+		const size_type old_size = size_;
+		for(size_type i = 0; i < capacity_;){
+			if(ctrl_[i] != ctrl_empty && std::invoke(pred, std::as_const(keys_[i]), values_[i])){
+				// 回移后当前槽位可能被新元素占据，需要原地复查
+				this->erase_at_(i);
+			} else{
+				++i;
+			}
+		}
+		return old_size - size_;
+	}
+
+	// --- Lookup ---
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] iterator find(const K& key){
+		return iterator{this, this->find_index_(key)};
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] const_iterator find(const K& key) const{
+		return const_iterator{this, this->find_index_(key)};
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] bool contains(const K& key) const{
+		return this->find_index_(key) != capacity_;
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] size_type count(const K& key) const{
+		return this->contains(key);
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] mapped_type* try_find(const K& key){
+		const auto idx = this->find_index_(key);
+		return idx == capacity_ ? nullptr : values_ + idx;
+	}
+
+	template <typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] const mapped_type* try_find(const K& key) const{
+		const auto idx = this->find_index_(key);
+		return idx == capacity_ ? nullptr : values_ + idx;
+	}
+
+	template <typename S, typename K>
+		requires (is_lookup_key<K>)
+	[[nodiscard]] auto&& at(this S&& self, const K& key){
+		if(auto* p = self.try_find(key)){
+			return std::forward_like<S>(*p);
+		}
+		throw std::out_of_range("flat_hash_map::at");
+	}
+
+private:
+	ADAPTED_NO_UNIQUE_ADDRESS hasher hasher_{};
+	ADAPTED_NO_UNIQUE_ADDRESS key_equal equal_{};
+	ADAPTED_NO_UNIQUE_ADDRESS allocator_type allocator_{};
+
+	// ctrl_ 的长度为 capacity_ + group_width，尾部镜像前 group_width 个字节，使跨越末尾的组加载无需回绕
+	ctrl_t* ctrl_{};
+	key_type* keys_{};
+	mapped_type* values_{};
+	size_type capacity_{};
+	size_type size_{};
+	size_type growth_left_{};
+
+	FORCE_INLINE static constexpr size_type h1(std::size_t hash) noexcept{
+		return hash >> 7;
+	}
+
+	FORCE_INLINE static constexpr ctrl_t h2(std::size_t hash) noexcept{
+		return static_cast<ctrl_t>(hash & 0x7F);
+	}
+
+	static constexpr size_type growth_limit_(size_type capacity) noexcept{
+		return capacity / max_load_den * max_load_num + capacity % max_load_den * max_load_num / max_load_den;
+	}
+
+	static constexpr size_type normalize_capacity_(size_type count) noexcept{
+		return std::max(group_width, std::bit_ceil(count));
+	}
+
+	static constexpr size_type capacity_for_(size_type count) noexcept{
+		if(count == 0) return 0;
+		// count <= capacity * num / den  =>  capacity >= count * den / num
+		return normalize_capacity_((count * max_load_den + max_load_num - 1) / max_load_num);
+	}
+
+	template <typename K>
+	FORCE_INLINE std::size_t hash_of_(const K& key) const{
+		return flat_hash_detail::mix(static_cast<std::size_t>(std::invoke(hasher_, key)));
+	}
+
+	FORCE_INLINE void set_ctrl_(size_type idx, ctrl_t value) noexcept{
+		ctrl_[idx] = value;
+		if(idx < group_width) ctrl_[capacity_ + idx] = value;
+	}
+
+	template <typename K>
+	FORCE_INLINE size_type find_index_(const K& key) const{
+		if(size_ == 0) return capacity_;
+		return this->find_index_hashed_(key, this->hash_of_(key));
+	}
+
+	template <typename K>
+	size_type find_index_hashed_(const K& key, std::size_t hash) const{
+		const size_type mask = capacity_ - 1;
+		const ctrl_t tag = h2(hash);
+		size_type pos = h1(hash) & mask;
+
+		while(true){
+			const group g{ctrl_ + pos};
+			for(auto m = g.match(tag); m; m.pop()){
+				const size_type idx = (pos + m.lowest()) & mask;
+				if(std::invoke(equal_, keys_[idx], key)) [[likely]] {
+					return idx;
+				}
+			}
+			if(g.match_empty()) [[likely]] {
+				return capacity_;
+			}
+			pos = (pos + group_width) & mask;
+		}
+	}
+
+	FORCE_INLINE size_type find_insert_slot_(std::size_t hash) const noexcept{
+		const size_type mask = capacity_ - 1;
+		size_type pos = h1(hash) & mask;
+
+		while(true){
+			const group g{ctrl_ + pos};
+			if(auto m = g.match_empty()) [[likely]] {
+				return (pos + m.lowest()) & mask;
+			}
+			pos = (pos + group_width) & mask;
+		}
+	}
+
+	template <typename K, typename... Args>
+	std::pair<iterator, bool> try_emplace_impl_(K&& key, Args&&... args){
+		std::size_t hash = this->hash_of_(key);
+		if(size_ != 0){
+			if(const auto idx = this->find_index_hashed_(key, hash); idx != capacity_){
+				return {iterator{this, idx}, false};
+			}
+		}
+
+		if(growth_left_ == 0) [[unlikely]] {
+			this->rehash_(capacity_ == 0 ? group_width : capacity_ * 2);
+		}
+
+		const size_type idx = this->find_insert_slot_(hash);
+		key_allocator key_alloc{allocator_};
+		key_traits::construct(key_alloc, keys_ + idx, std::forward<K>(key));
+		try{
+			mapped_allocator mapped_alloc{allocator_};
+			mapped_traits::construct(mapped_alloc, values_ + idx, std::forward<Args>(args)...);
+		} catch(...){
+			key_traits::destroy(key_alloc, keys_ + idx);
+			throw;
+		}
+
+		this->set_ctrl_(idx, h2(hash));
+		++size_;
+		--growth_left_;
+		return {iterator{this, idx}, true};
+	}
+
+	FORCE_INLINE void relocate_(key_type* dst_key, mapped_type* dst_value, size_type src) noexcept{
+		key_allocator key_alloc{allocator_};
+		mapped_allocator mapped_alloc{allocator_};
+		key_traits::construct(key_alloc, dst_key, std::move(keys_[src]));
+		mapped_traits::construct(mapped_alloc, dst_value, std::move(values_[src]));
+		key_traits::destroy(key_alloc, keys_ + src);
+		mapped_traits::destroy(mapped_alloc, values_ + src);
+	}
+
+	void erase_at_(size_type idx){
+		const size_type mask = capacity_ - 1;
+		{
+			key_allocator key_alloc{allocator_};
+			mapped_allocator mapped_alloc{allocator_};
+			key_traits::destroy(key_alloc, keys_ + idx);
+			mapped_traits::destroy(mapped_alloc, values_ + idx);
+		}
+
+		// 回移：若空洞落在后继元素的 [home, next) 循环区间内，则把它前移填补空洞
+		size_type hole = idx;
+		for(size_type next = (hole + 1) & mask; ctrl_[next] != ctrl_empty; next = (next + 1) & mask){
+			const size_type home = h1(this->hash_of_(keys_[next])) & mask;
+			if(((next - hole) & mask) <= ((next - home) & mask)){
+				this->relocate_(keys_ + hole, values_ + hole, next);
+				this->set_ctrl_(hole, ctrl_[next]);
+				hole = next;
+			}
+		}
+
+		this->set_ctrl_(hole, ctrl_empty);
+		--size_;
+		++growth_left_;
+	}
+
+	void rehash_(size_type new_capacity){
+		assert(std::has_single_bit(new_capacity) && new_capacity >= group_width);
+		assert(growth_limit_(new_capacity) >= size_);
+
+		ctrl_allocator ctrl_alloc{allocator_};
+		key_allocator key_alloc{allocator_};
+		mapped_allocator mapped_alloc{allocator_};
+
+		ctrl_t* const new_ctrl = ctrl_traits::allocate(ctrl_alloc, new_capacity + group_width);
+		key_type* new_keys;
+		mapped_type* new_values;
+		try{
+			new_keys = key_traits::allocate(key_alloc, new_capacity);
+			try{
+				new_values = mapped_traits::allocate(mapped_alloc, new_capacity);
+			} catch(...){
+				key_traits::deallocate(key_alloc, new_keys, new_capacity);
+				throw;
+			}
+		} catch(...){
+			ctrl_traits::deallocate(ctrl_alloc, new_ctrl, new_capacity + group_width);
+			throw;
+		}
+		std::ranges::fill_n(new_ctrl, new_capacity + group_width, ctrl_empty);
+
+		flat_hash_map next{allocator_};
+		next.hasher_ = hasher_;
+		next.equal_ = equal_;
+		next.ctrl_ = new_ctrl;
+		next.keys_ = new_keys;
+		next.values_ = new_values;
+		next.capacity_ = new_capacity;
+		next.growth_left_ = growth_limit_(new_capacity);
+
+		for(size_type i = 0; i < capacity_; ++i){
+			if(ctrl_[i] == ctrl_empty) continue;
+			const std::size_t hash = this->hash_of_(keys_[i]);
+			const size_type slot = next.find_insert_slot_(hash);
+			this->relocate_(next.keys_ + slot, next.values_ + slot, i);
+			next.set_ctrl_(slot, h2(hash));
+		}
+
+		next.size_ = size_;
+		next.growth_left_ -= size_;
+		// 旧数组中的元素已全部迁出，只需释放存储
+		this->deallocate_();
+		this->swap(next);
+	}
+
+	void copy_from_(const flat_hash_map& other){
+		if(other.capacity_ == 0) return;
+
+		ctrl_allocator ctrl_alloc{allocator_};
+		key_allocator key_alloc{allocator_};
+		mapped_allocator mapped_alloc{allocator_};
+
+		ctrl_ = ctrl_traits::allocate(ctrl_alloc, other.capacity_ + group_width);
+		keys_ = key_traits::allocate(key_alloc, other.capacity_);
+		values_ = mapped_traits::allocate(mapped_alloc, other.capacity_);
+		capacity_ = other.capacity_;
+		std::ranges::fill_n(ctrl_, capacity_ + group_width, ctrl_empty);
+		growth_left_ = growth_limit_(capacity_);
+
+		// 容量与哈希相同，槽位布局可原样复制，无需重新探测
+		try{
+			for(size_type i = 0; i < capacity_; ++i){
+				if(other.ctrl_[i] == ctrl_empty) continue;
+				key_traits::construct(key_alloc, keys_ + i, other.keys_[i]);
+				try{
+					mapped_traits::construct(mapped_alloc, values_ + i, other.values_[i]);
+				} catch(...){
+					key_traits::destroy(key_alloc, keys_ + i);
+					throw;
+				}
+				this->set_ctrl_(i, other.ctrl_[i]);
+				++size_;
+				--growth_left_;
+			}
+		} catch(...){
+			this->release_();
+			throw;
+		}
+	}
+
+	void destroy_all_() noexcept{
+		if constexpr(!std::is_trivially_destructible_v<key_type> || !std::is_trivially_destructible_v<mapped_type>){
+			key_allocator key_alloc{allocator_};
+			mapped_allocator mapped_alloc{allocator_};
+			for(size_type i = 0; i < capacity_; ++i){
+				if(ctrl_[i] == ctrl_empty) continue;
+				key_traits::destroy(key_alloc, keys_ + i);
+				mapped_traits::destroy(mapped_alloc, values_ + i);
+			}
+		}
+	}
+
+	void release_() noexcept{
+		if(capacity_ == 0) return;
+		this->destroy_all_();
+		this->deallocate_();
+	}
+
+	void deallocate_() noexcept{
+		if(capacity_ == 0) return;
+
+		ctrl_allocator ctrl_alloc{allocator_};
+		key_allocator key_alloc{allocator_};
+		mapped_allocator mapped_alloc{allocator_};
+		ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + group_width);
+		key_traits::deallocate(key_alloc, keys_, capacity_);
+		mapped_traits::deallocate(mapped_alloc, values_, capacity_);
+
+		ctrl_ = nullptr;
+		keys_ = nullptr;
+		values_ = nullptr;
+		capacity_ = 0;
+		size_ = 0;
+		growth_left_ = 0;
+	}
+};
+
+export
+template <typename Key, typename Val, typename Hash, typename KeyEqual, typename Allocator, typename Pred>
+typename flat_hash_map<Key, Val, Hash, KeyEqual, Allocator>::size_type erase_if(flat_hash_map<Key, Val, Hash, KeyEqual, Allocator>& map, Pred pred){
+	return map.erase_if([&](const Key& key, Val& value){
+		return std::invoke(pred, std::pair<const Key&, Val&>{key, value});
+	});
+}
+}
@@ -5,6 +5,7 @@ module;
 export module mo_yanxi.heterogeneous.open_addr_hash;
 
 export import mo_yanxi.heterogeneous;
+export import mo_yanxi.flat_hash_map;
 
 import std;
 
@@ -53,9 +54,17 @@ namespace mo_yanxi{
 
 	export
 	template <typename T>
-	using type_fixed_hash_map = type_unordered_map<T>;
+	using type_fixed_hash_map = flat_hash_map<
+			std::type_index,
+			T,
+			type_index_hasher,
+			type_index_equal_to__not_null>;
 
 	export
 	template <typename V>
-	using string_open_addr_hash_map = string_hash_map<V>;
+	using string_open_addr_hash_map = flat_hash_map<
+			std::string,
+			V,
+			transparent::string_hasher,
+			transparent::string_equal_to>;
 }
@@ -83,6 +83,15 @@ public:
 		return capacity_;
 	}
 
+	std::size_t size() const noexcept{
+		return map_.size();
+	}
+
+	// 仅查询存在性，不改变最近使用顺序
+	[[nodiscard]] bool contains(const key_type& key) const noexcept{
+		return map_.find(key) != map_.end();
+	}
+
     [[nodiscard]] std::optional<value_type> get(const key_type& key) noexcept {
         auto it = map_.find(key);
         if (it == map_.end()) {
@@ -0,0 +1,188 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MO_YANXI_MAPPED_ALLOCATOR_MMAP 1
+#else
+#define MO_YANXI_MAPPED_ALLOCATOR_MMAP 0
+#endif
+
+export module mo_yanxi.mapped_allocator;
+
+import std;
+
+namespace mo_yanxi{
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+std::size_t system_page_size() noexcept{
+	static const std::size_t size = []() -> std::size_t{
+		const long rst = ::sysconf(_SC_PAGESIZE);
+		return rst > 0 ? static_cast<std::size_t>(rst) : 4096;
+	}();
+	return size;
+}
+#endif
+
+/**
+ * @brief 大块内存直接向系统映射的分配器，扩容时优先原地增长，其次 mremap 搬移页表
+ *
+ * - 不小于 MapThreshold 字节的请求使用匿名 mmap，较小的请求退化为 std::allocator
+ * - 实现 raw_buffer 的 expand_in_place / reallocate 扩展，扩容无需复制元素
+ * - HugePages 时对足够大的映射调用 madvise(MADV_HUGEPAGE)，映射长度按 2MB 取整
+ *
+ * 仅 Linux 使用 mmap 后端，其他平台全部退化为 std::allocator，reallocate 退化为复制。
+ */
+export
+template <typename T, std::size_t MapThreshold = 1024 * 1024, bool HugePages = true>
+class mapped_allocator{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::true_type;
+
+	static constexpr std::size_t map_threshold = MapThreshold;
+	static constexpr bool huge_pages = HugePages;
+
+	template <typename U>
+	struct rebind{
+		using other = mapped_allocator<U, MapThreshold, HugePages>;
+	};
+
+private:
+	static_assert(alignof(T) <= 4096, "mapped_allocator only guarantees page alignment");
+
+	[[nodiscard]] FORCE_INLINE static constexpr bool is_mapped_(size_type count) noexcept{
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+		return count * sizeof(T) >= MapThreshold;
+#else
+		(void)count;
+		return false;
+#endif
+	}
+
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+	[[nodiscard]] static size_type mapping_length_(size_type count) noexcept{
+		const size_type bytes = count * sizeof(T);
+		const size_type granularity = HugePages && bytes >= huge_page_size ? huge_page_size : system_page_size();
+		return (bytes + granularity - 1) / granularity * granularity;
+	}
+
+	static void advise_(void* p, size_type length) noexcept{
+		if constexpr(HugePages){
+			// 透明大页不可用时忽略失败
+			if(length >= huge_page_size) (void)::madvise(p, length, MADV_HUGEPAGE);
+		}
+	}
+#endif
+
+public:
+	[[nodiscard]] constexpr mapped_allocator() noexcept = default;
+
+	template <typename U>
+	[[nodiscard]] constexpr explicit(false) mapped_allocator(const mapped_allocator<U, MapThreshold, HugePages>&) noexcept{
+	}
+
+	[[nodiscard]] T* allocate(size_type count){
+		if(count > this->max_size()){
+			throw std::bad_array_new_length{};
+		}
+
+		if(!is_mapped_(count)){
+			return std::allocator<T>{}.allocate(count);
+		}
+
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+		const size_type length = mapping_length_(count);
+		void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(p == MAP_FAILED){
+			throw std::bad_alloc{};
+		}
+		advise_(p, length);
+		return static_cast<T*>(p);
+#else
+		std::unreachable();
+#endif
+	}
+
+	void deallocate(T* p, size_type count) noexcept{
+		if(!is_mapped_(count)){
+			std::allocator<T>{}.deallocate(p, count);
+			return;
+		}
+
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+		::munmap(p, mapping_length_(count));
+#endif
+	}
+
+	/**
+	 * @brief 在原映射之后扩展，不移动地址；小块或相邻地址被占用时返回 false
+	 */
+	[[nodiscard]] bool expand_in_place(T* p, size_type old_count, size_type new_count) noexcept{
+		assert(new_count >= old_count);
+		if(!is_mapped_(old_count)) return false;
+
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+		const size_type old_length = mapping_length_(old_count);
+		const size_type new_length = mapping_length_(new_count);
+		if(new_length <= old_length) return true;
+
+		if(::mremap(p, old_length, new_length, 0) == MAP_FAILED){
+			return false;
+		}
+		advise_(p, new_length);
+		return true;
+#else
+		(void)p;
+		(void)new_count;
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief 映射之间通过 mremap 搬移页表，不复制数据；涉及小块时分配新块并复制前 used_count 个元素
+	 */
+	[[nodiscard]] T* reallocate(T* p, size_type old_count, size_type new_count, size_type used_count){
+		assert(used_count <= old_count);
+#if MO_YANXI_MAPPED_ALLOCATOR_MMAP
+		if(is_mapped_(old_count) && is_mapped_(new_count)){
+			if(new_count > this->max_size()){
+				throw std::bad_array_new_length{};
+			}
+
+			const size_type new_length = mapping_length_(new_count);
+			void* rst = ::mremap(p, mapping_length_(old_count), new_length, MREMAP_MAYMOVE);
+			if(rst == MAP_FAILED){
+				throw std::bad_alloc{};
+			}
+			advise_(rst, new_length);
+			return static_cast<T*>(rst);
+		}
+#endif
+
+		T* next = this->allocate(new_count);
+		std::memcpy(
+			static_cast<void*>(next),
+			static_cast<const void*>(p),
+			std::min(used_count, new_count) * sizeof(T));
+		this->deallocate(p, old_count);
+		return next;
+	}
+
+	[[nodiscard]] static constexpr size_type max_size() noexcept{
+		return std::numeric_limits<size_type>::max() / sizeof(T);
+	}
+
+	template <typename U>
+	[[nodiscard]] constexpr bool operator==(const mapped_allocator<U, MapThreshold, HugePages>&) const noexcept{
+		return true;
+	}
+};
+}
@@ -29,7 +29,20 @@ concept implicit_lifetime_type =
 	!std::is_volatile_v<T> &&
 	is_implicit_lifetime_v<T>;
 
+/**
+ * @brief 可按字节搬移（memcpy 后不再析构源对象）的类型
+ *
+ * 平凡可复制类型默认满足；其他类型可特化此模板显式声明，以便扩容时走 memcpy / mremap 路径。
+ */
+export template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>{};
+
+export template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 export struct preserve_relocation_t{
+	static constexpr bool bitwise_relocation = true;
+
 	template <typename T, std::integral SizeTy>
 		requires std::is_trivially_copyable_v<T>
 	FORCE_INLINE static void operator()(const T* old_data, T* new_data, SizeTy count) noexcept{
@@ -61,6 +74,41 @@ concept raw_byte_buffer_relocator =
 	raw_byte_buffer_size_type<SizeTy> &&
 	std::is_invocable_v<Relocator&, T*, T*, SizeTy>;
 
+/**
+ * @brief 按字节搬移且搬移后源对象视为已销毁的 relocator，允许分配器以 mremap 等方式直接搬移整个块
+ */
+export template <typename Relocator>
+concept raw_byte_buffer_bitwise_relocator = requires{
+	requires std::remove_cvref_t<Relocator>::bitwise_relocation;
+};
+
+/**
+ * @brief 分配器扩展：尝试原地扩大已分配的块，失败时原块不变
+ *
+ * expand_in_place(p, old_n, new_n) 成功后 p 可容纳 new_n 个元素，释放时以 new_n 作为大小。
+ */
+export template <typename Alloc>
+concept in_place_expandable_allocator = requires(
+	Alloc& allocator,
+	typename std::allocator_traits<Alloc>::pointer p,
+	typename std::allocator_traits<Alloc>::size_type n){
+	{ allocator.expand_in_place(p, n, n) } noexcept -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief 分配器扩展：按字节重新分配，语义同 realloc
+ *
+ * reallocate(p, old_n, new_n, used_n) 返回可容纳 new_n 个元素的块，前 used_n 个元素的字节被保留，原块随之释放；
+ * 失败时抛出异常且原块不变。仅在元素可按字节搬移时使用。
+ */
+export template <typename Alloc>
+concept bitwise_reallocatable_allocator = requires(
+	Alloc& allocator,
+	typename std::allocator_traits<Alloc>::pointer p,
+	typename std::allocator_traits<Alloc>::size_type n){
+	{ allocator.reallocate(p, n, n, n) } -> std::same_as<typename std::allocator_traits<Alloc>::pointer>;
+};
+
 export template <typename Operation, typename T, typename SizeTy = std::size_t>
 concept raw_byte_buffer_overwrite_operation =
 	raw_byte_buffer_size_type<SizeTy> &&
@@ -422,6 +470,22 @@ protected:
 	void reallocate_(size_type new_capacity, Relocator&& on_reallocate){
 		this->check_capacity_(new_capacity);
 
+		if(capacity_ != 0){
+			// 原地扩容不移动元素，对任何 relocator 均成立
+			if constexpr(in_place_expandable_allocator<allocator_type>){
+				if(allocator_.expand_in_place(allocation_, capacity_, new_capacity)){
+					capacity_ = new_capacity;
+					return;
+				}
+			}
+
+			if constexpr(bitwise_reallocatable_allocator<allocator_type> && raw_byte_buffer_bitwise_relocator<Relocator>){
+				allocation_ = allocator_.reallocate(allocation_, capacity_, new_capacity, size_);
+				capacity_ = new_capacity;
+				return;
+			}
+		}
+
 		pointer new_allocation = allocator_traits::allocate(allocator_, new_capacity);
 		value_type* const old_data = data();
 		value_type* const new_data = std::to_address(new_allocation);
@@ -437,7 +501,10 @@ protected:
 					throw;
 				}
 			}
-			this->destroy_n_(old_data, size_);
+			// 按字节搬移后源对象的生命周期已转移，不再析构
+			if constexpr(!raw_byte_buffer_bitwise_relocator<Relocator>){
+				this->destroy_n_(old_data, size_);
+			}
 			allocator_traits::deallocate(allocator_, allocation_, capacity_);
 		}
 
@@ -517,9 +584,9 @@ public:
 	using typename base_type::const_iterator;
 
 	static constexpr bool default_relocation_available =
-		std::is_trivially_copyable_v<value_type> || allocator_move_constructible_;
+		is_trivially_relocatable_v<value_type> || allocator_move_constructible_;
 	static constexpr bool default_relocation_is_nothrow =
-		std::is_trivially_copyable_v<value_type> || allocator_move_construct_is_nothrow_;
+		is_trivially_relocatable_v<value_type> || allocator_move_construct_is_nothrow_;
 
 	[[nodiscard]] raw_vector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>)
 	= default;
@@ -643,6 +710,8 @@ public:
 
 private:
 	struct default_relocator{
+		static constexpr bool bitwise_relocation = is_trivially_relocatable_v<value_type>;
+
 		raw_vector* owner;
 
 		FORCE_INLINE void operator()(value_type* old_data, value_type* new_data, size_type count) const noexcept(
@@ -655,8 +724,11 @@ private:
 		default_relocation_is_nothrow) requires default_relocation_available{
 		if(count == 0) return;
 
-		if constexpr(std::is_trivially_copyable_v<value_type>){
-			preserve_relocation(old_data, new_data, count);
+		if constexpr(is_trivially_relocatable_v<value_type>){
+			std::memcpy(
+				static_cast<void*>(new_data),
+				static_cast<const void*>(old_data),
+				static_cast<std::size_t>(count) * sizeof(value_type));
 		} else if constexpr(default_relocation_is_nothrow){
 			for(size_type idx = 0; idx < count; ++idx){
 				this->construct_at_(new_data + idx, std::move(old_data[idx]));
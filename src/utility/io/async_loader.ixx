@@ -0,0 +1,791 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MO_YANXI_ASYNC_LOADER_POSIX 1
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define MO_YANXI_ASYNC_LOADER_URING 1
+#endif
+
+export module mo_yanxi.io.async_loader;
+
+export import mo_yanxi.byte_pool;
+export import mo_yanxi.concurrent.mpsc_queue;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+namespace mo_yanxi::io{
+export
+enum struct loader_backend : std::uint8_t{
+	/**
+	 * @brief 可用时使用 io_uring，否则使用线程池
+	 */
+	automatic,
+	io_uring,
+	thread_pool,
+};
+
+export
+enum struct load_status : std::uint8_t{
+	ok,
+	open_failed,
+	read_failed,
+};
+
+/**
+ * @brief 一次读取请求，默认读取整个文件
+ */
+export
+struct load_request{
+	static constexpr std::uint64_t whole_file = std::numeric_limits<std::uint64_t>::max();
+
+	std::filesystem::path path{};
+	std::uint64_t offset{};
+	std::uint64_t length{whole_file};
+	std::uint64_t user_data{};
+};
+
+export
+struct load_result{
+	using buffer_type = byte_borrow<std::byte, std::allocator<std::byte>, concurrent_byte_pool<>>;
+
+	/**
+	 * @brief 请求在所属批次中的下标
+	 */
+	std::size_t index{};
+	std::uint64_t user_data{};
+	load_status status{};
+	/**
+	 * @brief 失败时的系统错误码（errno）
+	 */
+	int error{};
+	/**
+	 * @brief 实际读取的字节数；请求范围越过文件末尾时按文件末尾截断
+	 */
+	std::size_t size{};
+	buffer_type buffer{};
+
+	[[nodiscard]] std::span<const std::byte> bytes() const noexcept{
+		return {buffer.data(), size};
+	}
+
+	[[nodiscard]] explicit operator bool() const noexcept{
+		return status == load_status::ok;
+	}
+};
+
+namespace async_loader_detail{
+	// byte_pool 以 unsigned 计数且按 2 的幂取整，单次读取不超过 2GB
+	constexpr std::uint64_t max_read_size = std::uint64_t{1} << 31;
+
+	[[nodiscard]] inline load_result make_failure(const std::size_t index, const load_request& request, const load_status status, const int error) noexcept{
+		return {.index = index, .user_data = request.user_data, .status = status, .error = error};
+	}
+
+	/**
+	 * @brief 由文件大小与请求范围得到实际读取长度，超出 max_read_size 时返回空
+	 */
+	[[nodiscard]] inline std::optional<std::size_t> clamp_length(const load_request& request, const std::uint64_t file_size) noexcept{
+		if(request.offset >= file_size) return 0;
+		const std::uint64_t length = std::min(request.length, file_size - request.offset);
+		if(length > max_read_size) return std::nullopt;
+		return static_cast<std::size_t>(length);
+	}
+
+	/**
+	 * @brief 阻塞读取单个请求，线程池后端使用
+	 */
+	inline load_result read_blocking(concurrent_byte_pool<>& pool, const std::size_t index, const load_request& request){
+#if MO_YANXI_ASYNC_LOADER_POSIX
+		const int fd = ::open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd < 0) return async_loader_detail::make_failure(index, request, load_status::open_failed, errno);
+
+		struct fd_guard{
+			int fd;
+
+			~fd_guard(){
+				::close(fd);
+			}
+		} guard{fd};
+
+		struct stat st;
+		if(::fstat(fd, &st) != 0) return async_loader_detail::make_failure(index, request, load_status::open_failed, errno);
+
+		const auto length = async_loader_detail::clamp_length(request, static_cast<std::uint64_t>(st.st_size));
+		if(!length) return async_loader_detail::make_failure(index, request, load_status::read_failed, EFBIG);
+
+		load_result rst{.index = index, .user_data = request.user_data};
+		if(*length == 0) return rst;
+
+		rst.buffer = pool.borrow<std::byte>(static_cast<unsigned>(*length));
+		while(rst.size < *length){
+			const auto n = ::pread(fd, rst.buffer.data() + rst.size, *length - rst.size, static_cast<off_t>(request.offset + rst.size));
+			if(n < 0){
+				if(errno == EINTR) continue;
+				return async_loader_detail::make_failure(index, request, load_status::read_failed, errno);
+			}
+			// 文件在读取期间被截断
+			if(n == 0) break;
+			rst.size += static_cast<std::size_t>(n);
+		}
+		return rst;
+#else
+		std::ifstream stream(request.path, std::ios::binary | std::ios::ate);
+		if(!stream.is_open()) return async_loader_detail::make_failure(index, request, load_status::open_failed, 0);
+
+		const auto length = async_loader_detail::clamp_length(request, static_cast<std::uint64_t>(stream.tellg()));
+		if(!length) return async_loader_detail::make_failure(index, request, load_status::read_failed, 0);
+
+		load_result rst{.index = index, .user_data = request.user_data};
+		if(*length == 0) return rst;
+
+		rst.buffer = pool.borrow<std::byte>(static_cast<unsigned>(*length));
+		stream.seekg(static_cast<std::streamoff>(request.offset));
+		stream.read(reinterpret_cast<char*>(rst.buffer.data()), static_cast<std::streamsize>(*length));
+		rst.size = static_cast<std::size_t>(stream.gcount());
+		if(rst.size == 0 && stream.bad()) return async_loader_detail::make_failure(index, request, load_status::read_failed, 0);
+		return rst;
+#endif
+	}
+
+#if MO_YANXI_ASYNC_LOADER_URING
+	/**
+	 * @brief 最小的 io_uring 封装：直接通过系统调用建立环并映射提交 / 完成队列，不依赖 liburing
+	 */
+	class uring{
+		int fd_{-1};
+
+		void* sq_ring_{};
+		std::size_t sq_ring_size_{};
+		void* cq_ring_{};
+		std::size_t cq_ring_size_{};
+		io_uring_sqe* sqes_{};
+		std::size_t sqes_size_{};
+
+		unsigned* sq_head_{};
+		unsigned* sq_tail_{};
+		unsigned* sq_array_{};
+		unsigned sq_mask_{};
+		unsigned sq_entries_{};
+
+		unsigned* cq_head_{};
+		unsigned* cq_tail_{};
+		io_uring_cqe* cqes_{};
+		unsigned cq_mask_{};
+
+		unsigned pending_{};
+		bool broken_{};
+		std::vector<load_result::buffer_type> parked_{};
+
+		[[nodiscard]] static unsigned load_acquire(unsigned* p) noexcept{
+			return std::atomic_ref{*p}.load(std::memory_order_acquire);
+		}
+
+		static void store_release(unsigned* p, const unsigned value) noexcept{
+			std::atomic_ref{*p}.store(value, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool supports_(const std::initializer_list<unsigned> ops) const noexcept{
+			constexpr unsigned probe_ops = 256;
+			alignas(io_uring_probe) std::array<std::byte, sizeof(io_uring_probe) + probe_ops * sizeof(io_uring_probe_op)> storage{};
+			auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+			if(::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, probe_ops) < 0) return false;
+
+			return std::ranges::all_of(ops, [probe](const unsigned op){
+				return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+			});
+		}
+
+	public:
+		[[nodiscard]] uring() = default;
+
+		uring(const uring&) = delete;
+		uring& operator=(const uring&) = delete;
+
+		~uring(){
+			if(sqes_) ::munmap(sqes_, sqes_size_);
+			if(cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+			if(sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+			// 关闭环会取消其上的全部条目，parked_ 在此之后才归还缓冲区
+			if(fd_ >= 0) ::close(fd_);
+		}
+
+		/**
+		 * @return 内核不支持 io_uring、被禁用或缺少 OPENAT / READ 操作时为 false
+		 */
+		[[nodiscard]] bool init(const unsigned entries) noexcept{
+			io_uring_params params{};
+			const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+			if(fd < 0) return false;
+			fd_ = static_cast<int>(fd);
+
+			sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+			if(single_mmap){
+				sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+			}
+
+			void* sq = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+			if(sq == MAP_FAILED) return false;
+			sq_ring_ = sq;
+
+			if(single_mmap){
+				cq_ring_ = sq_ring_;
+			} else{
+				void* cq = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+				if(cq == MAP_FAILED) return false;
+				cq_ring_ = cq;
+			}
+
+			sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+			void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+			if(sqes == MAP_FAILED) return false;
+			sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+			auto* sq_base = static_cast<std::byte*>(sq_ring_);
+			sq_head_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+			sq_tail_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+			sq_array_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+			sq_mask_ = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+			sq_entries_ = params.sq_entries;
+
+			auto* cq_base = static_cast<std::byte*>(cq_ring_);
+			cq_head_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+			cq_tail_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+			cqes_ = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+			cq_mask_ = *reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+
+			return this->supports_({IORING_OP_OPENAT, IORING_OP_READ});
+		}
+
+		[[nodiscard]] unsigned sq_entries() const noexcept{
+			return sq_entries_;
+		}
+
+		/**
+		 * @return 提交队列已满时为空
+		 */
+		[[nodiscard]] io_uring_sqe* get_sqe() noexcept{
+			const unsigned tail = *sq_tail_ + pending_;
+			if(tail - uring::load_acquire(sq_head_) >= sq_entries_) return nullptr;
+
+			const unsigned slot = tail & sq_mask_;
+			sq_array_[slot] = slot;
+			++pending_;
+
+			io_uring_sqe* sqe = sqes_ + slot;
+			*sqe = io_uring_sqe{};
+			return sqe;
+		}
+
+		/**
+		 * @brief 提交已准备的条目并至少等待 wait_count 个完成
+		 * @return 失败时为负的 errno
+		 */
+		int submit_and_wait(const unsigned wait_count) noexcept{
+			uring::store_release(sq_tail_, *sq_tail_ + pending_);
+			pending_ = 0;
+
+			while(true){
+				// 被信号打断后重试时，只提交内核尚未消费的条目
+				const unsigned to_submit = *sq_tail_ - uring::load_acquire(sq_head_);
+				const long rst = ::syscall(__NR_io_uring_enter, fd_, to_submit, wait_count, wait_count ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+				if(rst >= 0) return 0;
+				if(errno != EINTR) return -errno;
+			}
+		}
+
+		/**
+		 * @brief 仅等待完成，不提交新条目
+		 * @return 失败时为负的 errno
+		 */
+		int wait(const unsigned wait_count) noexcept{
+			while(true){
+				const long rst = ::syscall(__NR_io_uring_enter, fd_, 0, wait_count, IORING_ENTER_GETEVENTS, nullptr, 0);
+				if(rst >= 0) return 0;
+				if(errno != EINTR) return -errno;
+			}
+		}
+
+		/**
+		 * @brief 撤回内核尚未消费的条目（含尚未提交的），对每个条目的 user_data 调用 fn
+		 *
+		 * 未使用 SQPOLL，内核只在 io_uring_enter 期间推进队头，因此可以安全地回退队尾。
+		 */
+		template <std::invocable<std::uint64_t> Fn>
+		void retract_unsubmitted(Fn fn){
+			const unsigned head = uring::load_acquire(sq_head_);
+			const unsigned tail = *sq_tail_ + pending_;
+			pending_ = 0;
+			uring::store_release(sq_tail_, head);
+			for(unsigned i = head; i != tail; ++i){
+				std::invoke(fn, sqes_[sq_array_[i & sq_mask_]].user_data);
+			}
+		}
+
+		/**
+		 * @brief 内核可能仍在写入的缓冲区，随环一同释放
+		 */
+		void park(load_result::buffer_type&& buffer){
+			parked_.push_back(std::move(buffer));
+		}
+
+		void mark_broken() noexcept{
+			broken_ = true;
+		}
+
+		[[nodiscard]] bool broken() const noexcept{
+			return broken_;
+		}
+
+		template <std::invocable<const io_uring_cqe&> Fn>
+		unsigned for_each_completion(Fn fn){
+			unsigned head = *cq_head_;
+			const unsigned tail = uring::load_acquire(cq_tail_);
+			const unsigned count = tail - head;
+			for(; head != tail; ++head){
+				// 先复制再归还槽位，回调中可以继续准备新的提交
+				const io_uring_cqe cqe = cqes_[head & cq_mask_];
+				uring::store_release(cq_head_, head + 1);
+				std::invoke(fn, cqe);
+			}
+			return count;
+		}
+	};
+#endif
+}
+
+/**
+ * @brief 批量读取文件，读取结果放入从 concurrent_byte_pool 借用的缓冲区
+ *
+ * - io_uring 后端：调用线程驱动一个环，打开与读取均以异步操作提交，同时在途的请求数不超过 queue_depth
+ * - 线程池后端：在线程池上并行执行 open / pread，作为内核不支持 io_uring 或非 Linux 平台时的回退
+ *
+ * 完成通知通过回调 sink(load_result&&) 或 ccur::mpsc_queue<load_result> 送达。
+ * 线程池后端会在工作线程上调用 sink，sink 需可并发调用。
+ * 单个请求的读取长度不超过 2GB，更大的文件请使用 mapped_file_view。
+ *
+ * sink 抛出异常时，已提交给内核的操作会先全部完成或撤回，再将异常传出 load。
+ *
+ * @warning byte_pool 必须比所有 load_result 以及 batch_file_loader 本身活得更久
+ */
+export
+class batch_file_loader{
+public:
+	using sink_type = std::move_only_function<void(load_result&&)>;
+
+	static constexpr unsigned default_queue_depth = 64;
+
+private:
+	struct batch{
+		std::vector<load_request> requests;
+		sink_type sink;
+		std::promise<void> done;
+	};
+
+	concurrent_byte_pool<>* pool_;
+	loader_backend backend_{loader_backend::thread_pool};
+	unsigned queue_depth_;
+
+#if MO_YANXI_ASYNC_LOADER_URING
+	std::unique_ptr<async_loader_detail::uring> ring_{};
+#endif
+	std::mutex ring_mutex_{};
+	std::unique_ptr<ccur::thread_pool> workers_{};
+	std::size_t worker_count_;
+
+	ccur::mpsc_queue<batch> batches_{};
+	std::atomic_bool stopping_{};
+	std::thread dispatcher_{};
+	std::once_flag dispatcher_started_{};
+
+	ccur::thread_pool& workers_pool_(){
+		// 仅在回退路径上创建线程池，io_uring 后端不占用额外线程
+		if(!workers_){
+			workers_ = std::make_unique<ccur::thread_pool>(worker_count_);
+		}
+		return *workers_;
+	}
+
+	template <typename Sink>
+	void load_thread_pool_(std::span<const load_request> requests, Sink& sink){
+		ccur::thread_pool* pool;
+		{
+			std::lock_guard lock{ring_mutex_};
+			pool = &this->workers_pool_();
+		}
+
+		pool->parallel_for(0, requests.size(), [&, this](const std::size_t i){
+			std::invoke(sink, async_loader_detail::read_blocking(*pool_, i, requests[i]));
+		}, 1);
+	}
+
+#if MO_YANXI_ASYNC_LOADER_URING
+	template <typename Sink>
+	void load_uring_(std::span<const load_request> requests, Sink& sink){
+		using async_loader_detail::uring;
+
+		enum struct stage : std::uint8_t{
+			idle,
+			open,
+			read,
+		};
+
+		struct slot{
+			stage state{stage::idle};
+			// 提交队列或内核中仍有该槽位的条目，此时缓冲区与 fd 不得释放
+			bool queued{};
+			// 条目已从提交队列撤回，等待改为阻塞完成
+			bool retracted{};
+			int fd{-1};
+			std::size_t index{};
+			std::size_t length{};
+			load_result result{};
+
+			[[nodiscard]] slot() = default;
+			slot(const slot&) = delete;
+			slot& operator=(const slot&) = delete;
+
+			~slot(){
+				if(fd >= 0) ::close(fd);
+			}
+		};
+
+		std::unique_lock lock{ring_mutex_};
+		uring& ring = *ring_;
+		if(ring.broken()){
+			lock.unlock();
+			this->load_thread_pool_(requests, sink);
+			return;
+		}
+
+		const auto depth = std::min<std::size_t>(ring.sq_entries(), requests.size());
+		std::vector<slot> slots(depth);
+		std::vector<std::uint32_t> free_slots(depth);
+		std::iota(free_slots.begin(), free_slots.end(), 0u);
+
+		std::size_t next = 0;
+		std::size_t in_flight = 0;
+		std::size_t queued = 0;
+		// 环失败后不再提交新条目，已打开的槽位改为阻塞读取
+		bool ring_failed = false;
+		// sink 抛出异常后只回收槽位，不再产生结果
+		bool discarding = false;
+
+		const auto finish = [&](const std::uint32_t id, load_result&& rst){
+			slot& s = slots[id];
+			if(s.fd >= 0) ::close(std::exchange(s.fd, -1));
+			s.state = stage::idle;
+			free_slots.push_back(id);
+			--in_flight;
+			if(!discarding) std::invoke(sink, std::move(rst));
+		};
+
+		const auto enqueue = [&](const std::uint32_t id) -> io_uring_sqe&{
+			io_uring_sqe* sqe = ring.get_sqe();
+			// 每个槽位至多一个在途条目，且槽位数不超过提交队列长度
+			assert(sqe);
+			sqe->user_data = id;
+			slots[id].queued = true;
+			++queued;
+			return *sqe;
+		};
+
+		const auto read_rest_blocking = [&](const std::uint32_t id){
+			slot& s = slots[id];
+			while(s.result.size < s.length){
+				const auto n = ::pread(s.fd, s.result.buffer.data() + s.result.size, s.length - s.result.size,
+					static_cast<off_t>(requests[s.index].offset + s.result.size));
+				if(n < 0){
+					if(errno == EINTR) continue;
+					finish(id, async_loader_detail::make_failure(s.index, requests[s.index], load_status::read_failed, errno));
+					return;
+				}
+				if(n == 0) break;
+				s.result.size += static_cast<std::size_t>(n);
+			}
+			finish(id, std::move(s.result));
+		};
+
+		const auto prepare_read = [&](const std::uint32_t id){
+			if(ring_failed){
+				read_rest_blocking(id);
+				return;
+			}
+
+			slot& s = slots[id];
+			io_uring_sqe& sqe = enqueue(id);
+			sqe.opcode = IORING_OP_READ;
+			sqe.fd = s.fd;
+			sqe.addr = reinterpret_cast<std::uintptr_t>(s.result.buffer.data() + s.result.size);
+			sqe.len = static_cast<std::uint32_t>(s.length - s.result.size);
+			sqe.off = requests[s.index].offset + s.result.size;
+			s.state = stage::read;
+		};
+
+		const auto on_open = [&](const std::uint32_t id, const int res){
+			slot& s = slots[id];
+			const load_request& request = requests[s.index];
+			if(res < 0){
+				finish(id, async_loader_detail::make_failure(s.index, request, load_status::open_failed, -res));
+				return;
+			}
+			s.fd = res;
+
+			// 打开后 inode 已在缓存中，fstat 不会阻塞在磁盘上
+			struct stat st;
+			if(::fstat(s.fd, &st) != 0){
+				finish(id, async_loader_detail::make_failure(s.index, request, load_status::open_failed, errno));
+				return;
+			}
+
+			const auto length = async_loader_detail::clamp_length(request, static_cast<std::uint64_t>(st.st_size));
+			if(!length){
+				finish(id, async_loader_detail::make_failure(s.index, request, load_status::read_failed, EFBIG));
+				return;
+			}
+
+			s.length = *length;
+			s.result = load_result{.index = s.index, .user_data = request.user_data};
+			if(s.length == 0){
+				finish(id, std::move(s.result));
+				return;
+			}
+
+			s.result.buffer = pool_->borrow<std::byte>(static_cast<unsigned>(s.length));
+			prepare_read(id);
+		};
+
+		const auto on_read = [&](const std::uint32_t id, const int res){
+			slot& s = slots[id];
+			if(res == -EINTR || res == -EAGAIN){
+				prepare_read(id);
+				return;
+			}
+			if(res < 0){
+				finish(id, async_loader_detail::make_failure(s.index, requests[s.index], load_status::read_failed, -res));
+				return;
+			}
+
+			s.result.size += static_cast<std::size_t>(res);
+			// res 为 0 表示文件在读取期间被截断
+			if(res == 0 || s.result.size == s.length){
+				finish(id, std::move(s.result));
+			} else{
+				prepare_read(id);
+			}
+		};
+
+		const auto on_completion = [&](const io_uring_cqe& cqe){
+			const auto id = static_cast<std::uint32_t>(cqe.user_data);
+			slots[id].queued = false;
+			--queued;
+
+			if(discarding){
+				finish(id, {});
+				return;
+			}
+
+			switch(slots[id].state){
+			case stage::open : on_open(id, cqe.res); break;
+			case stage::read : on_read(id, cqe.res); break;
+			default : std::unreachable();
+			}
+		};
+
+		// 撤回内核尚未消费的条目，并等待其余条目完成，之后所有缓冲区与 fd 都不再被内核引用
+		const auto settle = [&]{
+			ring_failed = true;
+			ring.retract_unsubmitted([&](const std::uint64_t user_data){
+				slot& s = slots[static_cast<std::uint32_t>(user_data)];
+				s.queued = false;
+				s.retracted = true;
+				--queued;
+			});
+
+			// 被撤回的槽位已不被内核引用，改为阻塞完成；sink 在此抛出时剩余标记由再次 settle 处理
+			for(std::uint32_t id = 0; id < slots.size(); ++id){
+				slot& s = slots[id];
+				if(!std::exchange(s.retracted, false)) continue;
+
+				if(discarding){
+					finish(id, {});
+				} else if(s.state == stage::open){
+					finish(id, async_loader_detail::read_blocking(*pool_, s.index, requests[s.index]));
+				} else{
+					read_rest_blocking(id);
+				}
+			}
+
+			while(queued != 0){
+				const int err = ring.wait(1);
+				if(ring.for_each_completion(on_completion) != 0 || err >= 0) continue;
+
+				// 内核既不交付完成也不允许等待，无法确定条目何时结束：缓冲区转交给环保管，环随之停用
+				ring.mark_broken();
+				for(std::uint32_t id = 0; id < slots.size(); ++id){
+					slot& s = slots[id];
+					if(!s.queued) continue;
+					s.queued = false;
+					--queued;
+					ring.park(std::move(s.result.buffer));
+					// 打开阶段的 fd 尚未返回给用户态；读取阶段内核持有文件的引用，关闭 fd 是安全的
+					finish(id, async_loader_detail::make_failure(s.index, requests[s.index], load_status::read_failed, -err));
+				}
+			}
+		};
+
+		try{
+			while(next < requests.size() || in_flight != 0){
+				while(next < requests.size() && !free_slots.empty()){
+					const std::uint32_t id = free_slots.back();
+					free_slots.pop_back();
+
+					slot& s = slots[id];
+					s.index = next++;
+					s.state = stage::open;
+					++in_flight;
+
+					io_uring_sqe& sqe = enqueue(id);
+					sqe.opcode = IORING_OP_OPENAT;
+					sqe.fd = AT_FDCWD;
+					sqe.addr = reinterpret_cast<std::uintptr_t>(requests[s.index].path.c_str());
+					sqe.open_flags = O_RDONLY | O_CLOEXEC;
+				}
+
+				const int err = ring.submit_and_wait(1);
+				// 出错时仍先收割已有的完成（-EBUSY 即完成队列积压）；没有任何进展才视为环不可用
+				if(ring.for_each_completion(on_completion) == 0 && err < 0){
+					settle();
+					break;
+				}
+			}
+		} catch(...){
+			discarding = true;
+			settle();
+			throw;
+		}
+
+		for(; next < requests.size(); ++next){
+			std::invoke(sink, async_loader_detail::read_blocking(*pool_, next, requests[next]));
+		}
+	}
+#endif
+
+	void dispatch_(){
+		while(auto job = batches_.consume([this]{ return stopping_.load(std::memory_order_acquire); })){
+			try{
+				this->load(job->requests, job->sink);
+				job->done.set_value();
+			} catch(...){
+				job->done.set_exception(std::current_exception());
+			}
+		}
+	}
+
+public:
+	/**
+	 * @param pool 读取缓冲区的来源
+	 * @param backend 指定 io_uring 但不可用时退化为线程池
+	 * @param queue_depth io_uring 同时在途的请求数
+	 * @param worker_count 线程池后端的线程数，0 时使用硬件并发数
+	 */
+	[[nodiscard]] explicit batch_file_loader(
+		concurrent_byte_pool<>& pool,
+		const loader_backend backend = loader_backend::automatic,
+		const unsigned queue_depth = default_queue_depth,
+		const std::size_t worker_count = 0)
+		: pool_(&pool), queue_depth_(std::max(1u, queue_depth)), worker_count_(worker_count){
+#if MO_YANXI_ASYNC_LOADER_URING
+		if(backend != loader_backend::thread_pool){
+			auto ring = std::make_unique<async_loader_detail::uring>();
+			if(ring->init(queue_depth_)){
+				ring_ = std::move(ring);
+				backend_ = loader_backend::io_uring;
+			}
+		}
+#else
+		(void)backend;
+#endif
+	}
+
+	batch_file_loader(const batch_file_loader&) = delete;
+	batch_file_loader& operator=(const batch_file_loader&) = delete;
+
+	/**
+	 * @brief 等待所有已 submit 的批次完成后析构
+	 */
+	~batch_file_loader(){
+		// 在队列锁内置位，避免调度线程检查退出条件后、进入等待前错过唤醒
+		batches_.notify_after([this]{
+			stopping_.store(true, std::memory_order_release);
+		});
+		if(dispatcher_.joinable()) dispatcher_.join();
+	}
+
+	/**
+	 * @brief 实际使用的后端，不会是 automatic
+	 */
+	[[nodiscard]] loader_backend backend() const noexcept{
+		return backend_;
+	}
+
+	/**
+	 * @brief 读取一批请求，全部完成后返回；每个请求恰好产生一个 load_result，顺序不保证
+	 */
+	template <std::invocable<load_result&&> Sink>
+	void load(std::span<const load_request> requests, Sink&& sink){
+		if(requests.empty()) return;
+
+#if MO_YANXI_ASYNC_LOADER_URING
+		if(ring_){
+			this->load_uring_(requests, sink);
+			return;
+		}
+#endif
+		this->load_thread_pool_(requests, sink);
+	}
+
+	void load(std::span<const load_request> requests, ccur::mpsc_queue<load_result>& queue){
+		this->load(requests, [&queue](load_result&& rst){
+			queue.push(std::move(rst));
+		});
+	}
+
+	/**
+	 * @brief 将一批请求交给后台线程读取后立即返回，批次之间按提交顺序执行
+	 * @return 该批次全部完成（sink 均已返回）时就绪
+	 */
+	std::future<void> submit(std::vector<load_request> requests, sink_type sink){
+		std::call_once(dispatcher_started_, [this]{
+			dispatcher_ = std::thread{[this]{ this->dispatch_(); }};
+		});
+
+		batch job{std::move(requests), std::move(sink), {}};
+		auto future = job.done.get_future();
+		batches_.push(std::move(job));
+		return future;
+	}
+
+	/**
+	 * @brief 同上，结果推入 queue，queue 需比批次完成活得更久
+	 */
+	std::future<void> submit(std::vector<load_request> requests, ccur::mpsc_queue<load_result>& queue){
+		return this->submit(std::move(requests), [&queue](load_result&& rst){
+			queue.push(std::move(rst));
+		});
+	}
+};
+}
@@ -0,0 +1,477 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#define MO_YANXI_MAPPED_FILE_WIN32 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MO_YANXI_MAPPED_FILE_POSIX 1
+#endif
+
+export module mo_yanxi.io.mapped_file;
+
+import std;
+
+namespace mo_yanxi::io{
+/**
+ * @brief 访问模式提示，对应 madvise / PrefetchVirtualMemory，平台不支持时忽略
+ */
+export
+enum struct map_advice : std::uint8_t{
+	normal,
+	sequential,
+	random,
+	/**
+	 * @brief 预读指定范围
+	 */
+	will_need,
+	/**
+	 * @brief 允许系统回收指定范围的页面，再次访问时从文件重新读取
+	 */
+	dont_need,
+};
+
+namespace mapped_file_detail{
+#if MO_YANXI_MAPPED_FILE_WIN32
+	using native_handle = HANDLE;
+	inline const native_handle invalid_handle = INVALID_HANDLE_VALUE;
+#elif MO_YANXI_MAPPED_FILE_POSIX
+	using native_handle = int;
+	inline constexpr native_handle invalid_handle = -1;
+#else
+	using native_handle = std::ifstream*;
+	inline constexpr native_handle invalid_handle = nullptr;
+#endif
+
+	[[nodiscard]] std::size_t allocation_granularity() noexcept{
+		static const std::size_t size = []() -> std::size_t{
+#if MO_YANXI_MAPPED_FILE_WIN32
+			SYSTEM_INFO info;
+			::GetSystemInfo(&info);
+			return info.dwAllocationGranularity;
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			const long rst = ::sysconf(_SC_PAGESIZE);
+			return rst > 0 ? static_cast<std::size_t>(rst) : 4096;
+#else
+			return 4096;
+#endif
+		}();
+		return size;
+	}
+
+	/**
+	 * @brief 只读打开的文件句柄，仅可移动
+	 */
+	class file_handle{
+		native_handle handle_{invalid_handle};
+#if MO_YANXI_MAPPED_FILE_WIN32
+		HANDLE mapping_{};
+#endif
+		std::uint64_t size_{};
+
+	public:
+		[[nodiscard]] file_handle() = default;
+
+		[[nodiscard]] file_handle(file_handle&& other) noexcept
+			: handle_(std::exchange(other.handle_, invalid_handle)),
+#if MO_YANXI_MAPPED_FILE_WIN32
+			  mapping_(std::exchange(other.mapping_, nullptr)),
+#endif
+			  size_(std::exchange(other.size_, 0)){
+		}
+
+		file_handle& operator=(file_handle&& other) noexcept{
+			if(this == &other) return *this;
+			this->close();
+			handle_ = std::exchange(other.handle_, invalid_handle);
+#if MO_YANXI_MAPPED_FILE_WIN32
+			mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+			size_ = std::exchange(other.size_, 0);
+			return *this;
+		}
+
+		~file_handle(){
+			this->close();
+		}
+
+		[[nodiscard]] std::uint64_t size() const noexcept{
+			return size_;
+		}
+
+		[[nodiscard]] bool open(const std::filesystem::path& path) noexcept{
+			this->close();
+#if MO_YANXI_MAPPED_FILE_WIN32
+			handle_ = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if(handle_ == INVALID_HANDLE_VALUE) return false;
+
+			LARGE_INTEGER size;
+			if(!::GetFileSizeEx(handle_, &size)){
+				this->close();
+				return false;
+			}
+			size_ = static_cast<std::uint64_t>(size.QuadPart);
+
+			// 空文件无法创建映射对象
+			if(size_ != 0){
+				mapping_ = ::CreateFileMappingW(handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if(!mapping_){
+					this->close();
+					return false;
+				}
+			}
+			return true;
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			handle_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if(handle_ < 0) return false;
+
+			struct stat st;
+			if(::fstat(handle_, &st) != 0 || !S_ISREG(st.st_mode)){
+				this->close();
+				return false;
+			}
+			size_ = static_cast<std::uint64_t>(st.st_size);
+			return true;
+#else
+			try{
+				auto stream = std::make_unique<std::ifstream>(path, std::ios::binary | std::ios::ate);
+				if(!stream->is_open()) return false;
+				size_ = static_cast<std::uint64_t>(stream->tellg());
+				stream->seekg(0);
+				handle_ = stream.release();
+				return true;
+			} catch(...){
+				return false;
+			}
+#endif
+		}
+
+		void close() noexcept{
+#if MO_YANXI_MAPPED_FILE_WIN32
+			if(mapping_) ::CloseHandle(std::exchange(mapping_, nullptr));
+			if(handle_ != INVALID_HANDLE_VALUE) ::CloseHandle(std::exchange(handle_, INVALID_HANDLE_VALUE));
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			if(handle_ >= 0) ::close(std::exchange(handle_, -1));
+#else
+			delete std::exchange(handle_, nullptr);
+#endif
+			size_ = 0;
+		}
+
+		/**
+		 * @brief 映射 [offset, offset + length)，offset 需按 allocation_granularity 对齐
+		 * @return 映射起始地址，失败时为空
+		 */
+		[[nodiscard]] void* map(const std::uint64_t offset, const std::size_t length) const noexcept{
+			assert(offset % allocation_granularity() == 0);
+			assert(length != 0 && offset + length <= size_);
+#if MO_YANXI_MAPPED_FILE_WIN32
+			return ::MapViewOfFile(mapping_, FILE_MAP_READ,
+				static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFF'FFFFu), length);
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, handle_, static_cast<off_t>(offset));
+			return p == MAP_FAILED ? nullptr : p;
+#else
+			// 无映射支持时读入堆内存
+			try{
+				auto buffer = std::make_unique_for_overwrite<std::byte[]>(length);
+				handle_->clear();
+				handle_->seekg(static_cast<std::streamoff>(offset));
+				if(!handle_->read(reinterpret_cast<char*>(buffer.get()), static_cast<std::streamsize>(length))) return nullptr;
+				return buffer.release();
+			} catch(...){
+				return nullptr;
+			}
+#endif
+		}
+
+		static void unmap(void* base, [[maybe_unused]] const std::size_t length) noexcept{
+			if(!base) return;
+#if MO_YANXI_MAPPED_FILE_WIN32
+			::UnmapViewOfFile(base);
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			::munmap(base, length);
+#else
+			delete[] static_cast<std::byte*>(base);
+#endif
+		}
+
+		/**
+		 * @brief 提示系统将 [offset, offset + length) 读入页缓存，不建立映射
+		 */
+		void prefetch([[maybe_unused]] const std::uint64_t offset, [[maybe_unused]] const std::size_t length) const noexcept{
+#if MO_YANXI_MAPPED_FILE_POSIX && defined(POSIX_FADV_WILLNEED)
+			if(length != 0) (void)::posix_fadvise(handle_, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#endif
+		}
+
+		static void advise(void* base, const std::size_t length, [[maybe_unused]] const map_advice advice) noexcept{
+			if(!base || length == 0) return;
+#if MO_YANXI_MAPPED_FILE_WIN32
+			if(advice == map_advice::will_need){
+				WIN32_MEMORY_RANGE_ENTRY range{base, length};
+				(void)::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+			}
+#elif MO_YANXI_MAPPED_FILE_POSIX
+			int flag{};
+			switch(advice){
+			case map_advice::normal : flag = MADV_NORMAL; break;
+			case map_advice::sequential : flag = MADV_SEQUENTIAL; break;
+			case map_advice::random : flag = MADV_RANDOM; break;
+			case map_advice::will_need : flag = MADV_WILLNEED; break;
+			case map_advice::dont_need : flag = MADV_DONTNEED; break;
+			default : std::unreachable();
+			}
+			// 提示失败不影响正确性
+			(void)::madvise(base, length, flag);
+#endif
+		}
+	};
+}
+
+/**
+ * @brief 只读映射整个文件的视图，析构时解除映射
+ *
+ * 页面在首次访问时由系统按需读入，不经过用户态缓冲，也不占用堆内存；
+ * 映射期间文件被其他进程截断时，访问越过新结尾的页面在 POSIX 下会触发 SIGBUS。
+ * 不支持映射的平台退化为一次性读入堆内存。
+ */
+export
+class mapped_file_view{
+	mapped_file_detail::file_handle file_{};
+	void* base_{};
+	std::size_t size_{};
+
+public:
+	[[nodiscard]] mapped_file_view() = default;
+
+	[[nodiscard]] mapped_file_view(mapped_file_view&& other) noexcept
+		: file_(std::move(other.file_)), base_(std::exchange(other.base_, nullptr)), size_(std::exchange(other.size_, 0)){
+	}
+
+	mapped_file_view& operator=(mapped_file_view&& other) noexcept{
+		if(this == &other) return *this;
+		this->close();
+		file_ = std::move(other.file_);
+		base_ = std::exchange(other.base_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+		return *this;
+	}
+
+	~mapped_file_view(){
+		this->close();
+	}
+
+	/**
+	 * @brief 打开并映射整个文件
+	 * @param advice 映射后对整个文件给出的访问提示
+	 * @return 文件不存在、不可读或超出地址空间时为空
+	 */
+	[[nodiscard]] static std::optional<mapped_file_view> open(
+		const std::filesystem::path& path, const map_advice advice = map_advice::sequential) noexcept{
+		mapped_file_view view{};
+		if(!view.file_.open(path)) return std::nullopt;
+		if(view.file_.size() > std::numeric_limits<std::size_t>::max()) return std::nullopt;
+
+		view.size_ = static_cast<std::size_t>(view.file_.size());
+		if(view.size_ == 0) return view;
+
+		view.base_ = view.file_.map(0, view.size_);
+		if(!view.base_) return std::nullopt;
+
+		mapped_file_detail::file_handle::advise(view.base_, view.size_, advice);
+		return view;
+	}
+
+	void close() noexcept{
+		mapped_file_detail::file_handle::unmap(std::exchange(base_, nullptr), size_);
+		size_ = 0;
+		file_.close();
+	}
+
+	/**
+	 * @brief 对 [offset, offset + length) 给出访问提示，范围向外扩展到页边界并裁剪到文件末尾
+	 */
+	void advise(const map_advice advice, const std::size_t offset = 0, const std::size_t length = std::dynamic_extent) const noexcept{
+		if(offset >= size_) return;
+
+		const std::size_t page = mapped_file_detail::allocation_granularity();
+		const std::size_t first = offset / page * page;
+		const std::size_t last = std::min(size_, offset + std::min(length, size_ - offset));
+		mapped_file_detail::file_handle::advise(static_cast<std::byte*>(base_) + first, last - first, advice);
+	}
+
+	[[nodiscard]] explicit operator bool() const noexcept{
+		return base_ != nullptr;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept{
+		return size_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return size_ == 0;
+	}
+
+	[[nodiscard]] const std::byte* data() const noexcept{
+		return static_cast<const std::byte*>(base_);
+	}
+
+	[[nodiscard]] std::span<const std::byte> bytes() const noexcept{
+		return {this->data(), size_};
+	}
+
+	[[nodiscard]] std::string_view string_view() const noexcept{
+		return {reinterpret_cast<const char*>(base_), size_};
+	}
+
+	/**
+	 * @brief 将 [offset, offset + count * sizeof(T)) 视为 T 的数组，count 缺省时取到文件末尾可容纳的最大个数
+	 * @warning 映射起点按页对齐，offset 需满足 T 的对齐要求
+	 */
+	template <typename T>
+		requires (std::is_trivially_copyable_v<T> && std::is_object_v<T>)
+	[[nodiscard]] std::span<const T> as(const std::size_t offset = 0, const std::size_t count = std::dynamic_extent) const noexcept{
+		assert(offset <= size_);
+		assert(offset % alignof(T) == 0);
+
+		const std::size_t available = (size_ - offset) / sizeof(T);
+		assert(count == std::dynamic_extent || count <= available);
+		return {reinterpret_cast<const T*>(this->data() + offset), std::min(count, available)};
+	}
+};
+
+/**
+ * @brief 以固定大小的窗口顺序映射文件，任一时刻只保留一个窗口，常驻内存与文件大小无关
+ *
+ * 每次 next 解除上一窗口并映射下一窗口，同时提示系统预读再下一个窗口（POSIX 下为 posix_fadvise）。
+ * 窗口起点按 allocation_granularity 对齐，chunk_size 向上取整到其整数倍。
+ */
+export
+class chunked_file_reader{
+public:
+	static constexpr std::size_t default_chunk_size = 16 * 1024 * 1024;
+
+private:
+	mapped_file_detail::file_handle file_{};
+	std::size_t chunk_size_{};
+	std::uint64_t position_{};
+
+	void* window_{};
+	std::size_t window_size_{};
+
+	void release_window_() noexcept{
+		mapped_file_detail::file_handle::unmap(std::exchange(window_, nullptr), std::exchange(window_size_, 0));
+	}
+
+public:
+	[[nodiscard]] chunked_file_reader() = default;
+
+	[[nodiscard]] chunked_file_reader(chunked_file_reader&& other) noexcept
+		: file_(std::move(other.file_)), chunk_size_(other.chunk_size_), position_(std::exchange(other.position_, 0)),
+		  window_(std::exchange(other.window_, nullptr)), window_size_(std::exchange(other.window_size_, 0)){
+	}
+
+	chunked_file_reader& operator=(chunked_file_reader&& other) noexcept{
+		if(this == &other) return *this;
+		this->release_window_();
+		file_ = std::move(other.file_);
+		chunk_size_ = other.chunk_size_;
+		position_ = std::exchange(other.position_, 0);
+		window_ = std::exchange(other.window_, nullptr);
+		window_size_ = std::exchange(other.window_size_, 0);
+		return *this;
+	}
+
+	~chunked_file_reader(){
+		this->release_window_();
+	}
+
+	[[nodiscard]] static std::optional<chunked_file_reader> open(
+		const std::filesystem::path& path, const std::size_t chunk_size = default_chunk_size) noexcept{
+		chunked_file_reader reader{};
+		if(!reader.file_.open(path)) return std::nullopt;
+
+		const std::size_t granularity = mapped_file_detail::allocation_granularity();
+		reader.chunk_size_ = std::max<std::size_t>(1, (chunk_size + granularity - 1) / granularity) * granularity;
+		return reader;
+	}
+
+	[[nodiscard]] std::uint64_t file_size() const noexcept{
+		return file_.size();
+	}
+
+	/**
+	 * @brief 下一次 next 返回的窗口在文件中的偏移
+	 */
+	[[nodiscard]] std::uint64_t position() const noexcept{
+		return position_;
+	}
+
+	[[nodiscard]] std::size_t chunk_size() const noexcept{
+		return chunk_size_;
+	}
+
+	[[nodiscard]] bool eof() const noexcept{
+		return position_ >= file_.size();
+	}
+
+	/**
+	 * @brief 移动到 offset 所在的窗口起点，默认构造的读取器上无效果
+	 */
+	void seek(const std::uint64_t offset) noexcept{
+		if(!chunk_size_) return;
+		position_ = std::min(offset, file_.size()) / chunk_size_ * chunk_size_;
+	}
+
+	/**
+	 * @brief 映射下一窗口，上一次返回的 span 随即失效
+	 * @return 到达末尾时为空 span；映射失败时为 std::nullopt
+	 */
+	[[nodiscard]] std::optional<std::span<const std::byte>> next() noexcept{
+		this->release_window_();
+		if(this->eof()) return std::span<const std::byte>{};
+
+		const auto length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size_, file_.size() - position_));
+		window_ = file_.map(position_, length);
+		if(!window_) return std::nullopt;
+		window_size_ = length;
+
+		mapped_file_detail::file_handle::advise(window_, window_size_, map_advice::sequential);
+		position_ += length;
+		if(!this->eof()){
+			file_.prefetch(position_, static_cast<std::size_t>(std::min<std::uint64_t>(chunk_size_, file_.size() - position_)));
+		}
+
+		return std::span{static_cast<const std::byte*>(window_), window_size_};
+	}
+
+	/**
+	 * @brief 依次以每个窗口调用 fn(std::span<const std::byte> chunk, std::uint64_t offset)
+	 * @return 是否读到文件末尾
+	 */
+	template <std::invocable<std::span<const std::byte>, std::uint64_t> Fn>
+	bool for_each_chunk(Fn fn){
+		while(!this->eof()){
+			const std::uint64_t offset = position_;
+			const auto chunk = this->next();
+			if(!chunk) return false;
+			std::invoke(fn, *chunk, offset);
+		}
+		this->release_window_();
+		return true;
+	}
+};
+}
@@ -0,0 +1,370 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+#ifdef __AVX2__
+#define MO_YANXI_INTERSECTION_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+export module mo_yanxi.math.intersection_batch;
+
+export import mo_yanxi.math.intersection;
+export import mo_yanxi.math.vector2_batch;
+import std;
+
+namespace mo_yanxi::math{
+/**
+ * @brief 以 SoA 形式存放的线段集合视图，第 i 条线段为 src[i] -> dst[i]
+ */
+export
+struct segment_soa_cspan{
+	vec2_soa_cspan src;
+	vec2_soa_cspan dst;
+
+	[[nodiscard]] FORCE_INLINE constexpr std::size_t size() const noexcept{
+		assert(src.size() == dst.size());
+		return src.size();
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr bool empty() const noexcept{
+		return src.empty();
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr std::pair<vec2, vec2> operator[](std::size_t index) const noexcept{
+		return {src[index], dst[index]};
+	}
+
+	[[nodiscard]] constexpr segment_soa_cspan subspan(std::size_t offset, std::size_t count = std::dynamic_extent) const noexcept{
+		return {src.subspan(offset, count), dst.subspan(offset, count)};
+	}
+};
+
+/**
+ * @brief 拥有存储的 SoA 线段集合
+ */
+export
+class segment_batch{
+	vec2_batch src_{};
+	vec2_batch dst_{};
+
+public:
+	[[nodiscard]] segment_batch() = default;
+
+	[[nodiscard]] std::size_t size() const noexcept{
+		return src_.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return src_.empty();
+	}
+
+	void reserve(std::size_t count){
+		src_.reserve(count);
+		dst_.reserve(count);
+	}
+
+	void clear() noexcept{
+		src_.clear();
+		dst_.clear();
+	}
+
+	void push_back(vec2 src, vec2 dst){
+		src_.push_back(src);
+		dst_.push_back(dst);
+	}
+
+	/**
+	 * @brief 追加闭合多边形的全部边 v[i] -> v[i + 1]，末点连回首点
+	 */
+	template <std::ranges::forward_range Rng>
+		requires std::convertible_to<std::ranges::range_reference_t<Rng>, vec2>
+	void push_polygon(Rng&& vertices){
+		auto first = std::ranges::begin(vertices);
+		const auto last = std::ranges::end(vertices);
+		if(first == last) return;
+
+		const vec2 head = *first;
+		vec2 prev = head;
+		for(++first; first != last; ++first){
+			const vec2 cur = *first;
+			this->push_back(prev, cur);
+			prev = cur;
+		}
+		this->push_back(prev, head);
+	}
+
+	/**
+	 * @brief 追加 quad 等以 [0, 4) 下标访问顶点的四边形的四条边
+	 */
+	template <typename Quad>
+		requires requires(const Quad& quad){
+			{ quad[0] } -> std::convertible_to<vec2>;
+		}
+	void push_quad(const Quad& quad){
+		this->push_polygon(std::array<vec2, 4>{quad[0], quad[1], quad[2], quad[3]});
+	}
+
+	[[nodiscard]] segment_soa_cspan span() const noexcept{
+		return {src_.span(), dst_.span()};
+	}
+
+	explicit(false) operator segment_soa_cspan() const noexcept{
+		return span();
+	}
+};
+
+/**
+ * @brief 批量求交中最近的命中：线段下标与查询上的参数 t
+ *
+ * 射线查询的 t 以 ray_dir 为单位长度，线段查询的 t 位于 [0, 1]；无命中时 index 为 npos。
+ */
+export
+struct segment_hit{
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	std::size_t index{npos};
+	float t{std::numeric_limits<float>::infinity()};
+
+	constexpr explicit operator bool() const noexcept{
+		return index != npos;
+	}
+};
+
+/**
+ * @brief 容纳 segment_count 条线段命中位所需的 std::uint64_t 个数
+ */
+export
+[[nodiscard]] constexpr std::size_t hit_mask_word_count(std::size_t segment_count) noexcept{
+	return (segment_count + 63) / 64;
+}
+
+#ifdef MO_YANXI_INTERSECTION_BATCH_AVX2
+template <typename OnHit>
+FORCE_INLINE void emit_hits_x8(std::size_t base, unsigned bits, __m256 t, OnHit& on_hit){
+	if(!bits) return;
+	alignas(32) float ts[8];
+	_mm256_store_ps(ts, t);
+	for(; bits; bits &= bits - 1){
+		const unsigned lane = std::countr_zero(bits);
+		on_hit(base + lane, ts[lane]);
+	}
+}
+#endif
+
+/**
+ * @brief 射线参数：由 ray_seg_intersection 的交点反推，用于平行/共线分支
+ */
+FORCE_INLINE float ray_param_of(const vec2 ray_cap, const vec2 ray_dir, const vec2 pos) noexcept{
+	const float len2 = ray_dir.length2();
+	return len2 == 0 ? 0.f : (pos - ray_cap).dot(ray_dir) / len2;
+}
+
+/**
+ * @brief 射线与每条线段求交，对每个命中调用 on_hit(index, t)
+ *
+ * 非平行的线段按 ray_seg_intersection 相同的运算逐 8 条并行测试；
+ * 平行（|denom| <= 1e-6）的线段较少，逐条交给 ray_seg_intersection 处理共线情况。
+ */
+template <typename OnHit>
+void ray_segments_kernel(const vec2 ray_cap, const vec2 ray_dir, const segment_soa_cspan segments, OnHit& on_hit){
+	const std::size_t count = segments.size();
+	std::size_t i = 0;
+
+	const auto parallel_fallback = [&](std::size_t index){
+		const auto [v1, v2] = segments[index];
+		if(const auto rst = math::ray_seg_intersection(ray_cap, ray_dir, v1, v2)){
+			on_hit(index, math::ray_param_of(ray_cap, ray_dir, rst.pos));
+		}
+	};
+
+#ifdef MO_YANXI_INTERSECTION_BATCH_AVX2
+	const __m256 cx = _mm256_set1_ps(ray_cap.x);
+	const __m256 cy = _mm256_set1_ps(ray_cap.y);
+	const __m256 rdx = _mm256_set1_ps(ray_dir.x);
+	const __m256 rdy = _mm256_set1_ps(ray_dir.y);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.f);
+	const __m256 epsilon = _mm256_set1_ps(1e-6f);
+	const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+	for(; i + 8 <= count; i += 8){
+		const __m256 sx = _mm256_loadu_ps(segments.src.x.data() + i);
+		const __m256 sy = _mm256_loadu_ps(segments.src.y.data() + i);
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(segments.dst.x.data() + i), sx);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(segments.dst.y.data() + i), sy);
+
+		const __m256 denom = _mm256_sub_ps(_mm256_mul_ps(dx, rdy), _mm256_mul_ps(dy, rdx));
+		const __m256 aox = _mm256_sub_ps(sx, cx);
+		const __m256 aoy = _mm256_sub_ps(sy, cy);
+		const __m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(aox, dy), _mm256_mul_ps(aoy, dx)), denom);
+		const __m256 s = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(rdx, aoy), _mm256_mul_ps(rdy, aox)), denom);
+
+		const __m256 crossing = _mm256_cmp_ps(_mm256_and_ps(denom, abs_mask), epsilon, _CMP_GT_OQ);
+		__m256 hit = _mm256_and_ps(crossing, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(s, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(s, one, _CMP_LE_OQ));
+
+		math::emit_hits_x8(i, static_cast<unsigned>(_mm256_movemask_ps(hit)), t, on_hit);
+
+		for(unsigned parallel = ~static_cast<unsigned>(_mm256_movemask_ps(crossing)) & 0xFFu; parallel; parallel &= parallel - 1){
+			parallel_fallback(i + std::countr_zero(parallel));
+		}
+	}
+#endif
+
+	for(; i < count; ++i){
+		const auto [v1, v2] = segments[i];
+		const auto seg_dir = v2 - v1;
+		const auto denom = seg_dir.cross(ray_dir);
+		if(math::abs(denom) > 1e-6f){
+			const auto ao = v1 - ray_cap;
+			const auto t = ao.cross(seg_dir) / denom;
+			const auto s = ray_dir.cross(ao) / denom;
+			if(t >= 0.0f && s >= 0.0f && s <= 1.0f){
+				on_hit(i, t);
+			}
+		} else{
+			parallel_fallback(i);
+		}
+	}
+}
+
+/**
+ * @brief 线段 p1 -> p2 与每条线段求交，对每个命中调用 on_hit(index, ua)，判定与 intersect_segments 一致
+ */
+template <typename OnHit>
+void segment_segments_kernel(const vec2 p1, const vec2 p2, const segment_soa_cspan segments, OnHit& on_hit){
+	const std::size_t count = segments.size();
+	std::size_t i = 0;
+
+	const float dx1 = p2.x - p1.x;
+	const float dy1 = p2.y - p1.y;
+
+#ifdef MO_YANXI_INTERSECTION_BATCH_AVX2
+	const __m256 x1 = _mm256_set1_ps(p1.x);
+	const __m256 y1 = _mm256_set1_ps(p1.y);
+	const __m256 vdx1 = _mm256_set1_ps(dx1);
+	const __m256 vdy1 = _mm256_set1_ps(dy1);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.f);
+
+	for(; i + 8 <= count; i += 8){
+		const __m256 x3 = _mm256_loadu_ps(segments.src.x.data() + i);
+		const __m256 y3 = _mm256_loadu_ps(segments.src.y.data() + i);
+		const __m256 dx2 = _mm256_sub_ps(_mm256_loadu_ps(segments.dst.x.data() + i), x3);
+		const __m256 dy2 = _mm256_sub_ps(_mm256_loadu_ps(segments.dst.y.data() + i), y3);
+
+		const __m256 d = _mm256_sub_ps(_mm256_mul_ps(dy2, vdx1), _mm256_mul_ps(dx2, vdy1));
+		const __m256 yd = _mm256_sub_ps(y1, y3);
+		const __m256 xd = _mm256_sub_ps(x1, x3);
+		const __m256 ua = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(dx2, yd), _mm256_mul_ps(dy2, xd)), d);
+		const __m256 ub = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(vdx1, yd), _mm256_mul_ps(vdy1, xd)), d);
+
+		__m256 hit = _mm256_cmp_ps(d, zero, _CMP_NEQ_OQ);
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(ua, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(ua, one, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(ub, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(ub, one, _CMP_LE_OQ));
+
+		math::emit_hits_x8(i, static_cast<unsigned>(_mm256_movemask_ps(hit)), ua, on_hit);
+	}
+#endif
+
+	for(; i < count; ++i){
+		const float x3 = segments.src.x[i];
+		const float y3 = segments.src.y[i];
+		const float dx2 = segments.dst.x[i] - x3;
+		const float dy2 = segments.dst.y[i] - y3;
+
+		// 以取反的有序比较拒绝 NaN，与向量部分的 _CMP_*_OQ 一致
+		const float d = dy2 * dx1 - dx2 * dy1;
+		if(!(d != 0)) continue;
+
+		const float yd = p1.y - y3;
+		const float xd = p1.x - x3;
+		const float ua = (dx2 * yd - dy2 * xd) / d;
+		if(!(ua >= 0 && ua <= 1)) continue;
+
+		const float ub = (dx1 * yd - dy1 * xd) / d;
+		if(!(ub >= 0 && ub <= 1)) continue;
+
+		on_hit(i, ua);
+	}
+}
+
+/**
+ * @brief 汇总命中：写入命中位并保留 t 最小者，t 相同时取下标较小者
+ */
+struct nearest_hit_collector{
+	std::span<std::uint64_t> hit_mask;
+	segment_hit nearest{};
+
+	[[nodiscard]] nearest_hit_collector(std::span<std::uint64_t> hit_mask, std::size_t segment_count) noexcept
+		: hit_mask(hit_mask){
+		assert(hit_mask.empty() || hit_mask.size() >= math::hit_mask_word_count(segment_count));
+		(void)segment_count;
+		std::ranges::fill(hit_mask, std::uint64_t{});
+	}
+
+	FORCE_INLINE void operator()(std::size_t index, float t) noexcept{
+		if(!hit_mask.empty()){
+			hit_mask[index / 64] |= std::uint64_t{1} << (index % 64);
+		}
+		if(t < nearest.t || (t == nearest.t && index < nearest.index)){
+			nearest = {index, t};
+		}
+	}
+};
+
+/**
+ * @brief 一条射线与一组线段求交，返回最近的命中
+ *
+ * 逐条的判定与 ray_seg_intersection 一致。hit_mask 非空时需至少 hit_mask_word_count(segments.size()) 个字，
+ * 第 i 条线段命中时置位第 i 位。
+ */
+export
+[[nodiscard]] inline segment_hit ray_seg_intersection(
+	const vec2 ray_cap, const vec2 ray_dir,
+	const segment_soa_cspan segments, std::span<std::uint64_t> hit_mask = {}) noexcept{
+	nearest_hit_collector collector{hit_mask, segments.size()};
+	math::ray_segments_kernel(ray_cap, ray_dir, segments, collector);
+	return collector.nearest;
+}
+
+/**
+ * @brief 线段 p1 -> p2 与一组线段求交，返回 ua 最小（最靠近 p1）的命中
+ *
+ * 逐条的判定与 intersect_segments 一致，hit_mask 的约定同 ray_seg_intersection。
+ */
+export
+[[nodiscard]] inline segment_hit intersect_segments(
+	const vec2 p1, const vec2 p2,
+	const segment_soa_cspan segments, std::span<std::uint64_t> hit_mask = {}) noexcept{
+	nearest_hit_collector collector{hit_mask, segments.size()};
+	math::segment_segments_kernel(p1, p2, segments, collector);
+	return collector.nearest;
+}
+
+/**
+ * @brief 两组线段（如两个多边形的边集）两两求交，对每个交点调用 fn(lhs_index, rhs_index, point)
+ *
+ * lhs 中的每条线段对整组 rhs 做一次批量测试。
+ * @return 交点个数
+ */
+export
+template <std::invocable<std::size_t, std::size_t, vec2> Fn>
+std::size_t intersect_segments(const segment_soa_cspan lhs, const segment_soa_cspan rhs, Fn fn){
+	std::size_t hits{};
+	for(std::size_t i = 0; i < lhs.size(); ++i){
+		const auto [p1, p2] = lhs[i];
+		const vec2 dir = p2 - p1;
+		auto on_hit = [&](std::size_t j, float ua){
+			++hits;
+			std::invoke(fn, i, j, vec2{p1.x + dir.x * ua, p1.y + dir.y * ua});
+		};
+		math::segment_segments_kernel(p1, p2, rhs, on_hit);
+	}
+	return hits;
+}
+}
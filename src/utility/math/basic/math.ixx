@@ -3,6 +3,11 @@ module;
 #include "mo_yanxi/adapted_attributes.hpp"
 #include <cassert>
 
+#ifdef __AVX2__
+#define MO_YANXI_MATH_AVX2
+#include <immintrin.h>
+#endif
+
 #define MATH_ATTR CONST_FN FORCE_INLINE inline
 #define MATH_ASSERT(expr) CHECKED_ASSUME(expr)
 
@@ -740,6 +745,205 @@ constexpr T sqrt(const T x) noexcept{
 	}
 }
 
+#ifdef MO_YANXI_MATH_AVX2
+/**
+ * @brief reduce_angle_pi 的 8 路版本，运算顺序与标量一致
+ *
+ * 商超出 int32 范围或输入含 NaN 时返回 false，调用方整块退回标量路径。
+ */
+FORCE_INLINE bool reduce_angle_pi_x8(const __m256 x, __m256& x_reduced, __m256& sign_mask) noexcept{
+	const __m256 half = _mm256_or_ps(_mm256_and_ps(x, _mm256_set1_ps(-0.f)), _mm256_set1_ps(0.5f));
+#ifdef __FMA__
+	const __m256 q = _mm256_fmadd_ps(x, _mm256_set1_ps(std::numbers::inv_pi_v<float>), half);
+#else
+	// 两个 float 的乘积在 double 中精确，再加 ±0.5 仍可精确表示，因此只有转回 float 时的一次舍入，与 fma 一致
+	const __m256d inv_pi = _mm256_set1_pd(static_cast<double>(std::numbers::inv_pi_v<float>));
+	const __m256d lo = _mm256_add_pd(
+		_mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), inv_pi),
+		_mm256_cvtps_pd(_mm256_castps256_ps128(half)));
+	const __m256d hi = _mm256_add_pd(
+		_mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), inv_pi),
+		_mm256_cvtps_pd(_mm256_extractf128_ps(half, 1)));
+	const __m256 q = _mm256_set_m128(_mm256_cvtpd_ps(hi), _mm256_cvtpd_ps(lo));
+#endif
+
+	const __m256i quotient = _mm256_cvttps_epi32(q);
+	if(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(quotient, _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min())))) != 0){
+		return false;
+	}
+
+	x_reduced = _mm256_sub_ps(x, _mm256_mul_ps(_mm256_cvtepi32_ps(quotient), _mm256_set1_ps(std::numbers::pi_v<float>)));
+	sign_mask = _mm256_castsi256_ps(_mm256_slli_epi32(quotient, 31));
+	return true;
+}
+
+FORCE_INLINE __m256 poly_sin_impl_x8(const __m256 x2) noexcept{
+	__m256 r = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(0.00833216076)), _mm256_mul_ps(x2, _mm256_set1_ps(static_cast<float>(-0.000195152959))));
+	r = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(-0.166666546)), _mm256_mul_ps(x2, r));
+	return _mm256_add_ps(_mm256_set1_ps(1.f), _mm256_mul_ps(x2, r));
+}
+
+FORCE_INLINE __m256 poly_cos_impl_x8(const __m256 x2) noexcept{
+	__m256 r = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(-0.00138873163)), _mm256_mul_ps(x2, _mm256_set1_ps(static_cast<float>(0.0000244331571))));
+	r = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(0.0416664568)), _mm256_mul_ps(x2, r));
+	r = _mm256_add_ps(_mm256_set1_ps(-0.5f), _mm256_mul_ps(x2, r));
+	return _mm256_add_ps(_mm256_set1_ps(1.f), _mm256_mul_ps(x2, r));
+}
+
+/**
+ * @brief atn 的 4 路 double 版本
+ */
+FORCE_INLINE __m256d atn_x4(const __m256d i) noexcept{
+	const __m256d sign_bit = _mm256_set1_pd(-0.0);
+	const __m256d one = _mm256_set1_pd(1.0);
+	const __m256d n = _mm256_andnot_pd(sign_bit, i);
+	const __m256d c = _mm256_div_pd(_mm256_sub_pd(n, one), _mm256_add_pd(n, one));
+	const __m256d c2 = _mm256_mul_pd(c, c);
+	const __m256d c3 = _mm256_mul_pd(c, c2);
+	const __m256d c5 = _mm256_mul_pd(c3, c2);
+	const __m256d c7 = _mm256_mul_pd(c5, c2);
+	const __m256d c9 = _mm256_mul_pd(c7, c2);
+	const __m256d c11 = _mm256_mul_pd(c9, c2);
+
+	__m256d r = _mm256_mul_pd(_mm256_set1_pd(0.99997726), c);
+	r = _mm256_sub_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.33262347), c3));
+	r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.19354346), c5));
+	r = _mm256_sub_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.11643287), c7));
+	r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.05265332), c9));
+	r = _mm256_sub_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.0117212), c11));
+	r = _mm256_add_pd(_mm256_set1_pd(std::numbers::pi * 0.25), r);
+	return _mm256_or_pd(_mm256_andnot_pd(sign_bit, r), _mm256_and_pd(sign_bit, i));
+}
+
+/**
+ * @brief atan2 的 8 路版本，各分支以掩码混合
+ */
+FORCE_INLINE __m256 atan2_x8(const __m256 y, __m256 x) noexcept{
+	const __m256 zero = _mm256_setzero_ps();
+	__m256 n = _mm256_div_ps(y, x);
+
+	const __m256 nan_mask = _mm256_cmp_ps(n, n, _CMP_UNORD_Q);
+	const __m256 nan_fix = _mm256_blendv_ps(_mm256_set1_ps(-1.f), _mm256_set1_ps(1.f), _mm256_cmp_ps(y, x, _CMP_EQ_OQ));
+	n = _mm256_blendv_ps(n, nan_fix, nan_mask);
+	const __m256 inf_mask = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.f), n), _mm256_set1_ps(std::numeric_limits<float>::infinity()), _CMP_EQ_OQ);
+	x = _mm256_andnot_ps(inf_mask, x);
+
+	const __m256 a = _mm256_set_m128(
+		_mm256_cvtpd_ps(math::atn_x4(_mm256_cvtps_pd(_mm256_extractf128_ps(n, 1)))),
+		_mm256_cvtpd_ps(math::atn_x4(_mm256_cvtps_pd(_mm256_castps256_ps128(n)))));
+
+	const __m256 v_pi = _mm256_set1_ps(std::numbers::pi_v<float>);
+	const __m256 v_pi_half = _mm256_set1_ps(pi_half_v<float>);
+	const __m256 x_gt = _mm256_cmp_ps(x, zero, _CMP_GT_OQ);
+	const __m256 x_lt = _mm256_cmp_ps(x, zero, _CMP_LT_OQ);
+
+	const __m256 on_x_neg = _mm256_blendv_ps(_mm256_sub_ps(a, v_pi), _mm256_add_ps(a, v_pi), _mm256_cmp_ps(y, zero, _CMP_GE_OQ));
+	const __m256 on_x = _mm256_blendv_ps(on_x_neg, a, x_gt);
+
+	__m256 on_y = _mm256_add_ps(x, y);
+	on_y = _mm256_blendv_ps(on_y, _mm256_sub_ps(x, v_pi_half), _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+	on_y = _mm256_blendv_ps(on_y, _mm256_add_ps(x, v_pi_half), _mm256_cmp_ps(y, zero, _CMP_GT_OQ));
+
+	return _mm256_blendv_ps(on_y, on_x, _mm256_or_ps(x_gt, x_lt));
+}
+#endif
+
+template <bool WriteCos, bool WriteSin>
+void cos_sin_kernel(std::span<const float> radians, float* out_cos, float* out_sin) noexcept{
+	const std::size_t count = radians.size();
+	std::size_t i = 0;
+
+	const auto scalar = [&](std::size_t first, std::size_t last){
+		for(; first < last; ++first){
+			const auto [c, s] = math::cos_sin(radians[first]);
+			if constexpr(WriteCos) out_cos[first] = c;
+			if constexpr(WriteSin) out_sin[first] = s;
+		}
+	};
+
+#ifdef MO_YANXI_MATH_AVX2
+	for(; i + 8 <= count; i += 8){
+		__m256 x_reduced, sign_mask;
+		if(!math::reduce_angle_pi_x8(_mm256_loadu_ps(radians.data() + i), x_reduced, sign_mask)) [[unlikely]] {
+			scalar(i, i + 8);
+			continue;
+		}
+
+		const __m256 x2 = _mm256_mul_ps(x_reduced, x_reduced);
+		if constexpr(WriteCos){
+			_mm256_storeu_ps(out_cos + i, _mm256_xor_ps(math::poly_cos_impl_x8(x2), sign_mask));
+		}
+		if constexpr(WriteSin){
+			_mm256_storeu_ps(out_sin + i, _mm256_mul_ps(_mm256_xor_ps(x_reduced, sign_mask), math::poly_sin_impl_x8(x2)));
+		}
+	}
+#endif
+
+	scalar(i, count);
+}
+
+/**
+ * @brief 逐元素计算 cos 与 sin，结果与标量 math::cos_sin 按位一致
+ *
+ * 启用 AVX2 时每次处理 8 个元素；输出可以与输入为同一数组。
+ * 按位一致要求编译器不将标量路径中的乘加收缩为 FMA（默认的 avx2 构建满足此条件）。
+ * 与标量版本相同，输入的绝对值需小于 π·2^63，否则角度约简中的整数转换溢出。
+ */
+export
+inline void cos_sin(std::span<const float> radians, std::span<float> out_cos, std::span<float> out_sin) noexcept{
+	assert(radians.size() == out_cos.size() && radians.size() == out_sin.size());
+	math::cos_sin_kernel<true, true>(radians, out_cos.data(), out_sin.data());
+}
+
+export
+inline void sin(std::span<const float> radians, std::span<float> out) noexcept{
+	assert(radians.size() == out.size());
+	math::cos_sin_kernel<false, true>(radians, nullptr, out.data());
+}
+
+export
+inline void cos(std::span<const float> radians, std::span<float> out) noexcept{
+	assert(radians.size() == out.size());
+	math::cos_sin_kernel<true, false>(radians, out.data(), nullptr);
+}
+
+/**
+ * @brief 逐元素计算 atan2(y, x)，结果与标量 math::atan2 按位一致
+ */
+export
+inline void atan2(std::span<const float> y, std::span<const float> x, std::span<float> out) noexcept{
+	assert(y.size() == x.size() && y.size() == out.size());
+	const std::size_t count = y.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_MATH_AVX2
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(out.data() + i, math::atan2_x8(_mm256_loadu_ps(y.data() + i), _mm256_loadu_ps(x.data() + i)));
+	}
+#endif
+
+	for(; i < count; ++i){
+		out[i] = math::atan2(y[i], x[i]);
+	}
+}
+
+export
+inline void sqrt(std::span<const float> values, std::span<float> out) noexcept{
+	assert(values.size() == out.size());
+	const std::size_t count = values.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_MATH_AVX2
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(out.data() + i, _mm256_sqrt_ps(_mm256_loadu_ps(values.data() + i)));
+	}
+#endif
+
+	for(; i < count; ++i){
+		out[i] = std::sqrt(values[i]);
+	}
+}
+
 export
 template <typename T1, typename T2>
 MATH_ATTR constexpr T2 map(
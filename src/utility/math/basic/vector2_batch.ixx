@@ -0,0 +1,434 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+#ifdef __AVX2__
+#define MO_YANXI_VEC2_BATCH_AVX2
+#include <immintrin.h>
+#endif
+
+export module mo_yanxi.math.vector2_batch;
+
+export import mo_yanxi.math.vector2;
+export import mo_yanxi.math.trans2;
+export import mo_yanxi.math.matrix3;
+export import mo_yanxi.math.rect_ortho;
+import mo_yanxi.math;
+import std;
+
+namespace mo_yanxi::math{
+/**
+ * @brief 以 x[] / y[] 两个数组表示的点集视图（SoA）
+ */
+export
+template <typename T>
+struct basic_vec2_soa_span{
+	std::span<T> x;
+	std::span<T> y;
+
+	[[nodiscard]] FORCE_INLINE constexpr std::size_t size() const noexcept{
+		assert(x.size() == y.size());
+		return x.size();
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr bool empty() const noexcept{
+		return x.empty();
+	}
+
+	[[nodiscard]] FORCE_INLINE constexpr vec2 operator[](std::size_t index) const noexcept{
+		return {x[index], y[index]};
+	}
+
+	FORCE_INLINE constexpr void set(std::size_t index, vec2 value) const noexcept requires (!std::is_const_v<T>){
+		x[index] = value.x;
+		y[index] = value.y;
+	}
+
+	[[nodiscard]] constexpr basic_vec2_soa_span subspan(std::size_t offset, std::size_t count = std::dynamic_extent) const noexcept{
+		return {x.subspan(offset, count), y.subspan(offset, count)};
+	}
+
+	constexpr explicit(false) operator basic_vec2_soa_span<const T>() const noexcept requires (!std::is_const_v<T>){
+		return {x, y};
+	}
+};
+
+export using vec2_soa_span = basic_vec2_soa_span<float>;
+export using vec2_soa_cspan = basic_vec2_soa_span<const float>;
+
+/**
+ * @brief 拥有存储的 SoA 点集，x 与 y 分别连续存放
+ */
+export
+class vec2_batch{
+	std::vector<float> x_{};
+	std::vector<float> y_{};
+
+public:
+	[[nodiscard]] vec2_batch() = default;
+
+	[[nodiscard]] explicit vec2_batch(std::size_t count) : x_(count), y_(count){
+	}
+
+	template <std::ranges::input_range Rng>
+		requires std::convertible_to<std::ranges::range_reference_t<Rng>, vec2>
+	[[nodiscard]] explicit vec2_batch(Rng&& points){
+		if constexpr(std::ranges::sized_range<Rng>){
+			this->reserve(std::ranges::size(points));
+		}
+		for(const vec2 p : points){
+			this->push_back(p);
+		}
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept{
+		return x_.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept{
+		return x_.empty();
+	}
+
+	void reserve(std::size_t count){
+		x_.reserve(count);
+		y_.reserve(count);
+	}
+
+	void resize(std::size_t count){
+		x_.resize(count);
+		y_.resize(count);
+	}
+
+	void clear() noexcept{
+		x_.clear();
+		y_.clear();
+	}
+
+	void push_back(vec2 point){
+		x_.push_back(point.x);
+		y_.push_back(point.y);
+	}
+
+	[[nodiscard]] vec2 operator[](std::size_t index) const noexcept{
+		return {x_[index], y_[index]};
+	}
+
+	void set(std::size_t index, vec2 point) noexcept{
+		x_[index] = point.x;
+		y_[index] = point.y;
+	}
+
+	[[nodiscard]] std::span<float> x() noexcept{ return x_; }
+	[[nodiscard]] std::span<const float> x() const noexcept{ return x_; }
+	[[nodiscard]] std::span<float> y() noexcept{ return y_; }
+	[[nodiscard]] std::span<const float> y() const noexcept{ return y_; }
+
+	[[nodiscard]] vec2_soa_span span() noexcept{
+		return {x_, y_};
+	}
+
+	[[nodiscard]] vec2_soa_cspan span() const noexcept{
+		return {x_, y_};
+	}
+
+	explicit(false) operator vec2_soa_span() noexcept{
+		return span();
+	}
+
+	explicit(false) operator vec2_soa_cspan() const noexcept{
+		return span();
+	}
+};
+
+/**
+ * @brief 逐点计算 (x, y) -> (m00 (x + px) + m01 (y + py) + tx, m10 (x + px) + m11 (y + py) + ty)
+ *
+ * 所有仿射核均归约到此。AVX2 路径不使用 FMA，运算顺序与标量路径一致；dst 可以与 src 相同。
+ */
+template <bool PreTranslate>
+void affine_kernel(vec2_soa_cspan src, vec2_soa_span dst,
+	float m00, float m01, float m10, float m11, float px, float py, float tx, float ty) noexcept{
+	assert(src.size() == dst.size());
+	const std::size_t count = src.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	const __m256 a00 = _mm256_set1_ps(m00);
+	const __m256 a01 = _mm256_set1_ps(m01);
+	const __m256 a10 = _mm256_set1_ps(m10);
+	const __m256 a11 = _mm256_set1_ps(m11);
+	const __m256 vpx = _mm256_set1_ps(px);
+	const __m256 vpy = _mm256_set1_ps(py);
+	const __m256 vtx = _mm256_set1_ps(tx);
+	const __m256 vty = _mm256_set1_ps(ty);
+
+	for(; i + 8 <= count; i += 8){
+		__m256 x = _mm256_loadu_ps(src.x.data() + i);
+		__m256 y = _mm256_loadu_ps(src.y.data() + i);
+		if constexpr(PreTranslate){
+			x = _mm256_add_ps(x, vpx);
+			y = _mm256_add_ps(y, vpy);
+		}
+		const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a00, x), _mm256_mul_ps(a01, y)), vtx);
+		const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a10, x), _mm256_mul_ps(a11, y)), vty);
+		_mm256_storeu_ps(dst.x.data() + i, rx);
+		_mm256_storeu_ps(dst.y.data() + i, ry);
+	}
+#endif
+
+	for(; i < count; ++i){
+		float x = src.x[i];
+		float y = src.y[i];
+		if constexpr(PreTranslate){
+			x += px;
+			y += py;
+		}
+		dst.x[i] = (m00 * x + m01 * y) + tx;
+		dst.y[i] = (m10 * x + m11 * y) + ty;
+	}
+}
+
+template <typename Op>
+FORCE_INLINE void componentwise_kernel(vec2_soa_cspan src, vec2_soa_span dst, vec2 operand) noexcept{
+	assert(src.size() == dst.size());
+	const std::size_t count = src.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	const __m256 ox = _mm256_set1_ps(operand.x);
+	const __m256 oy = _mm256_set1_ps(operand.y);
+	for(; i + 8 <= count; i += 8){
+		_mm256_storeu_ps(dst.x.data() + i, Op::simd(_mm256_loadu_ps(src.x.data() + i), ox));
+		_mm256_storeu_ps(dst.y.data() + i, Op::simd(_mm256_loadu_ps(src.y.data() + i), oy));
+	}
+#endif
+
+	for(; i < count; ++i){
+		dst.x[i] = Op::scalar(src.x[i], operand.x);
+		dst.y[i] = Op::scalar(src.y[i], operand.y);
+	}
+}
+
+struct add_op{
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	FORCE_INLINE static __m256 simd(__m256 a, __m256 b) noexcept{ return _mm256_add_ps(a, b); }
+#endif
+	FORCE_INLINE static float scalar(float a, float b) noexcept{ return a + b; }
+};
+
+struct mul_op{
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	FORCE_INLINE static __m256 simd(__m256 a, __m256 b) noexcept{ return _mm256_mul_ps(a, b); }
+#endif
+	FORCE_INLINE static float scalar(float a, float b) noexcept{ return a * b; }
+};
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+template <bool IsMin>
+FORCE_INLINE float horizontal_extreme(__m256 v) noexcept{
+	__m128 r = IsMin
+		? _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1))
+		: _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	const __m128 s1 = _mm_movehl_ps(r, r);
+	r = IsMin ? _mm_min_ps(r, s1) : _mm_max_ps(r, s1);
+	const __m128 s2 = _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 1, 1, 1));
+	r = IsMin ? _mm_min_ss(r, s2) : _mm_max_ss(r, s2);
+	return _mm_cvtss_f32(r);
+}
+#endif
+
+/**
+ * @brief 单个分量数组的最小与最大值
+ */
+std::pair<float, float> minmax_kernel(std::span<const float> values) noexcept{
+	assert(!values.empty());
+	const std::size_t count = values.size();
+	float min = values[0];
+	float max = values[0];
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	if(count >= 8){
+		__m256 vmin = _mm256_loadu_ps(values.data());
+		__m256 vmax = vmin;
+		for(i = 8; i + 8 <= count; i += 8){
+			const __m256 v = _mm256_loadu_ps(values.data() + i);
+			vmin = _mm256_min_ps(vmin, v);
+			vmax = _mm256_max_ps(vmax, v);
+		}
+		min = horizontal_extreme<true>(vmin);
+		max = horizontal_extreme<false>(vmax);
+	}
+#endif
+
+	for(; i < count; ++i){
+		min = std::min(min, values[i]);
+		max = std::max(max, values[i]);
+	}
+	return {min, max};
+}
+
+/**
+ * @brief 局部坐标到父坐标：先旋转 trans.rot 再平移 trans.vec，逐点等价于 vec >>= trans
+ */
+export
+template <typename Ang>
+void batch_transform(vec2_soa_cspan src, vec2_soa_span dst, const transform2<Ang>& trans) noexcept{
+	const auto [c, s] = math::cos_sin(static_cast<float>(trans.rot));
+	math::affine_kernel<false>(src, dst, c, -s, s, c, 0, 0, trans.vec.x, trans.vec.y);
+}
+
+export
+template <typename Ang>
+void batch_transform(vec2_soa_span points, const transform2<Ang>& trans) noexcept{
+	math::batch_transform(points, points, trans);
+}
+
+/**
+ * @brief 父坐标到局部坐标：先减去 trans.vec 再反向旋转，逐点等价于 vec <<= trans
+ */
+export
+template <typename Ang>
+void batch_transform_inv(vec2_soa_cspan src, vec2_soa_span dst, const transform2<Ang>& trans) noexcept{
+	const auto [c, s] = math::cos_sin(-static_cast<float>(trans.rot));
+	math::affine_kernel<true>(src, dst, c, -s, s, c, -trans.vec.x, -trans.vec.y, 0, 0);
+}
+
+export
+template <typename Ang>
+void batch_transform_inv(vec2_soa_span points, const transform2<Ang>& trans) noexcept{
+	math::batch_transform_inv(points, points, trans);
+}
+
+export
+inline void batch_translate(vec2_soa_cspan src, vec2_soa_span dst, vec2 offset) noexcept{
+	math::componentwise_kernel<add_op>(src, dst, offset);
+}
+
+export
+inline void batch_translate(vec2_soa_span points, vec2 offset) noexcept{
+	math::batch_translate(points, points, offset);
+}
+
+export
+inline void batch_scale(vec2_soa_cspan src, vec2_soa_span dst, vec2 scale) noexcept{
+	math::componentwise_kernel<mul_op>(src, dst, scale);
+}
+
+export
+inline void batch_scale(vec2_soa_span points, vec2 scale) noexcept{
+	math::batch_scale(points, points, scale);
+}
+
+/**
+ * @brief 绕原点旋转，rot 可为弧度浮点数或 angle 等可转换为弧度的类型
+ */
+export
+template <typename Ang>
+	requires std::convertible_to<Ang, float>
+void batch_rotate(vec2_soa_cspan src, vec2_soa_span dst, const Ang rot) noexcept{
+	const auto [c, s] = math::cos_sin(static_cast<float>(rot));
+	math::affine_kernel<false>(src, dst, c, -s, s, c, 0, 0, 0, 0);
+}
+
+export
+template <typename Ang>
+	requires std::convertible_to<Ang, float>
+void batch_rotate(vec2_soa_span points, const Ang rot) noexcept{
+	math::batch_rotate(points, points, rot);
+}
+
+/**
+ * @brief 逐点计算 mat * vec（齐次坐标 z = 1）
+ */
+export
+inline void batch_mul(const matrix3& mat, vec2_soa_cspan src, vec2_soa_span dst) noexcept{
+	math::affine_kernel<false>(src, dst, mat.c1.x, mat.c2.x, mat.c1.y, mat.c2.y, 0, 0, mat.c3.x, mat.c3.y);
+}
+
+export
+inline void batch_mul(const matrix3& mat, vec2_soa_span points) noexcept{
+	math::batch_mul(mat, points, points);
+}
+
+/**
+ * @brief out[i] = dot(lhs[i], rhs[i])
+ */
+export
+inline void batch_dot(vec2_soa_cspan lhs, vec2_soa_cspan rhs, std::span<float> out) noexcept{
+	assert(lhs.size() == rhs.size() && lhs.size() == out.size());
+	const std::size_t count = lhs.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	for(; i + 8 <= count; i += 8){
+		const __m256 xx = _mm256_mul_ps(_mm256_loadu_ps(lhs.x.data() + i), _mm256_loadu_ps(rhs.x.data() + i));
+		const __m256 yy = _mm256_mul_ps(_mm256_loadu_ps(lhs.y.data() + i), _mm256_loadu_ps(rhs.y.data() + i));
+		_mm256_storeu_ps(out.data() + i, _mm256_add_ps(xx, yy));
+	}
+#endif
+
+	for(; i < count; ++i){
+		out[i] = lhs.x[i] * rhs.x[i] + lhs.y[i] * rhs.y[i];
+	}
+}
+
+/**
+ * @brief out[i] = dot(points[i], direction)
+ */
+export
+inline void batch_dot(vec2_soa_cspan points, vec2 direction, std::span<float> out) noexcept{
+	assert(points.size() == out.size());
+	const std::size_t count = points.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	const __m256 dx = _mm256_set1_ps(direction.x);
+	const __m256 dy = _mm256_set1_ps(direction.y);
+	for(; i + 8 <= count; i += 8){
+		const __m256 xx = _mm256_mul_ps(_mm256_loadu_ps(points.x.data() + i), dx);
+		const __m256 yy = _mm256_mul_ps(_mm256_loadu_ps(points.y.data() + i), dy);
+		_mm256_storeu_ps(out.data() + i, _mm256_add_ps(xx, yy));
+	}
+#endif
+
+	for(; i < count; ++i){
+		out[i] = points.x[i] * direction.x + points.y[i] * direction.y;
+	}
+}
+
+/**
+ * @brief out[i] = points[i].length()
+ */
+export
+inline void batch_length(vec2_soa_cspan points, std::span<float> out) noexcept{
+	assert(points.size() == out.size());
+	const std::size_t count = points.size();
+	std::size_t i = 0;
+
+#ifdef MO_YANXI_VEC2_BATCH_AVX2
+	for(; i + 8 <= count; i += 8){
+		const __m256 x = _mm256_loadu_ps(points.x.data() + i);
+		const __m256 y = _mm256_loadu_ps(points.y.data() + i);
+		_mm256_storeu_ps(out.data() + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y))));
+	}
+#endif
+
+	for(; i < count; ++i){
+		const float x = points.x[i];
+		const float y = points.y[i];
+		out[i] = std::sqrt(x * x + y * y);
+	}
+}
+
+/**
+ * @brief 点集的轴对齐包围盒，空点集返回零矩形
+ */
+export
+[[nodiscard]] inline rect_ortho<float> get_bound(vec2_soa_cspan points) noexcept{
+	if(points.empty()) return {};
+	const auto [xmin, xmax] = math::minmax_kernel(points.x);
+	const auto [ymin, ymax] = math::minmax_kernel(points.y);
+	return rect_ortho<float>{tags::unchecked, tags::from_vertex, vec2{xmin, ymin}, vec2{xmax, ymax}};
+}
+}
@@ -0,0 +1,348 @@
+module;
+
+#include <cassert>
+#include "mo_yanxi/adapted_attributes.hpp"
+
+export module mo_yanxi.math.broadphase;
+
+export import mo_yanxi.math.quad;
+import mo_yanxi.algo.radix_sort;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+namespace mo_yanxi::math{
+/**
+ * @brief 可参与粗检测的形状：提供轴对齐包围盒，并可与同类形状做精确（分离轴）检测
+ *
+ * quad、rect_box 与 rect_box_posed 均满足。
+ */
+export
+template <typename Shape>
+concept broadphase_shape = requires(const Shape& shape){
+	{ shape.get_bound() } -> std::convertible_to<rect_ortho<float>>;
+	{ shape.overlap_exact(shape) } -> std::convertible_to<bool>;
+};
+
+export
+enum struct broadphase_mode : std::uint8_t{
+	/**
+	 * @brief 沿方差较大的轴排序并扫描，排序顺序跨帧保留，每帧以插入排序增量修正
+	 */
+	sweep_and_prune,
+
+	/**
+	 * @brief 均匀网格空间哈希，适合尺寸相近、分布稠密的形状
+	 *
+	 * 覆盖格子数超过 broadphase::max_cells_per_shape 的形状不进入网格，改为与全部形状逐一比较。
+	 */
+	uniform_grid,
+};
+
+/**
+ * @brief 一对候选下标，总有 first < second
+ */
+export
+struct broadphase_pair{
+	std::uint32_t first;
+	std::uint32_t second;
+
+	constexpr bool operator==(const broadphase_pair&) const noexcept = default;
+	constexpr auto operator<=>(const broadphase_pair&) const noexcept = default;
+};
+
+/**
+ * @brief 一组形状的粗检测：update 产生包围盒相交（含边界接触）的候选对，refine 以 overlap_exact 筛选
+ *
+ * 形状以 span 下标标识，下标在两帧之间应指向同一对象，以便扫描顺序保持近似有序；
+ * 形状数量变化时新增下标追加到末尾，被移除的下标直接丢弃。
+ *
+ * @warning 非线程安全；refine 的线程池版本仅并行执行精确检测
+ */
+export
+template <broadphase_shape Shape>
+class broadphase{
+public:
+	using index_type = std::uint32_t;
+	using shape_type = Shape;
+
+	static constexpr float default_cell_size = 64.f;
+
+	/**
+	 * @brief 网格模式下单个形状最多登记的格子数，超出者进入溢出列表
+	 */
+	static constexpr std::int64_t max_cells_per_shape = 64;
+
+private:
+	struct aabb{
+		std::array<float, 2> min;
+		std::array<float, 2> max;
+
+		[[nodiscard]] FORCE_INLINE bool overlaps(const aabb& other) const noexcept{
+			return min[0] <= other.max[0] && other.min[0] <= max[0] &&
+				min[1] <= other.max[1] && other.min[1] <= max[1];
+		}
+	};
+
+	struct grid_entry{
+		std::uint64_t cell;
+		index_type index;
+	};
+
+	broadphase_mode mode_;
+	float cell_size_;
+
+	std::vector<aabb> bounds_{};
+	std::vector<broadphase_pair> candidates_{};
+	std::vector<broadphase_pair> overlaps_{};
+
+	std::vector<index_type> order_{};
+	unsigned axis_{};
+
+	std::vector<grid_entry> grid_entries_{};
+	std::vector<index_type> oversized_{};
+	std::vector<std::uint8_t> oversized_flags_{};
+	std::vector<std::uint8_t> refine_flags_{};
+
+	FORCE_INLINE void emit_(index_type a, index_type b){
+		candidates_.push_back(a < b ? broadphase_pair{a, b} : broadphase_pair{b, a});
+	}
+
+	void update_bounds_(std::span<const Shape> shapes){
+		bounds_.resize(shapes.size());
+		for(std::size_t i = 0; i < shapes.size(); ++i){
+			const rect_ortho<float> bound = shapes[i].get_bound();
+			bounds_[i] = {{bound.get_src_x(), bound.get_src_y()}, {bound.get_end_x(), bound.get_end_y()}};
+		}
+	}
+
+	[[nodiscard]] unsigned dominant_axis_() const noexcept{
+		if(bounds_.empty()) return axis_;
+
+		std::array<double, 2> sum{}, sum2{};
+		for(const aabb& b : bounds_){
+			for(unsigned a = 0; a < 2; ++a){
+				const double c = (static_cast<double>(b.min[a]) + b.max[a]) * .5;
+				sum[a] += c;
+				sum2[a] += c * c;
+			}
+		}
+
+		const auto n = static_cast<double>(bounds_.size());
+		const double var_x = sum2[0] - sum[0] * sum[0] / n;
+		const double var_y = sum2[1] - sum[1] * sum[1] / n;
+		return var_y > var_x ? 1 : 0;
+	}
+
+	void sweep_and_prune_(){
+		const auto count = static_cast<index_type>(bounds_.size());
+
+		// 保留上一帧的顺序，仅剔除越界下标并追加新下标
+		const auto previous = static_cast<index_type>(std::min<std::size_t>(order_.size(), count));
+		std::erase_if(order_, [count](index_type i){ return i >= count; });
+		for(index_type i = previous; i < count; ++i){
+			order_.push_back(i);
+		}
+
+		const unsigned axis = this->dominant_axis_();
+		const auto key = [this, axis](index_type i){ return bounds_[i].min[axis]; };
+
+		// 首帧、换轴或新增过半时整体排序
+		if(axis != axis_ || previous * 2 < count){
+			axis_ = axis;
+			std::ranges::sort(order_, std::ranges::less{}, key);
+		} else{
+			// 相邻帧间形状位移较小，顺序近似有序，插入排序接近线性
+			for(std::size_t i = 1; i < order_.size(); ++i){
+				const index_type cur = order_[i];
+				const float cur_key = key(cur);
+				std::size_t j = i;
+				for(; j > 0 && key(order_[j - 1]) > cur_key; --j){
+					order_[j] = order_[j - 1];
+				}
+				order_[j] = cur;
+			}
+		}
+
+		for(std::size_t i = 0; i < order_.size(); ++i){
+			const index_type a = order_[i];
+			const aabb& ba = bounds_[a];
+			for(std::size_t j = i + 1; j < order_.size(); ++j){
+				const index_type b = order_[j];
+				const aabb& bb = bounds_[b];
+				if(bb.min[axis] > ba.max[axis]) break;
+				if(ba.min[axis ^ 1] <= bb.max[axis ^ 1] && bb.min[axis ^ 1] <= ba.max[axis ^ 1]){
+					this->emit_(a, b);
+				}
+			}
+		}
+	}
+
+	[[nodiscard]] std::int32_t cell_coord_(float v) const noexcept{
+		constexpr float limit = static_cast<float>(1 << 30);
+		return static_cast<std::int32_t>(std::clamp(std::floor(v / cell_size_), -limit, limit));
+	}
+
+	[[nodiscard]] static std::uint64_t cell_key_(std::int32_t x, std::int32_t y) noexcept{
+		return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32 | static_cast<std::uint32_t>(y);
+	}
+
+	void uniform_grid_(){
+		const auto count = static_cast<index_type>(bounds_.size());
+		grid_entries_.clear();
+		oversized_.clear();
+		oversized_flags_.assign(count, false);
+
+		for(index_type i = 0; i < count; ++i){
+			const aabb& b = bounds_[i];
+			const std::int32_t x0 = this->cell_coord_(b.min[0]), x1 = this->cell_coord_(b.max[0]);
+			const std::int32_t y0 = this->cell_coord_(b.min[1]), y1 = this->cell_coord_(b.max[1]);
+			// 坐标已钳制在 ±2^30 以内，乘积不会溢出 int64
+			const std::int64_t cells = (static_cast<std::int64_t>(x1) - x0 + 1) * (static_cast<std::int64_t>(y1) - y0 + 1);
+			if(cells > max_cells_per_shape){
+				oversized_.push_back(i);
+				oversized_flags_[i] = true;
+				continue;
+			}
+
+			for(std::int32_t x = x0; x <= x1; ++x){
+				for(std::int32_t y = y0; y <= y1; ++y){
+					grid_entries_.push_back({broadphase::cell_key_(x, y), i});
+				}
+			}
+		}
+
+		algo::radix_sort(grid_entries_, &grid_entry::cell);
+
+		for(std::size_t first = 0; first < grid_entries_.size();){
+			const std::uint64_t cell = grid_entries_[first].cell;
+			std::size_t last = first + 1;
+			while(last < grid_entries_.size() && grid_entries_[last].cell == cell) ++last;
+
+			for(std::size_t i = first; i < last; ++i){
+				const index_type a = grid_entries_[i].index;
+				const aabb& ba = bounds_[a];
+				for(std::size_t j = i + 1; j < last; ++j){
+					const index_type b = grid_entries_[j].index;
+					const aabb& bb = bounds_[b];
+					if(!ba.overlaps(bb)) continue;
+
+					// 一对形状可能共享多个格子，只在交集左下角所在的格子中报告一次
+					const std::uint64_t owner = broadphase::cell_key_(
+						this->cell_coord_(std::max(ba.min[0], bb.min[0])),
+						this->cell_coord_(std::max(ba.min[1], bb.min[1])));
+					if(owner == cell){
+						this->emit_(a, b);
+					}
+				}
+			}
+
+			first = last;
+		}
+
+		// 溢出形状数量很少，直接与其余形状逐一比较；溢出形状之间每对只比较一次
+		for(std::size_t k = 0; k < oversized_.size(); ++k){
+			const index_type a = oversized_[k];
+			const aabb& ba = bounds_[a];
+			for(index_type b = 0; b < count; ++b){
+				if(oversized_flags_[b]) continue;
+				if(ba.overlaps(bounds_[b])) this->emit_(a, b);
+			}
+			for(std::size_t l = k + 1; l < oversized_.size(); ++l){
+				const index_type b = oversized_[l];
+				if(ba.overlaps(bounds_[b])) this->emit_(a, b);
+			}
+		}
+	}
+
+public:
+	[[nodiscard]] explicit broadphase(const broadphase_mode mode = broadphase_mode::sweep_and_prune, const float cell_size = default_cell_size)
+		: mode_(mode), cell_size_(cell_size){
+		assert(cell_size > 0);
+	}
+
+	[[nodiscard]] broadphase_mode mode() const noexcept{
+		return mode_;
+	}
+
+	/**
+	 * @brief 切换检测方式，扫描顺序与网格缓冲保留
+	 */
+	void set_mode(const broadphase_mode mode, const float cell_size = default_cell_size) noexcept{
+		assert(cell_size > 0);
+		mode_ = mode;
+		cell_size_ = cell_size;
+	}
+
+	/**
+	 * @brief 以当前帧的形状重新计算候选对
+	 */
+	void update(std::span<const Shape> shapes){
+		assert(shapes.size() < std::numeric_limits<index_type>::max());
+		candidates_.clear();
+		overlaps_.clear();
+		this->update_bounds_(shapes);
+
+		switch(mode_){
+		case broadphase_mode::sweep_and_prune : this->sweep_and_prune_(); break;
+		case broadphase_mode::uniform_grid : this->uniform_grid_(); break;
+		default : std::unreachable();
+		}
+	}
+
+	/**
+	 * @brief 包围盒相交的候选对，顺序不保证
+	 */
+	[[nodiscard]] std::span<const broadphase_pair> candidates() const noexcept{
+		return candidates_;
+	}
+
+	/**
+	 * @brief 以 overlap_exact 筛选候选对，shapes 需与最近一次 update 相同
+	 * @return 精确相交的形状对，保持候选对的相对顺序
+	 */
+	std::span<const broadphase_pair> refine(std::span<const Shape> shapes){
+		assert(shapes.size() == bounds_.size());
+		overlaps_.clear();
+		for(const broadphase_pair& p : candidates_){
+			if(shapes[p.first].overlap_exact(shapes[p.second])){
+				overlaps_.push_back(p);
+			}
+		}
+		return overlaps_;
+	}
+
+	/**
+	 * @brief 同上，候选对按块在线程池上并行检测
+	 */
+	std::span<const broadphase_pair> refine(ccur::thread_pool& pool, std::span<const Shape> shapes){
+		assert(shapes.size() == bounds_.size());
+		refine_flags_.resize(candidates_.size());
+		pool.parallel_for(0, candidates_.size(), [&, this](std::size_t begin, std::size_t end){
+			for(auto i = begin; i != end; ++i){
+				const broadphase_pair& p = candidates_[i];
+				refine_flags_[i] = shapes[p.first].overlap_exact(shapes[p.second]);
+			}
+		});
+
+		overlaps_.clear();
+		for(std::size_t i = 0; i < candidates_.size(); ++i){
+			if(refine_flags_[i]) overlaps_.push_back(candidates_[i]);
+		}
+		return overlaps_;
+	}
+
+	[[nodiscard]] std::span<const broadphase_pair> overlaps() const noexcept{
+		return overlaps_;
+	}
+
+	void clear() noexcept{
+		bounds_.clear();
+		candidates_.clear();
+		overlaps_.clear();
+		order_.clear();
+		grid_entries_.clear();
+		oversized_.clear();
+		oversized_flags_.clear();
+	}
+};
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+import mo_yanxi.encode;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    struct bad_sequence {
+        const char* name;
+        std::string bytes;
+        // 截断序列只有在后随非续字节或位于末尾时才非法
+        bool truncated;
+    };
+
+    const std::vector<bad_sequence>& bad_sequences() {
+        static const std::vector<bad_sequence> sequences{
+            {"overlong_2", "\xC0\x80", false},
+            {"overlong_2_max", "\xC1\xBF", false},
+            {"overlong_3", "\xE0\x80\x80", false},
+            {"overlong_3_max", "\xE0\x9F\xBF", false},
+            {"overlong_4", "\xF0\x80\x80\x80", false},
+            {"overlong_4_max", "\xF0\x8F\xBF\xBF", false},
+            {"surrogate_low", "\xED\xA0\x80", false},
+            {"surrogate_high", "\xED\xBF\xBF", false},
+            {"too_large", "\xF4\x90\x80\x80", false},
+            {"too_large_lead", "\xF5\x80\x80\x80", false},
+            {"invalid_byte", "\xFF", false},
+            {"lone_continuation", "\x80", false},
+            {"truncated_2", "\xC3", true},
+            {"truncated_3", "\xE4\xB8", true},
+            {"truncated_4", "\xF0\x9F\x98", true},
+        };
+        return sequences;
+    }
+
+    // 以合法的多字节字符填充前缀，使出错位置前存在跨块的未完成序列
+    std::string valid_prefix(std::size_t length) {
+        std::string rst;
+        while (length - rst.size() >= 4) rst += "\xF0\x9F\x98\x80";
+        while (length - rst.size() >= 2) rst += "\xC3\xA9";
+        if (rst.size() != length) rst += 'a';
+        return rst;
+    }
+
+    std::string valid_suffix(std::size_t length) {
+        std::string rst;
+        while (length - rst.size() >= 3) rst += "\xE4\xB8\xAD";
+        rst.append(length - rst.size(), 'z');
+        return rst;
+    }
+
+    void expect_first_error(const std::string& input, std::size_t offset, const char* name) {
+        EXPECT_EQ(encode::validate_utf_8(input), offset) << name << " at " << offset << " of " << input.size();
+        EXPECT_EQ(encode::validate_utf_8_scalar(input), offset) << name << " at " << offset << " of " << input.size();
+        EXPECT_FALSE(encode::is_valid_utf_8(input));
+
+        std::vector<char32_t> buffer(input.size());
+        const auto rst = encode::utf_8_to_32(input, buffer);
+        EXPECT_EQ(rst.status, encode::transcode_status::invalid_input) << name;
+        EXPECT_EQ(rst.read, offset) << name;
+    }
+}
+
+TEST(EncodeTest, RejectsInvalidSequencesAtEveryOffset) {
+    // 覆盖单块内、跨 32 字节块边界与尾块的各个位置
+    for (const std::size_t total : std::array<std::size_t, 8>{8, 31, 32, 33, 63, 64, 65, 100}) {
+        for (const auto& [name, bytes, truncated] : bad_sequences()) {
+            if (bytes.size() > total) continue;
+
+            for (std::size_t offset = 0; offset + bytes.size() <= total; ++offset) {
+                const std::size_t rest = total - offset - bytes.size();
+
+                std::string ascii = std::string(offset, 'a') + bytes + std::string(rest, 'b');
+                expect_first_error(ascii, offset, name);
+
+                std::string mixed = valid_prefix(offset) + bytes + valid_suffix(rest);
+                expect_first_error(mixed, offset, name);
+            }
+
+            if (truncated) {
+                // 位于输入末尾，只能由尾块的收尾检查发现
+                const std::string tail = valid_prefix(total - bytes.size()) + bytes;
+                expect_first_error(tail, total - bytes.size(), name);
+            }
+        }
+    }
+}
+
+TEST(EncodeTest, AcceptsValidSequencesAcrossBlocks) {
+    for (const std::string& code : {std::string{"\xC3\xA9"}, std::string{"\xE4\xB8\xAD"}, std::string{"\xF0\x9F\x98\x80"}, std::string{"\xF4\x8F\xBF\xBF"}}) {
+        for (std::size_t offset = 0; offset < 70; ++offset) {
+            const std::string input = std::string(offset, 'a') + code + valid_suffix(offset % 7);
+            EXPECT_EQ(encode::validate_utf_8(input), input.size()) << offset;
+            EXPECT_EQ(encode::validate_utf_8_scalar(input), input.size()) << offset;
+        }
+    }
+}
+
+TEST(EncodeTest, MatchesScalarOnRandomInput) {
+    std::mt19937 rng{42};
+    const std::array<std::string, 6> pieces{"a", "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\xED\x9F\xBF", "\xEE\x80\x80"};
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string input;
+        const auto count = rng() % 64;
+        for (std::uint32_t k = 0; k < count; ++k) input += pieces[rng() % pieces.size()];
+        if (!input.empty() && rng() % 2) input[rng() % input.size()] = static_cast<char>(rng());
+
+        EXPECT_EQ(encode::validate_utf_8(input), encode::validate_utf_8_scalar(input)) << i;
+    }
+}
+
+TEST(EncodeTest, ReplacingConversionRetriesOnInvalidInput) {
+    // 续字节不计入 count_code_points / utf_16_length，首次按合法长度分配必然不足，需按上界重试
+    const std::string continuations(40, '\x80');
+    EXPECT_EQ(encode::to_utf_32(continuations), std::u32string(40, encode::replacement_character));
+    EXPECT_EQ(encode::to_utf_16(continuations), std::u16string(40, static_cast<char16_t>(encode::replacement_character)));
+
+    const std::string truncated = "ab\xF0\x9F\x98";
+    EXPECT_EQ(encode::to_utf_32(truncated), U"ab���");
+    EXPECT_EQ(encode::to_utf_16(truncated), u"ab���");
+
+    const std::string mixed = std::string(33, 'x') + "\xED\xA0\x80" + "\xE4\xB8\xAD" + "\xC3";
+    const std::u32string expected32 = std::u32string(33, U'x') + U"���中�";
+    EXPECT_EQ(encode::to_utf_32(mixed), expected32);
+    EXPECT_EQ(encode::to_utf_16(mixed), std::u16string(33, u'x') + u"���中�");
+
+    // 合法输入一次分配即可
+    const std::string valid = "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80";
+    EXPECT_EQ(encode::to_utf_32(valid), U"aé中\U0001F600");
+    EXPECT_EQ(encode::to_utf_16(valid), u"aé中\U0001F600");
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+import mo_yanxi.event;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    struct key_event final {
+        int code;
+    };
+
+    struct tick_event final {
+        double delta;
+    };
+
+    using manager = events::static_event_manager<key_event, tick_event, int>;
+
+    // 超出内联缓冲，存放于堆上
+    struct large_listener {
+        std::array<char, events::inline_listener::inline_size + 16> padding{};
+        int* sum;
+
+        void operator()(const key_event& event) const { *sum += event.code; }
+    };
+
+    // 移动可能抛出，同样存放于堆上
+    struct throwing_move_listener {
+        int* sum;
+
+        throwing_move_listener(int* sum) : sum(sum) {}
+        throwing_move_listener(const throwing_move_listener&) = default;
+        throwing_move_listener(throwing_move_listener&& other) noexcept(false) : sum(other.sum) {}
+
+        void operator()(const key_event& event) const { *sum += event.code * 10; }
+    };
+
+    struct throwing_copy_listener {
+        void operator()(const key_event&) const {}
+
+        throwing_copy_listener() = default;
+        throwing_copy_listener(const throwing_copy_listener&) { throw std::runtime_error{"copy failure"}; }
+        throwing_copy_listener(throwing_copy_listener&&) noexcept = default;
+    };
+}
+
+TEST(StaticEventManagerTest, RelocatesInlineAndHeapListenersAcrossGrowth) {
+    static_assert(sizeof(events::inline_listener) == 64);
+    static_assert(manager::index_of<tick_event> == 1);
+
+    manager dispatcher;
+    const auto token = std::make_shared<int>(0);
+
+    int sum = 0;
+    dispatcher.on<key_event>([&sum, token](const key_event& event) { sum += event.code; });
+    dispatcher.on<key_event>(large_listener{.sum = &sum});
+    dispatcher.on<key_event>(throwing_move_listener{&sum});
+
+    // 反复扩容，使上述监听器经历多次重定位
+    int ticks = 0;
+    for (int i = 0; i < 200; ++i) {
+        dispatcher.on<key_event>([&sum](const key_event&) { sum += 100; });
+        dispatcher.on<tick_event>([&ticks](const tick_event&) { ++ticks; });
+    }
+    EXPECT_EQ(token.use_count(), 2);
+
+    dispatcher.fire(key_event{1});
+    EXPECT_EQ(sum, 1 + 1 + 10 + 200 * 100);
+
+    dispatcher.fire(tick_event{0.5});
+    EXPECT_EQ(ticks, 200);
+
+    dispatcher.clear<key_event>();
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(dispatcher.size<key_event>(), 0u);
+    EXPECT_EQ(dispatcher.size<tick_event>(), 200u);
+
+    dispatcher.clear();
+    EXPECT_EQ(dispatcher.size<tick_event>(), 0u);
+}
+
+TEST(StaticEventManagerTest, EraseKeepsIdsAligned) {
+    manager dispatcher;
+
+    std::vector<int> called;
+    std::vector<events::listener_id> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(dispatcher.on<int>([&called, i](int) { called.push_back(i); }));
+    }
+
+    EXPECT_TRUE(dispatcher.erase<int>(ids[0]));
+    EXPECT_TRUE(dispatcher.erase<int>(ids[4]));
+    EXPECT_TRUE(dispatcher.erase<int>(ids[9]));
+    EXPECT_FALSE(dispatcher.erase<int>(ids[4]));
+    // 标识属于其他事件类型时不会误删
+    EXPECT_FALSE(dispatcher.erase<key_event>(ids[1]));
+    EXPECT_EQ(dispatcher.size<int>(), 7u);
+
+    dispatcher.fire(0);
+    EXPECT_EQ(called, (std::vector{1, 2, 3, 5, 6, 7, 8}));
+
+    called.clear();
+    EXPECT_TRUE(dispatcher.erase<int>(ids[5]));
+    dispatcher.fire(0);
+    EXPECT_EQ(called, (std::vector{1, 2, 3, 6, 7, 8}));
+}
+
+TEST(StaticEventManagerTest, InvokesMutableCallables) {
+    manager dispatcher;
+
+    int last = 0;
+    dispatcher.on<key_event>([&last, count = 0](const key_event&) mutable { last = ++count; });
+    dispatcher.emplace_fire<key_event>(1);
+    dispatcher.fire(key_event{2});
+    dispatcher(key_event{3});
+    EXPECT_EQ(last, 3);
+
+    // 重定位后状态随之迁移
+    for (int i = 0; i < 64; ++i) dispatcher.on<key_event>([](const key_event&) {});
+    dispatcher.fire(key_event{4});
+    EXPECT_EQ(last, 4);
+}
+
+TEST(StaticEventManagerTest, FailedRegistrationLeavesGroupConsistent) {
+    manager dispatcher;
+
+    int sum = 0;
+    const auto first = dispatcher.on<key_event>([&sum](const key_event& event) { sum += event.code; });
+
+    const throwing_copy_listener listener;
+    EXPECT_THROW(dispatcher.on<key_event>(listener), std::runtime_error);
+    EXPECT_EQ(dispatcher.size<key_event>(), 1u);
+
+    const auto second = dispatcher.on<key_event>([&sum](const key_event& event) { sum += event.code * 100; });
+    EXPECT_NE(first, second);
+
+    EXPECT_TRUE(dispatcher.erase<key_event>(first));
+    dispatcher.fire(key_event{1});
+    EXPECT_EQ(sum, 100);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <random>
+#include <vector>
+
+import mo_yanxi.math.linear_quad_tree;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+using namespace mo_yanxi;
+using namespace mo_yanxi::math;
+
+namespace {
+    struct body : quad_tree_adaptor<body> {
+        rect_ortho<float> bound;
+        std::uint32_t id;
+
+        body(rect_ortho<float> bound, std::uint32_t id) : bound(bound), id(id) {}
+
+        [[nodiscard]] rect_ortho<float> quad_tree_get_bound() const noexcept { return bound; }
+
+        [[nodiscard]] bool quad_tree_contains(vec2 point) const noexcept { return bound.contains_loose(point); }
+    };
+
+    using tree_type = linear_quad_tree<body>;
+    using id_set = std::vector<std::uint32_t>;
+
+    const rect_ortho<float> world{0.f, 0.f, 1024.f, 1024.f};
+
+    /**
+     * @brief 小物体、跨越中线的大物体与超出 boundary 的物体混合
+     */
+    std::vector<body> random_bodies(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> pos(-64.f, 1088.f);
+        std::uniform_real_distribution<float> small(0.5f, 24.f);
+        std::uniform_real_distribution<float> large(100.f, 600.f);
+        std::vector<body> rst;
+        rst.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const bool big = g() % 16 == 0;
+            const float w = big ? large(g) : small(g);
+            const float h = big ? large(g) : small(g);
+            rst.emplace_back(rect_ortho<float>{pos(g), pos(g), w, h}, i);
+        }
+        return rst;
+    }
+
+    std::vector<rect_ortho<float>> random_regions(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> pos(-100.f, 1100.f);
+        std::uniform_real_distribution<float> size(1.f, 200.f);
+        std::vector<rect_ortho<float>> rst;
+        for (std::size_t i = 0; i < count; ++i) rst.emplace_back(pos(g), pos(g), size(g), size(g));
+        return rst;
+    }
+
+    std::vector<vec2> random_points(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> pos(-100.f, 1100.f);
+        std::vector<vec2> rst;
+        for (std::size_t i = 0; i < count; ++i) rst.push_back({pos(g), pos(g)});
+        return rst;
+    }
+
+    id_set brute_force(std::span<const body> bodies, const body& subject) {
+        id_set rst;
+        for (const body& other : bodies) {
+            if (&other != &subject && other.bound.overlap_exclusive(subject.bound)) rst.push_back(other.id);
+        }
+        return rst;
+    }
+
+    id_set brute_force(std::span<const body> bodies, rect_ortho<float> region) {
+        id_set rst;
+        for (const body& other : bodies) {
+            if (other.bound.overlap_exclusive(region)) rst.push_back(other.id);
+        }
+        return rst;
+    }
+
+    id_set brute_force(std::span<const body> bodies, vec2 point) {
+        id_set rst;
+        for (const body& other : bodies) {
+            if (other.bound.contains_loose(point)) rst.push_back(other.id);
+        }
+        return rst;
+    }
+
+    id_set sorted(id_set ids) {
+        std::ranges::sort(ids);
+        return ids;
+    }
+
+    template <typename Query>
+    void expect_matches(const tree_type& tree, std::span<const body> bodies, const Query& query) {
+        const id_set expected = brute_force(bodies, query);
+
+        id_set found;
+        tree.intersect_then(query, [&](body& item, auto&&...) { found.push_back(item.id); });
+        EXPECT_EQ(sorted(found), expected);
+
+        const body* any = tree.intersect_any(query);
+        if (expected.empty()) {
+            EXPECT_EQ(any, nullptr);
+        } else {
+            ASSERT_NE(any, nullptr);
+            EXPECT_TRUE(std::ranges::binary_search(expected, any->id));
+        }
+    }
+
+    void expect_matches_all(const tree_type& tree, std::span<const body> bodies) {
+        for (const body& subject : bodies) expect_matches(tree, bodies, subject);
+        for (const auto& region : random_regions(300, 7)) expect_matches(tree, bodies, region);
+        for (const vec2 point : random_points(300, 8)) expect_matches(tree, bodies, point);
+    }
+}
+
+TEST(LinearQuadTreeTest, MatchesBruteForce) {
+    std::vector<body> bodies = random_bodies(1500, 1);
+
+    tree_type tree{world, 6};
+    tree.rebuild(bodies);
+    EXPECT_EQ(tree.size(), bodies.size());
+    expect_matches_all(tree, bodies);
+
+    // 以指针重建得到相同结果
+    std::vector<body*> pointers;
+    for (body& item : bodies) pointers.push_back(&item);
+    tree.rebuild(std::span<body* const>{pointers});
+    expect_matches_all(tree, bodies);
+}
+
+TEST(LinearQuadTreeTest, RebuildReusesTree) {
+    tree_type tree{world};
+    for (unsigned frame = 0; frame < 4; ++frame) {
+        std::vector<body> bodies = random_bodies(200 + frame * 300, 10 + frame);
+        tree.rebuild(bodies);
+        expect_matches_all(tree, bodies);
+    }
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.intersect_any(world), nullptr);
+}
+
+TEST(LinearQuadTreeTest, ParallelRebuildAndQueries) {
+    ccur::thread_pool pool{4};
+    std::vector<body> bodies = random_bodies(4000, 2);
+
+    tree_type serial{world};
+    serial.rebuild(bodies);
+
+    tree_type parallel{world};
+    parallel.rebuild(pool, bodies);
+    EXPECT_EQ(parallel.node_count(), serial.node_count());
+    expect_matches_all(parallel, bodies);
+
+    // 批量查询：元素、矩形与点
+    std::vector<std::mutex> locks(bodies.size());
+    std::vector<id_set> by_body(bodies.size());
+    parallel.intersect_then(pool, bodies, [&](const body& subject, body& item) {
+        std::lock_guard lock{locks[subject.id]};
+        by_body[subject.id].push_back(item.id);
+    });
+    for (const body& subject : bodies) {
+        EXPECT_EQ(sorted(by_body[subject.id]), brute_force(bodies, subject)) << subject.id;
+    }
+
+    const auto regions = random_regions(500, 3);
+    std::vector<std::mutex> region_locks(regions.size());
+    std::vector<id_set> by_region(regions.size());
+    parallel.intersect_then(pool, regions, [&](const rect_ortho<float>& region, body& item) {
+        const auto index = static_cast<std::size_t>(&region - regions.data());
+        std::lock_guard lock{region_locks[index]};
+        by_region[index].push_back(item.id);
+    }, 8);
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        EXPECT_EQ(sorted(by_region[i]), brute_force(bodies, regions[i])) << i;
+    }
+
+    const auto points = random_points(500, 4);
+    std::vector<std::mutex> point_locks(points.size());
+    std::vector<id_set> by_point(points.size());
+    parallel.intersect_then(pool, points, [&](const vec2& point, body& item) {
+        const auto index = static_cast<std::size_t>(&point - points.data());
+        std::lock_guard lock{point_locks[index]};
+        by_point[index].push_back(item.id);
+    });
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(sorted(by_point[i]), brute_force(bodies, points[i])) << i;
+    }
+}
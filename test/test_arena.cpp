@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+import mo_yanxi.arena;
+import std;
+
+using namespace mo_yanxi;
+
+TEST(ArenaTest, BumpAllocationIsContiguousAndAligned) {
+    byte_pool<> pool;
+    monotonic_arena arena{pool, 4096};
+
+    auto* a = static_cast<std::byte*>(arena.allocate_bytes(10, 1));
+    auto* b = static_cast<std::byte*>(arena.allocate_bytes(10, 1));
+    EXPECT_EQ(b, a + 10);
+
+    void* c = arena.allocate_bytes(8, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 64, 0u);
+    EXPECT_EQ(arena.chunk_count(), 1u);
+}
+
+TEST(ArenaTest, RewindReusesMemory) {
+    byte_pool<> pool;
+    monotonic_arena arena{pool, 1024};
+
+    (void)arena.allocate_bytes(100);
+    const auto marker = arena.mark();
+    void* first = arena.allocate_bytes(200);
+    for (int i = 0; i < 20; ++i) {
+        (void)arena.allocate_bytes(200);
+    }
+    const auto chunks = arena.chunk_count();
+    EXPECT_GT(chunks, 1u);
+
+    arena.rewind(marker);
+    EXPECT_EQ(arena.allocate_bytes(200), first);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+    for (int i = 0; i < 21; ++i) {
+        (void)arena.allocate_bytes(200);
+    }
+    // 回收后的块被复用，不再向池申请
+    EXPECT_EQ(arena.chunk_count(), chunks);
+
+    arena.reset();
+    arena.release_unused();
+    EXPECT_EQ(arena.chunk_count(), 0u);
+}
+
+TEST(ArenaTest, OversizedRequestGetsDedicatedChunk) {
+    byte_pool<> pool;
+    monotonic_arena arena{pool, 1024};
+
+    (void)arena.allocate_bytes(16);
+    auto* big = static_cast<std::byte*>(arena.allocate_bytes(100000));
+    std::ranges::fill(big, big + 100000, std::byte{1});
+    EXPECT_EQ(arena.chunk_count(), 2u);
+    EXPECT_GE(arena.bytes_reserved(), 100000u + 1024u);
+}
+
+TEST(ArenaTest, ScopeRewindsOnExit) {
+    byte_pool<> pool;
+    monotonic_arena arena{pool};
+
+    (void)arena.allocate_bytes(64);
+    const auto used = arena.bytes_used();
+    {
+        arena_scope scope{arena};
+        (void)arena.allocate_bytes(1000);
+        EXPECT_GT(arena.bytes_used(), used);
+    }
+    EXPECT_EQ(arena.bytes_used(), used);
+}
+
+TEST(ArenaTest, WorksWithAllocatorAwareContainers) {
+    byte_pool<> pool;
+    monotonic_arena arena{pool};
+
+    {
+        std::vector<int, arena_allocator<int>> values{arena_allocator<int>{arena}};
+        for (int i = 0; i < 1000; ++i) values.push_back(i);
+        EXPECT_EQ(values[999], 999);
+
+        std::pmr::vector<std::pmr::string> strings{&arena};
+        for (int i = 0; i < 100; ++i) strings.emplace_back(std::string(40, static_cast<char>('a' + i % 26)));
+        EXPECT_EQ(strings[27][0], 'b');
+    }
+
+    arena.reset();
+    EXPECT_EQ(arena.bytes_used(), 0u);
+}
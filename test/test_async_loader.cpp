@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+import mo_yanxi.io.async_loader;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    struct temp_file {
+        std::filesystem::path path;
+
+        explicit temp_file(std::string_view name, std::span<const std::uint32_t> content) {
+            path = std::filesystem::temp_directory_path() / name;
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size_bytes()));
+        }
+
+        ~temp_file() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    };
+
+    std::vector<std::uint32_t> words_from(std::uint32_t seed, std::size_t count) {
+        std::vector<std::uint32_t> rst(count);
+        std::iota(rst.begin(), rst.end(), seed);
+        return rst;
+    }
+
+    bool equal_bytes(std::span<const std::byte> bytes, std::span<const std::uint32_t> words) {
+        return bytes.size() == words.size_bytes() && std::memcmp(bytes.data(), words.data(), bytes.size()) == 0;
+    }
+
+    class AsyncLoaderTest : public ::testing::TestWithParam<io::loader_backend> {};
+}
+
+TEST_P(AsyncLoaderTest, LoadsBatchAndRanges) {
+    concurrent_byte_pool<> pool;
+    io::batch_file_loader loader{pool, GetParam(), 4};
+    EXPECT_NE(loader.backend(), io::loader_backend::automatic);
+
+    std::deque<temp_file> files;
+    std::vector<std::vector<std::uint32_t>> contents;
+    std::vector<io::load_request> requests;
+    for (std::uint32_t i = 0; i < 24; ++i) {
+        contents.push_back(words_from(i * 1000, 1 + i * 3777));
+        files.emplace_back("mo_yanxi_async_loader_" + std::to_string(i) + ".bin", contents.back());
+        requests.push_back({.path = files.back().path, .user_data = i});
+    }
+
+    // 部分读取、越过末尾的截断读取与缺失文件
+    requests.push_back({.path = files[10].path, .offset = 40, .length = 400, .user_data = 100});
+    requests.push_back({.path = files[3].path, .offset = 8, .user_data = 101});
+    requests.push_back({.path = files[5].path, .offset = 1 << 30, .user_data = 102});
+    requests.push_back({.path = files[0].path.parent_path() / "mo_yanxi_async_loader_missing.bin", .user_data = 103});
+
+    std::mutex mutex;
+    std::vector<io::load_result> results;
+    loader.load(requests, [&](io::load_result&& rst) {
+        std::lock_guard lock{mutex};
+        results.push_back(std::move(rst));
+    });
+
+    ASSERT_EQ(results.size(), requests.size());
+    std::ranges::sort(results, {}, &io::load_result::index);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].index, i);
+        EXPECT_EQ(results[i].user_data, requests[i].user_data);
+    }
+
+    for (std::uint32_t i = 0; i < 24; ++i) {
+        ASSERT_TRUE(results[i]) << i;
+        EXPECT_TRUE(equal_bytes(results[i].bytes(), contents[i])) << i;
+    }
+
+    ASSERT_TRUE(results[24]);
+    EXPECT_TRUE(equal_bytes(results[24].bytes(), std::span{contents[10]}.subspan(10, 100)));
+
+    ASSERT_TRUE(results[25]);
+    EXPECT_TRUE(equal_bytes(results[25].bytes(), std::span{contents[3]}.subspan(2)));
+
+    ASSERT_TRUE(results[26]);
+    EXPECT_TRUE(results[26].bytes().empty());
+
+    EXPECT_EQ(results[27].status, io::load_status::open_failed);
+    EXPECT_NE(results[27].error, 0);
+}
+
+TEST_P(AsyncLoaderTest, DeliversThroughQueue) {
+    concurrent_byte_pool<> pool;
+    io::batch_file_loader loader{pool, GetParam()};
+
+    const auto words = words_from(7, 5000);
+    const temp_file file{"mo_yanxi_async_loader_queue.bin", words};
+    const std::vector<io::load_request> requests(16, io::load_request{.path = file.path});
+
+    ccur::mpsc_queue<io::load_result> queue;
+    loader.load(requests, queue);
+
+    std::size_t count = 0;
+    while (auto rst = queue.try_consume()) {
+        ASSERT_TRUE(*rst);
+        EXPECT_TRUE(equal_bytes(rst->bytes(), words));
+        ++count;
+    }
+    EXPECT_EQ(count, requests.size());
+}
+
+TEST_P(AsyncLoaderTest, SubmitCompletesFuture) {
+    concurrent_byte_pool<> pool;
+    io::batch_file_loader loader{pool, GetParam()};
+
+    const auto words = words_from(42, 20000);
+    const temp_file file{"mo_yanxi_async_loader_submit.bin", words};
+
+    std::atomic_size_t matched{};
+    std::vector<std::future<void>> futures;
+    for (int batch = 0; batch < 4; ++batch) {
+        futures.push_back(loader.submit(std::vector<io::load_request>(8, io::load_request{.path = file.path}),
+            [&](io::load_result&& rst) {
+                if (rst && equal_bytes(rst.bytes(), words)) matched.fetch_add(1);
+            }));
+    }
+
+    for (auto& future : futures) future.get();
+    EXPECT_EQ(matched.load(), 32u);
+
+    ccur::mpsc_queue<io::load_result> queue;
+    loader.submit({io::load_request{.path = file.path, .length = 4}}, queue).get();
+    const auto rst = queue.try_consume();
+    ASSERT_TRUE(rst.has_value());
+    EXPECT_EQ(rst->size, 4u);
+}
+
+TEST_P(AsyncLoaderTest, SinkExceptionLeavesLoaderUsable) {
+    concurrent_byte_pool<> pool;
+    io::batch_file_loader loader{pool, GetParam(), 4};
+
+    const auto words = words_from(9, 30000);
+    const temp_file file{"mo_yanxi_async_loader_throw.bin", words};
+    const std::vector<io::load_request> requests(32, io::load_request{.path = file.path});
+
+    // 回调抛出后, 在途读取须先收尾再向外传播
+    std::atomic_size_t delivered{};
+    EXPECT_THROW(loader.load(requests, [&](io::load_result&&) {
+        if (delivered.fetch_add(1) == 0) throw std::runtime_error{"sink failure"};
+    }), std::runtime_error);
+
+    std::atomic_size_t matched{};
+    loader.load(requests, [&](io::load_result&& rst) {
+        if (rst && equal_bytes(rst.bytes(), words)) matched.fetch_add(1);
+    });
+    EXPECT_EQ(matched.load(), requests.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncLoaderTest,
+    ::testing::Values(io::loader_backend::automatic, io::loader_backend::thread_pool));
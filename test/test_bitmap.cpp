@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.bitmap;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    bitmap random_bitmap(unsigned w, unsigned h, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_int_distribution<unsigned> dist(0, 255);
+        bitmap rst{w, h};
+        for (auto& px : rst) {
+            px = color_bits{
+                static_cast<std::uint8_t>(dist(g)), static_cast<std::uint8_t>(dist(g)),
+                static_cast<std::uint8_t>(dist(g)), static_cast<std::uint8_t>(dist(g))
+            };
+        }
+        return rst;
+    }
+
+    bitmap random_premultiplied(unsigned w, unsigned h, unsigned seed) {
+        bitmap rst = random_bitmap(w, h, seed);
+        rst.premultiply_alpha();
+        return rst;
+    }
+
+    unsigned div255_round(unsigned v) {
+        return (v * 2 + 255) / 510;
+    }
+
+    bool equal(const bitmap& lhs, const bitmap& rhs) {
+        return lhs.extent() == rhs.extent() && std::ranges::equal(lhs, rhs);
+    }
+}
+
+TEST(BitmapTest, PremultiplyMatchesReference) {
+    const bitmap src = random_bitmap(37, 13, 1);
+    bitmap dst = src;
+    dst.premultiply_alpha();
+
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        const color_bits s = src.data()[i], d = dst.data()[i];
+        EXPECT_EQ(d.r, div255_round(s.r * s.a));
+        EXPECT_EQ(d.g, div255_round(s.g * s.a));
+        EXPECT_EQ(d.b, div255_round(s.b * s.a));
+        EXPECT_EQ(d.a, s.a);
+    }
+}
+
+TEST(BitmapTest, UnpremultiplyRoundTrip) {
+    const bitmap src = random_bitmap(41, 9, 2);
+    bitmap dst = src;
+    dst.premultiply_alpha();
+    dst.unpremultiply_alpha();
+
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        const color_bits s = src.data()[i], d = dst.data()[i];
+        EXPECT_EQ(d.a, s.a);
+        if (s.a == 0) {
+            EXPECT_EQ(d.pack() & 0x00ffffffu, 0u);
+            continue;
+        }
+        const int tolerance = 128 / s.a + 1;
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_LE(std::abs(int{d[c]} - int{s[c]}), tolerance);
+        }
+    }
+}
+
+TEST(BitmapTest, Swizzle) {
+    const bitmap src = random_bitmap(29, 3, 3);
+    bitmap dst = src;
+    dst.swizzle();
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        const color_bits s = src.data()[i], d = dst.data()[i];
+        EXPECT_EQ(d, (color_bits{s.b, s.g, s.r, s.a}));
+    }
+
+    dst.swizzle(bitmap::swizzle_bgra);
+    EXPECT_TRUE(equal(dst, src));
+
+    dst.swizzle({3, 3, 0, 1});
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        const color_bits s = src.data()[i], d = dst.data()[i];
+        EXPECT_EQ(d, (color_bits{s.a, s.a, s.r, s.g}));
+    }
+}
+
+TEST(BitmapTest, FillAndCopyClip) {
+    bitmap dst{20, 10, color_bits{}};
+    dst.fill({15, 8}, {10, 10}, color_bits{1, 2, 3, 4});
+    for (unsigned y = 0; y < 10; ++y) {
+        for (unsigned x = 0; x < 20; ++x) {
+            const bool inside = x >= 15 && y >= 8;
+            EXPECT_EQ((dst[x, y]), (inside ? color_bits{1, 2, 3, 4} : color_bits{}));
+        }
+    }
+
+    const bitmap src = random_bitmap(12, 12, 4);
+    dst.fill(color_bits{});
+    dst.copy_from(src, {2, 3}, {100, 100}, {11, 1});
+    for (unsigned y = 0; y < 10; ++y) {
+        for (unsigned x = 0; x < 20; ++x) {
+            const bool inside = x >= 11 && y >= 1 && x - 11 + 2 < 12 && y - 1 + 3 < 12;
+            EXPECT_EQ((dst[x, y]), (inside ? src[x - 11 + 2, y - 1 + 3] : color_bits{}));
+        }
+    }
+}
+
+TEST(BitmapTest, BlendMatchesReference) {
+    const bitmap src = random_premultiplied(35, 7, 5);
+    const bitmap base = random_premultiplied(40, 9, 6);
+    bitmap dst = base;
+    dst.blend_from(src, {0, 0}, src.extent(), {3, 1});
+
+    for (unsigned y = 0; y < dst.height(); ++y) {
+        for (unsigned x = 0; x < dst.width(); ++x) {
+            const color_bits d = base[x, y];
+            if (x < 3 || y < 1 || y - 1 >= src.height() || x - 3 >= src.width()) {
+                EXPECT_EQ((dst[x, y]), d);
+                continue;
+            }
+            const color_bits s = src[x - 3, y - 1];
+            for (int c = 0; c < 4; ++c) {
+                const unsigned expected = std::min(255u, s[c] + div255_round(d[c] * (255u - s.a)));
+                EXPECT_EQ((dst[x, y][c]), expected);
+            }
+        }
+    }
+}
+
+TEST(BitmapTest, DownscaleAndMipmapChain) {
+    const bitmap src = random_bitmap(37, 13, 7);
+    const bitmap half = src.downscale_half();
+    ASSERT_EQ(half.width(), 18u);
+    ASSERT_EQ(half.height(), 6u);
+
+    for (unsigned y = 0; y < half.height(); ++y) {
+        for (unsigned x = 0; x < half.width(); ++x) {
+            for (int c = 0; c < 4; ++c) {
+                const unsigned sum = src[x * 2, y * 2][c] + src[x * 2 + 1, y * 2][c] +
+                    src[x * 2, y * 2 + 1][c] + src[x * 2 + 1, y * 2 + 1][c];
+                EXPECT_EQ((half[x, y][c]), (sum + 2) / 4);
+            }
+        }
+    }
+
+    const auto chain = src.mipmap_chain();
+    std::vector<std::pair<unsigned, unsigned>> extents;
+    for (const auto& level : chain) extents.emplace_back(level.width(), level.height());
+    const std::vector<std::pair<unsigned, unsigned>> expected{{18, 6}, {9, 3}, {4, 1}, {2, 1}, {1, 1}};
+    EXPECT_EQ(extents, expected);
+    EXPECT_TRUE(equal(chain.front(), half));
+    EXPECT_EQ(src.mipmap_chain(2).size(), 2u);
+}
+
+TEST(BitmapTest, ParallelMatchesSerial) {
+    ccur::thread_pool pool{4};
+    const bitmap src = random_bitmap(1030, 517, 8);
+
+    bitmap serial = src, parallel = src;
+    serial.premultiply_alpha();
+    parallel.premultiply_alpha(pool);
+    EXPECT_TRUE(equal(serial, parallel));
+
+    serial.swizzle();
+    parallel.swizzle(pool);
+    EXPECT_TRUE(equal(serial, parallel));
+
+    const bitmap overlay = random_premultiplied(700, 400, 9);
+    serial.blend_from(overlay, {10, 20}, {600, 600}, {300, 100});
+    parallel.blend_from(pool, overlay, {10, 20}, {600, 600}, {300, 100});
+    EXPECT_TRUE(equal(serial, parallel));
+
+    serial.unpremultiply_alpha();
+    parallel.unpremultiply_alpha(pool);
+    EXPECT_TRUE(equal(serial, parallel));
+
+    const auto serial_chain = serial.mipmap_chain();
+    const auto parallel_chain = parallel.mipmap_chain(pool);
+    ASSERT_EQ(serial_chain.size(), parallel_chain.size());
+    for (std::size_t i = 0; i < serial_chain.size(); ++i) {
+        EXPECT_TRUE(equal(serial_chain[i], parallel_chain[i]));
+    }
+}
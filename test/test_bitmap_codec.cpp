@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.bitmap_codec;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    /**
+     * @brief 混合大块纯色、渐变与噪声，覆盖所有操作码
+     */
+    bitmap synthetic_bitmap(unsigned w, unsigned h, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_int_distribution<unsigned> dist(0, 255);
+        bitmap rst{w, h};
+        const auto c = [](unsigned v) { return static_cast<std::uint8_t>(v); };
+        for (unsigned y = 0; y < h; ++y) {
+            for (unsigned x = 0; x < w; ++x) {
+                color_bits& px = rst[x, y];
+                switch ((x / 16 + y / 16) % 4) {
+                case 0: px = color_bits{10, 20, 30, 255}; break;
+                case 1: px = color_bits{c(x), c(y), c(x + y), 255}; break;
+                case 2: px = color_bits{c(x * 3), c(x * 3 + 1), c(x * 3 - 2), c(200 + x % 3)}; break;
+                default: px = color_bits{c(dist(g)), c(dist(g)), c(dist(g)), c(dist(g))}; break;
+                }
+            }
+        }
+        return rst;
+    }
+
+    bool equal(const bitmap& lhs, const bitmap& rhs) {
+        return lhs.extent() == rhs.extent() && std::ranges::equal(lhs, rhs);
+    }
+}
+
+TEST(BitmapCodecTest, RoundTrip) {
+    for (const auto [w, h] : std::vector<std::pair<unsigned, unsigned>>{{1, 1}, {7, 3}, {64, 64}, {300, 97}, {1000, 130}}) {
+        const bitmap image = synthetic_bitmap(w, h, w * 31 + h);
+        const auto encoded = bitmap_codec::encode(image);
+        const auto decoded = bitmap_codec::decode(encoded);
+        ASSERT_TRUE(decoded.has_value()) << w << "x" << h;
+        EXPECT_TRUE(equal(*decoded, image)) << w << "x" << h;
+    }
+}
+
+TEST(BitmapCodecTest, CompressesFlatRegions) {
+    const bitmap flat{512, 512, color_bits{1, 2, 3, 4}};
+    const auto encoded = bitmap_codec::encode(flat);
+    EXPECT_LT(encoded.size(), flat.size_bytes() / 50);
+
+    const auto decoded = bitmap_codec::decode(encoded);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(equal(*decoded, flat));
+}
+
+TEST(BitmapCodecTest, EmptyImage) {
+    const auto encoded = bitmap_codec::encode(bitmap{});
+    EXPECT_EQ(encoded.size(), bitmap_codec::header::size_bytes);
+    const auto decoded = bitmap_codec::decode(encoded);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->size(), 0u);
+}
+
+TEST(BitmapCodecTest, ParallelMatchesSerial) {
+    ccur::thread_pool pool{4};
+    const bitmap image = synthetic_bitmap(777, 600, 5);
+
+    const auto serial = bitmap_codec::encode(image, 13);
+    const auto parallel = bitmap_codec::encode(pool, image, 13);
+    EXPECT_EQ(serial, parallel);
+
+    const auto decoded = bitmap_codec::decode(pool, parallel);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(equal(*decoded, image));
+}
+
+TEST(BitmapCodecTest, StreamingMatchesBatch) {
+    const bitmap image = synthetic_bitmap(123, 77, 9);
+
+    bitmap_codec::stream_encoder encoder{image.width(), image.height(), 10};
+    std::vector<std::byte> streamed;
+    const auto head = encoder.header_bytes();
+    streamed.insert(streamed.end(), head.begin(), head.end());
+    for (unsigned y = 0; y < image.height(); ++y) {
+        const auto chunk = encoder.push_row(image.row_at(y));
+        streamed.insert(streamed.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_TRUE(encoder.done());
+    EXPECT_EQ(streamed, bitmap_codec::encode(image, 10));
+
+    auto decoder = bitmap_codec::stream_decoder::open(streamed);
+    ASSERT_TRUE(decoder.has_value());
+    std::vector<color_bits> row(image.width());
+    for (unsigned y = 0; y < image.height(); ++y) {
+        ASSERT_TRUE(decoder->next_row(row)) << y;
+        EXPECT_TRUE(std::ranges::equal(row, image.row_at(y))) << y;
+    }
+    EXPECT_FALSE(decoder->next_row(row));
+}
+
+TEST(BitmapCodecTest, EncodeFitsDocumentedSizePerSlice) {
+    // 游程后紧跟 RGBA 像素，逐像素输入时每次调用都可能先写出上次遗留的游程
+    std::vector<color_bits> pixels;
+    for (std::uint8_t i = 0; i < 40; ++i) {
+        pixels.insert(pixels.end(), i % 5 + 1, color_bits{i, static_cast<std::uint8_t>(i * 7), static_cast<std::uint8_t>(i * 13), static_cast<std::uint8_t>(i * 31)});
+    }
+
+    bitmap_codec::band_encoder encoder;
+    std::vector<std::byte> encoded;
+    for (const color_bits& px : pixels) {
+        std::vector<std::byte> slice(bitmap_codec::max_encoded_size(1));
+        std::byte* end = encoder.encode(&px, 1, slice.data());
+        ASSERT_LE(end - slice.data(), std::ssize(slice));
+        encoded.insert(encoded.end(), slice.data(), end);
+    }
+
+    std::vector<std::byte> tail(bitmap_codec::max_encoded_size(0));
+    std::byte* end = encoder.finish(tail.data());
+    ASSERT_LE(end - tail.data(), std::ssize(tail));
+    encoded.insert(encoded.end(), tail.data(), end);
+
+    bitmap_codec::band_decoder decoder{encoded};
+    std::vector<color_bits> decoded(pixels.size());
+    ASSERT_TRUE(decoder.decode(decoded.data(), decoded.size()));
+    EXPECT_TRUE(decoder.exhausted());
+    EXPECT_EQ(decoded, pixels);
+}
+
+TEST(BitmapCodecTest, DecodeSingleBand) {
+    const bitmap image = synthetic_bitmap(90, 50, 3);
+    const auto encoded = bitmap_codec::encode(image, 16);
+
+    const auto source = bitmap_codec::parse(encoded);
+    ASSERT_TRUE(source.has_value());
+    ASSERT_EQ(source->bands.size(), 4u);
+    EXPECT_EQ(source->info.band_rows(3), 2u);
+
+    bitmap target{90, 50, color_bits{}};
+    ASSERT_TRUE(bitmap_codec::decode_band(*source, 2, target));
+    for (unsigned y = 0; y < 50; ++y) {
+        const bool in_band = y >= 32 && y < 48;
+        EXPECT_EQ(std::ranges::equal(target.row_at(y), image.row_at(y)), in_band) << y;
+    }
+
+    std::vector<color_bits> band(2 * 90);
+    ASSERT_TRUE(bitmap_codec::decode_band(*source, 3, band));
+    EXPECT_TRUE(std::ranges::equal(std::span{band}.first(90), image.row_at(48)));
+}
+
+TEST(BitmapCodecTest, RejectsCorruptData) {
+    const bitmap image = synthetic_bitmap(64, 64, 1);
+    auto encoded = bitmap_codec::encode(image, 8);
+
+    EXPECT_FALSE(bitmap_codec::decode(std::span{encoded}.first(encoded.size() - 1)).has_value());
+    EXPECT_FALSE(bitmap_codec::decode(std::span{encoded}.first(10)).has_value());
+
+    auto bad_magic = encoded;
+    bad_magic[0] = std::byte{'X'};
+    EXPECT_FALSE(bitmap_codec::decode(bad_magic).has_value());
+
+    // 伪造的巨大尺寸不应导致分配
+    auto huge = encoded;
+    huge[8] = huge[9] = huge[10] = std::byte{0xff};
+    EXPECT_FALSE(bitmap_codec::decode(huge).has_value());
+
+    std::mt19937 g(7);
+    for (int i = 0; i < 200; ++i) {
+        auto noisy = encoded;
+        noisy[bitmap_codec::header::size_bytes + 4 + g() % (noisy.size() - bitmap_codec::header::size_bytes - 4)] ^= std::byte{0x5a};
+        (void)bitmap_codec::decode(noisy);
+    }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.math.broadphase;
+import mo_yanxi.concurrent.thread_pool;
+import std;
+
+using namespace mo_yanxi;
+using namespace mo_yanxi::math;
+
+namespace {
+    std::vector<rect_box_posed> random_boxes(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> pos(0.f, 1000.f);
+        std::uniform_real_distribution<float> size(2.f, 40.f);
+        std::uniform_real_distribution<float> rot(0.f, 6.28f);
+        std::vector<rect_box_posed> rst;
+        rst.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            rst.emplace_back(vec2{size(g), size(g)}, trans2{{pos(g), pos(g)}, rot(g)});
+        }
+        return rst;
+    }
+
+    std::vector<broadphase_pair> brute_force_candidates(std::span<const rect_box_posed> boxes) {
+        std::vector<broadphase_pair> rst;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            for (std::uint32_t j = i + 1; j < boxes.size(); ++j) {
+                if (boxes[i].get_bound().overlap_inclusive(boxes[j].get_bound())) {
+                    rst.push_back({i, j});
+                }
+            }
+        }
+        return rst;
+    }
+
+    std::vector<broadphase_pair> sorted(std::span<const broadphase_pair> pairs) {
+        std::vector<broadphase_pair> rst{pairs.begin(), pairs.end()};
+        std::ranges::sort(rst);
+        return rst;
+    }
+}
+
+class BroadphaseTest : public ::testing::TestWithParam<broadphase_mode> {};
+
+TEST_P(BroadphaseTest, MatchesBruteForceAcrossFrames) {
+    broadphase<rect_box_posed> bp{GetParam(), 32.f};
+    auto boxes = random_boxes(600, 1);
+
+    std::mt19937 g(2);
+    std::uniform_real_distribution<float> jitter(-5.f, 5.f);
+
+    for (int frame = 0; frame < 5; ++frame) {
+        bp.update(boxes);
+        EXPECT_EQ(sorted(bp.candidates()), brute_force_candidates(boxes)) << "frame " << frame;
+
+        const auto overlaps = bp.refine(boxes);
+        for (const auto [a, b] : overlaps) {
+            EXPECT_TRUE(boxes[a].overlap_exact(boxes[b]));
+        }
+        for (const auto [a, b] : bp.candidates()) {
+            const bool reported = std::ranges::find(overlaps, broadphase_pair{a, b}) != overlaps.end();
+            EXPECT_EQ(reported, boxes[a].overlap_exact(boxes[b]));
+        }
+
+        for (auto& box : boxes) {
+            box.update(trans2{box.deduce_transform().vec + vec2{jitter(g), jitter(g)}, 0.3f * frame});
+        }
+    }
+}
+
+TEST_P(BroadphaseTest, HandlesResize) {
+    broadphase<rect_box_posed> bp{GetParam(), 32.f};
+    auto boxes = random_boxes(300, 3);
+    bp.update(boxes);
+
+    boxes.resize(120);
+    bp.update(boxes);
+    EXPECT_EQ(sorted(bp.candidates()), brute_force_candidates(boxes));
+
+    const auto more = random_boxes(400, 4);
+    boxes.append_range(more);
+    bp.update(boxes);
+    EXPECT_EQ(sorted(bp.candidates()), brute_force_candidates(boxes));
+}
+
+TEST_P(BroadphaseTest, ParallelRefine) {
+    broadphase<rect_box_posed> bp{GetParam(), 32.f};
+    const auto boxes = random_boxes(2000, 5);
+    ccur::thread_pool pool{4};
+
+    bp.update(boxes);
+    const auto serial_span = bp.refine(boxes);
+    const std::vector<broadphase_pair> serial(serial_span.begin(), serial_span.end());
+    const auto parallel_span = bp.refine(pool, boxes);
+    const std::vector<broadphase_pair> parallel(parallel_span.begin(), parallel_span.end());
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST_P(BroadphaseTest, OversizedShapes) {
+    broadphase<rect_box_posed> bp{GetParam(), 8.f};
+    auto boxes = random_boxes(300, 6);
+    // 相对格子尺寸极大的形状不应按覆盖的格子数展开
+    boxes.emplace_back(vec2{1e7f, 1e7f}, trans2{{500.f, 500.f}, 0.f});
+    boxes.emplace_back(vec2{2000.f, 30.f}, trans2{{500.f, 200.f}, 0.5f});
+    boxes.emplace_back(vec2{1e6f, 1e6f}, trans2{{-1e6f, 0.f}, 0.f});
+
+    bp.update(boxes);
+    EXPECT_EQ(sorted(bp.candidates()), brute_force_candidates(boxes));
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, BroadphaseTest,
+    ::testing::Values(broadphase_mode::sweep_and_prune, broadphase_mode::uniform_grid));
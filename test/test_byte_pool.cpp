@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 import mo_yanxi.byte_pool;
 
 using namespace mo_yanxi;
@@ -32,3 +34,102 @@ TEST(BytePoolTest, Resize) {
     borrow.resize(5);
     EXPECT_EQ(borrow.get().size(), 5);
 }
+
+TEST(ConcurrentBytePoolTest, ReuseOnSameThread) {
+    concurrent_byte_pool<> pool;
+    std::byte* first;
+    {
+        auto borrow = pool.borrow<int>(100);
+        first = reinterpret_cast<std::byte*>(borrow.get().data());
+    }
+    auto borrow = pool.borrow<int>(100);
+    EXPECT_EQ(reinterpret_cast<std::byte*>(borrow.get().data()), first);
+
+    const auto stat = pool.class_statistics(0);
+    EXPECT_EQ(stat.capacity_bytes, 512u);
+    EXPECT_EQ(stat.acquires, 2u);
+    EXPECT_EQ(stat.retires, 1u);
+    EXPECT_EQ(stat.system_allocations, 1u);
+}
+
+TEST(ConcurrentBytePoolTest, CrossThreadRetire) {
+    concurrent_byte_pool<> pool;
+    constexpr int count = 2000;
+
+    std::vector<byte_buffer<int>> produced;
+    std::thread producer{[&] {
+        for (int i = 0; i < count; ++i) {
+            auto buf = pool.acquire<int>(64 + i % 512);
+            buf.data()[0] = i;
+            produced.push_back(buf);
+        }
+    }};
+    producer.join();
+
+    std::thread consumer{[&] {
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(produced[i].data()[0], i);
+            pool.retire(produced[i]);
+        }
+    }};
+    consumer.join();
+
+    std::uint64_t acquires = 0, retires = 0;
+    for (unsigned i = 0; i < pool.class_count(); ++i) {
+        const auto stat = pool.class_statistics(i);
+        acquires += stat.acquires;
+        retires += stat.retires;
+    }
+    EXPECT_EQ(acquires, count);
+    EXPECT_EQ(retires, count);
+    // 两个线程均已退出，弹匣全部归还仓库
+    EXPECT_EQ(pool.cached_count(), count);
+
+    pool.trim(10);
+    EXPECT_EQ(pool.cached_count(), 10u);
+    pool.trim();
+    EXPECT_EQ(pool.cached_count(), 0u);
+}
+
+TEST(ConcurrentBytePoolTest, ParallelChurn) {
+    concurrent_byte_pool<> pool;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<byte_buffer<std::byte>> held;
+            for (int i = 0; i < 5000; ++i) {
+                held.push_back(pool.acquire(static_cast<unsigned>(1 + (i * 37 + t) % 8192)));
+                if (held.size() > 16) {
+                    pool.retire(held.front());
+                    held.erase(held.begin());
+                }
+            }
+            for (auto& buf : held) pool.retire(buf);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    const auto stat = pool.statistics();
+    EXPECT_EQ(stat.acquires, stat.retires);
+    EXPECT_EQ(stat.acquires, 20000u);
+    EXPECT_LE(stat.system_allocations, stat.acquires);
+}
+
+TEST(ConcurrentBytePoolTest, ThreadChurnReleasesCaches) {
+    concurrent_byte_pool<> pool;
+    constexpr int count = 64;
+    for (int i = 0; i < count; ++i) {
+        std::thread{[&] {
+            auto buf = pool.acquire<int>(100);
+            pool.retire(buf);
+        }}.join();
+    }
+
+    // 仅保留最后一个退出线程的缓存，其余在后续线程登记时已移除
+    EXPECT_LE(pool.thread_cache_count(), 1u);
+
+    const auto stat = pool.class_statistics(0);
+    EXPECT_EQ(stat.acquires, count);
+    EXPECT_EQ(stat.retires, count);
+    EXPECT_EQ(stat.system_allocations, 1u);
+}
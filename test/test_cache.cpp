@@ -1,6 +1,9 @@
 import mo_yanxi.cache;
 
 #include <gtest/gtest.h>
+#include <deque>
+#include <random>
+#include <string>
 
 using namespace mo_yanxi;
 
@@ -40,6 +43,20 @@ consteval bool test_compile_time_lru() {
 // 编译期断言：如果 test_compile_time_lru() 返回 false 或无法编译，则构建失败
 static_assert(test_compile_time_lru(), "LRU Cache Constexpr Test Failed!");
 
+consteval bool test_compile_time_large_lru() {
+    // 容量超过扫描阈值，走哈希索引
+    mo_yanxi::lru_cache<int, int, 100> cache;
+    for (int i = 0; i < 150; ++i) {
+        cache.put(i, i * 2);
+    }
+    if (cache.size() != 100) return false;
+    if (cache.contains(49)) return false;
+    if (!cache.contains(50) || *cache.get(149) != 298) return false;
+    return true;
+}
+
+static_assert(test_compile_time_large_lru(), "Indexed LRU Cache Constexpr Test Failed!");
+
 
 TEST(LRUCacheTest, BasicOperations) {
     lru_cache<int, std::string, 3> cache;
@@ -70,3 +87,76 @@ TEST(LRUCacheTest, BasicOperations) {
     cache.clear();
     EXPECT_TRUE(cache.empty());
 }
+
+namespace {
+    // 以 std::deque 模拟 LRU 顺序（front 为最近使用）作为对照
+    template <typename Cache>
+    void run_against_reference(Cache& cache, std::size_t capacity, int key_range) {
+        std::deque<std::pair<std::string, int>> reference;
+        std::mt19937 rng{7};
+        std::uniform_int_distribution<int> key_dist{0, key_range};
+
+        auto touch = [&](const std::string& key) -> int* {
+            auto itr = std::ranges::find(reference, key, &std::pair<std::string, int>::first);
+            if (itr == reference.end()) return nullptr;
+            auto entry = *itr;
+            reference.erase(itr);
+            reference.push_front(entry);
+            return &reference.front().second;
+        };
+
+        for (int i = 0; i < 20000; ++i) {
+            const auto key = std::to_string(key_dist(rng));
+            if (rng() % 2) {
+                cache.put(key, i);
+                if (int* v = touch(key)) {
+                    *v = i;
+                } else {
+                    if (reference.size() == capacity) reference.pop_back();
+                    reference.emplace_front(key, i);
+                }
+            } else {
+                int* expected = touch(key);
+                int* actual = cache.get(key);
+                ASSERT_EQ(actual != nullptr, expected != nullptr);
+                if (actual) ASSERT_EQ(*actual, *expected);
+            }
+            ASSERT_EQ(cache.size(), reference.size());
+        }
+    }
+}
+
+TEST(LRUCacheTest, SmallIndexedAgainstReference) {
+    lru_cache<std::string, int, 48> cache;
+    run_against_reference(cache, 48, 96);
+}
+
+TEST(LRUCacheTest, LargeIndexedAgainstReference) {
+    lru_cache<std::string, int, 1024> cache;
+    run_against_reference(cache, 1024, 2048);
+
+    auto moved = std::move(cache);
+    EXPECT_EQ(moved.size(), 1024);
+    EXPECT_TRUE(cache.empty());
+}
+
+TEST(LRUSetTest, IndexedEraseAndEviction) {
+    lru_set<int, 200> set;
+    for (int i = 0; i < 300; ++i) {
+        set.insert(i);
+    }
+    EXPECT_EQ(set.size(), 200);
+    EXPECT_FALSE(set.contains(99));
+    EXPECT_TRUE(set.contains(100));
+
+    for (int i = 100; i < 300; i += 2) {
+        EXPECT_TRUE(set.erase(i));
+    }
+    EXPECT_EQ(set.size(), 100);
+    for (int i = 100; i < 300; ++i) {
+        EXPECT_EQ(set.contains(i), i % 2 == 1);
+    }
+
+    EXPECT_NE(set.find(101), nullptr);
+    EXPECT_EQ(set.find(102), nullptr);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+import mo_yanxi.flat_hash_map;
+import mo_yanxi.heterogeneous.open_addr_hash;
+
+using namespace mo_yanxi;
+
+TEST(FlatHashMapTest, BasicOperations) {
+    flat_hash_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+
+    map[1] = 10;
+    auto [itr, inserted] = map.try_emplace(2, 20);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(itr->first, 2);
+    EXPECT_EQ(itr->second, 20);
+
+    EXPECT_FALSE(map.try_emplace(2, 30).second);
+    EXPECT_EQ(map.at(2), 20);
+
+    map.insert_or_assign(2, 30);
+    EXPECT_EQ(map.at(2), 30);
+    EXPECT_EQ(map.size(), 2);
+
+    EXPECT_TRUE(map.contains(1));
+    EXPECT_EQ(map.find(3), map.end());
+    EXPECT_EQ(map.try_find(3), nullptr);
+    EXPECT_THROW((void)map.at(3), std::out_of_range);
+
+    EXPECT_EQ(map.erase(1), 1);
+    EXPECT_EQ(map.erase(1), 0);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatHashMapTest, GrowthAndIteration) {
+    flat_hash_map<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i * 2;
+    }
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_LE(map.load_factor(), map.max_load_factor());
+
+    long long sum = 0;
+    std::size_t count = 0;
+    for (auto [k, v] : map) {
+        EXPECT_EQ(v, k * 2);
+        sum += k;
+        ++count;
+    }
+    EXPECT_EQ(count, 1000);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+
+    flat_hash_map<int, int> copy{map};
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.at(500), 1000);
+
+    flat_hash_map<int, int> moved{std::move(copy)};
+    EXPECT_EQ(moved.size(), 1000);
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST(FlatHashMapTest, HeterogeneousLookup) {
+    string_open_addr_hash_map<int> map;
+    map["one"] = 1;
+    map.try_emplace(std::string_view{"two"}, 2);
+
+    std::string_view sv = "one";
+    EXPECT_EQ(map.at(sv), 1);
+    EXPECT_EQ(map.at("two"), 2);
+    EXPECT_TRUE(map.contains(std::string{"two"}));
+    EXPECT_EQ(map.erase(std::string_view{"one"}), 1);
+    EXPECT_FALSE(map.contains("one"));
+}
+
+TEST(FlatHashMapTest, TypeIndexMap) {
+    type_fixed_hash_map<int> map;
+    map[typeid(int)] = 1;
+    map[typeid(float)] = 2;
+
+    EXPECT_EQ(map.at(std::type_index{typeid(int)}), 1);
+    EXPECT_FALSE(map.contains(nullptr));
+
+    map[typeid(std::nullptr_t)] = 3;
+    EXPECT_EQ(map.at(nullptr), 3);
+}
+
+TEST(FlatHashMapTest, EraseIf) {
+    flat_hash_map<int, std::string> map;
+    for (int i = 0; i < 200; ++i) {
+        map.try_emplace(i, std::to_string(i));
+    }
+
+    EXPECT_EQ(map.erase_if([](int k, std::string&) { return k % 3 == 0; }), 67);
+    EXPECT_EQ(map.size(), 133);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(map.contains(i), i % 3 != 0);
+    }
+
+    EXPECT_EQ(erase_if(map, [](const auto& kv) { return kv.first % 2 == 0; }), 66);
+    for (const auto& [k, v] : map) {
+        EXPECT_EQ(v, std::to_string(k));
+    }
+}
+
+TEST(FlatHashMapTest, RandomizedAgainstStd) {
+    // 回移删除必须保持探测链完整，与 std::unordered_map 逐步对拍
+    flat_hash_map<std::uint32_t, std::uint32_t> map;
+    std::unordered_map<std::uint32_t, std::uint32_t> reference;
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<std::uint32_t> key_dist{0, 2047};
+
+    for (int i = 0; i < 100000; ++i) {
+        const auto key = key_dist(rng);
+        switch (rng() % 3) {
+        case 0:
+            map.insert_or_assign(key, static_cast<std::uint32_t>(i));
+            reference.insert_or_assign(key, static_cast<std::uint32_t>(i));
+            break;
+        case 1:
+            EXPECT_EQ(map.erase(key), reference.erase(key));
+            break;
+        default: {
+            auto* found = map.try_find(key);
+            auto expected = reference.find(key);
+            ASSERT_EQ(found != nullptr, expected != reference.end());
+            if (found) EXPECT_EQ(*found, expected->second);
+        }
+        }
+        ASSERT_EQ(map.size(), reference.size());
+    }
+
+    for (const auto& [k, v] : reference) {
+        ASSERT_NE(map.try_find(k), nullptr);
+        EXPECT_EQ(*map.try_find(k), v);
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.math.intersection_batch;
+import std;
+
+using namespace mo_yanxi::math;
+
+namespace {
+    segment_batch random_segments(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> pos(-100.f, 100.f);
+        std::uniform_real_distribution<float> len(-20.f, 20.f);
+        segment_batch rst;
+        for (std::size_t i = 0; i < count; ++i) {
+            const vec2 src{pos(g), pos(g)};
+            rst.push_back(src, src + vec2{len(g), len(g)});
+        }
+        return rst;
+    }
+
+    bool test_bit(std::span<const std::uint64_t> mask, std::size_t index) {
+        return (mask[index / 64] >> (index % 64)) & 1;
+    }
+}
+
+TEST(IntersectionBatchTest, RayMatchesScalar) {
+    auto segments = random_segments(1027, 1);
+    // 共线与平行的线段走逐条回退
+    segments.push_back({-50.f, 0.f}, {-40.f, 0.f});
+    segments.push_back({10.f, 0.f}, {20.f, 0.f});
+    segments.push_back({10.f, 1.f}, {20.f, 1.f});
+
+    const vec2 cap{0.f, 0.f};
+    const vec2 dir{1.f, 0.f};
+    std::vector<std::uint64_t> mask(hit_mask_word_count(segments.size()));
+
+    const auto hit = ray_seg_intersection(cap, dir, segments.span(), mask);
+
+    std::size_t expected_index = segment_hit::npos;
+    float expected_t = std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        const auto [v1, v2] = segments.span()[i];
+        const auto rst = ray_seg_intersection(cap, dir, v1, v2);
+        EXPECT_EQ(test_bit(mask, i), static_cast<bool>(rst)) << i;
+        if (rst && rst.pos.x < expected_t) {
+            expected_t = rst.pos.x;
+            expected_index = i;
+        }
+    }
+
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(hit.index, expected_index);
+    EXPECT_NEAR(hit.t, expected_t, 1e-3f);
+}
+
+TEST(IntersectionBatchTest, SegmentMatchesScalar) {
+    // 含 NaN 的线段分别落在整 8 条的向量部分与尾部，两处都应判为不相交
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    const auto random = random_segments(517, 2);
+    segment_batch segments;
+    segments.push_back({0.f, nan}, {5.f, 5.f});
+    for (std::size_t i = 0; i < random.size(); ++i) {
+        const auto [v1, v2] = random.span()[i];
+        segments.push_back(v1, v2);
+    }
+    segments.push_back({nan, 0.f}, {5.f, 5.f});
+    ASSERT_NE(segments.size() % 8, 0u);
+
+    const vec2 p1{-80.f, -60.f};
+    const vec2 p2{90.f, 70.f};
+    std::vector<std::uint64_t> mask(hit_mask_word_count(segments.size()));
+
+    const auto hit = intersect_segments(p1, p2, segments.span(), mask);
+
+    std::size_t hits{};
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        const auto [v1, v2] = segments.span()[i];
+        vec2 out;
+        const bool finite = std::isfinite(v1.x) && std::isfinite(v1.y) && std::isfinite(v2.x) && std::isfinite(v2.y);
+        const bool expected = finite && intersect_segments(p1, p2, v1, v2, out);
+        EXPECT_EQ(test_bit(mask, i), expected) << i;
+        hits += expected;
+    }
+
+    ASSERT_GT(hits, 0u);
+    ASSERT_TRUE(hit);
+    EXPECT_GE(hit.t, 0.f);
+    EXPECT_LE(hit.t, 1.f);
+}
+
+TEST(IntersectionBatchTest, NoHit) {
+    segment_batch segments;
+    segments.push_back({0.f, 10.f}, {10.f, 10.f});
+
+    const auto hit = ray_seg_intersection({0.f, 0.f}, {1.f, 0.f}, segments.span());
+    EXPECT_FALSE(hit);
+    EXPECT_EQ(hit.index, segment_hit::npos);
+}
+
+TEST(IntersectionBatchTest, PolygonEdges) {
+    segment_batch square;
+    square.push_polygon(std::array{vec2{0.f, 0.f}, vec2{10.f, 0.f}, vec2{10.f, 10.f}, vec2{0.f, 10.f}});
+    ASSERT_EQ(square.size(), 4u);
+
+    segment_batch diamond;
+    diamond.push_polygon(std::array{vec2{5.f, -2.f}, vec2{12.f, 5.f}, vec2{5.f, 12.f}, vec2{-2.f, 5.f}});
+
+    std::vector<vec2> points;
+    const auto count = intersect_segments(square.span(), diamond.span(), [&](std::size_t, std::size_t, vec2 p) {
+        points.push_back(p);
+    });
+
+    EXPECT_EQ(count, 8u);
+    EXPECT_EQ(points.size(), 8u);
+    for (const auto p : points) {
+        const bool on_square = p.x == 0.f || p.x == 10.f || p.y == 0.f || p.y == 10.f;
+        EXPECT_TRUE(on_square);
+    }
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+import mo_yanxi.io.mapped_file;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    struct temp_file {
+        std::filesystem::path path;
+
+        explicit temp_file(std::string_view name, std::span<const std::uint32_t> content) {
+            path = std::filesystem::temp_directory_path() / name;
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            stream.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size_bytes()));
+        }
+
+        ~temp_file() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+    };
+
+    std::vector<std::uint32_t> iota_words(std::size_t count) {
+        std::vector<std::uint32_t> rst(count);
+        std::iota(rst.begin(), rst.end(), 0u);
+        return rst;
+    }
+}
+
+TEST(MappedFileTest, ViewExposesWholeFile) {
+    const auto words = iota_words(100000);
+    const temp_file file{"mo_yanxi_mapped_file_view.bin", words};
+
+    auto view = io::mapped_file_view::open(file.path);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->size(), words.size() * sizeof(std::uint32_t));
+
+    const auto typed = view->as<std::uint32_t>();
+    EXPECT_TRUE(std::ranges::equal(typed, words));
+
+    const auto tail = view->as<std::uint32_t>(400, 3);
+    ASSERT_EQ(tail.size(), 3u);
+    EXPECT_EQ(tail[0], 100u);
+
+    view->advise(io::map_advice::will_need, 12345, 1 << 16);
+    view->advise(io::map_advice::random);
+
+    io::mapped_file_view moved = std::move(*view);
+    EXPECT_FALSE(static_cast<bool>(*view));
+    EXPECT_EQ(moved.bytes().size(), words.size() * sizeof(std::uint32_t));
+}
+
+TEST(MappedFileTest, EmptyAndMissingFiles) {
+    const temp_file file{"mo_yanxi_mapped_file_empty.bin", {}};
+    const auto view = io::mapped_file_view::open(file.path);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->empty());
+    EXPECT_TRUE(view->bytes().empty());
+
+    EXPECT_FALSE(io::mapped_file_view::open(file.path.parent_path() / "mo_yanxi_mapped_file_missing.bin").has_value());
+    EXPECT_FALSE(io::chunked_file_reader::open(file.path.parent_path() / "mo_yanxi_mapped_file_missing.bin").has_value());
+
+    io::chunked_file_reader idle;
+    idle.seek(100);
+    EXPECT_EQ(idle.position(), 0u);
+    EXPECT_TRUE(idle.eof());
+}
+
+TEST(MappedFileTest, ChunkedReaderCoversFile) {
+    const auto words = iota_words(300001);
+    const temp_file file{"mo_yanxi_mapped_file_chunked.bin", words};
+
+    auto reader = io::chunked_file_reader::open(file.path, 100000);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_GE(reader->chunk_size(), 100000u);
+
+    std::vector<std::byte> collected;
+    std::uint64_t expected_offset = 0;
+    const bool finished = reader->for_each_chunk([&](std::span<const std::byte> chunk, std::uint64_t offset) {
+        EXPECT_EQ(offset, expected_offset);
+        EXPECT_LE(chunk.size(), reader->chunk_size());
+        expected_offset += chunk.size();
+        collected.insert(collected.end(), chunk.begin(), chunk.end());
+    });
+
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(reader->eof());
+    ASSERT_EQ(collected.size(), words.size() * sizeof(std::uint32_t));
+    EXPECT_EQ(std::memcmp(collected.data(), words.data(), collected.size()), 0);
+
+    reader->seek(reader->chunk_size() + 5);
+    EXPECT_EQ(reader->position(), reader->chunk_size());
+    const auto chunk = reader->next();
+    ASSERT_TRUE(chunk.has_value());
+    EXPECT_EQ(std::memcmp(chunk->data(), reinterpret_cast<const std::byte*>(words.data()) + reader->chunk_size(), chunk->size()), 0);
+}
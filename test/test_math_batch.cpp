@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.math;
+import std;
+
+namespace math = mo_yanxi::math;
+
+namespace {
+    std::vector<float> sample_angles() {
+        std::mt19937 g(42);
+        std::uniform_real_distribution<float> near(-8.f, 8.f);
+        std::uniform_real_distribution<float> far(-1e5f, 1e5f);
+        std::vector<float> rst;
+        for (int i = 0; i < 4096; ++i) {
+            rst.push_back(i % 2 ? near(g) : far(g));
+        }
+        // 商超出 int32 范围的块走标量回退，长度非 8 的倍数以覆盖尾部
+        // 标量版本的商以 int64 表示，输入须保持在 |x| < π·2^63 以内
+        for (float f : {0.f, -0.f, 1e-30f, -1e-30f, 3e9f, -3e9f, 2e18f, -2e18f, 0.5f, -0.5f}) {
+            rst.push_back(f);
+        }
+        return rst;
+    }
+
+    void expect_bitwise_eq(float actual, float expected) {
+        EXPECT_EQ(std::bit_cast<std::uint32_t>(actual), std::bit_cast<std::uint32_t>(expected))
+            << "actual: " << actual << " expected: " << expected;
+    }
+}
+
+TEST(MathBatchTest, CosSinMatchesScalar) {
+    const auto angles = sample_angles();
+    std::vector<float> c(angles.size()), s(angles.size());
+    std::vector<float> c_only(angles.size()), s_only(angles.size());
+
+    math::cos_sin(angles, c, s);
+    math::cos(angles, c_only);
+    math::sin(angles, s_only);
+
+    for (std::size_t i = 0; i < angles.size(); ++i) {
+        const auto [ec, es] = math::cos_sin(angles[i]);
+        expect_bitwise_eq(c[i], ec);
+        expect_bitwise_eq(s[i], es);
+        expect_bitwise_eq(c_only[i], math::cos(angles[i]));
+        expect_bitwise_eq(s_only[i], math::sin(angles[i]));
+    }
+}
+
+TEST(MathBatchTest, Atan2MatchesScalar) {
+    const auto values = sample_angles();
+    std::vector<float> y, x;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        y.push_back(values[i]);
+        x.push_back(values[(i * 7 + 3) % values.size()]);
+    }
+
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    constexpr float specials[]{0.f, -0.f, inf, -inf, 1.f, -1.f, 2.f, -3.f};
+    for (float a : specials) {
+        for (float b : specials) {
+            y.push_back(a);
+            x.push_back(b);
+        }
+    }
+
+    std::vector<float> out(y.size());
+    math::atan2(y, x, out);
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        expect_bitwise_eq(out[i], math::atan2(y[i], x[i]));
+    }
+}
+
+TEST(MathBatchTest, SqrtMatchesScalar) {
+    std::vector<float> values;
+    for (int i = 0; i < 1001; ++i) {
+        values.push_back(static_cast<float>(i) * 0.37f);
+    }
+
+    std::vector<float> out(values.size());
+    math::sqrt(values, out);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        expect_bitwise_eq(out[i], math::sqrt(values[i]));
+    }
+}
+
+TEST(MathBatchTest, InPlace) {
+    auto angles = sample_angles();
+    const auto expected = angles;
+    std::vector<float> s(angles.size());
+
+    math::cos_sin(angles, angles, s);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expect_bitwise_eq(angles[i], math::cos(expected[i]));
+        expect_bitwise_eq(s[i], math::sin(expected[i]));
+    }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+import mo_yanxi.concurrent.mpmc_queue;
+import std;
+
+using namespace mo_yanxi::ccur;
+
+TEST(MpmcQueueTest, CapacityRoundsUp) {
+    mpmc_queue<int> queue{5};
+    EXPECT_EQ(queue.capacity(), 8);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, TryPushPopFifo) {
+    mpmc_queue<int> queue{4};
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4);
+
+    for (int i = 0; i < 4; ++i) {
+        auto value = queue.try_consume();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_FALSE(queue.try_consume().has_value());
+}
+
+TEST(MpmcQueueTest, BatchPushPop) {
+    mpmc_queue<std::string> queue{8};
+    std::vector<std::string> input{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+
+    EXPECT_EQ(queue.try_push_n(input), 8);
+
+    std::vector<std::string> output;
+    EXPECT_EQ(queue.try_pop_n(std::back_inserter(output), 3), 3);
+    EXPECT_EQ(output, (std::vector<std::string>{"a", "b", "c"}));
+
+    EXPECT_EQ(queue.try_push_n(input.begin() + 8, 2), 2);
+    EXPECT_EQ(queue.try_pop_n(std::back_inserter(output), 100), 7);
+    EXPECT_EQ(output, input);
+}
+
+TEST(MpmcQueueTest, ConsumeWithExitPredicate) {
+    mpmc_queue<int> queue{2};
+    std::atomic_bool stop{false};
+
+    std::thread consumer([&] {
+        EXPECT_FALSE(queue.consume([&] { return stop.load(); }).has_value());
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop = true;
+    queue.notify();
+    consumer.join();
+}
+
+TEST(MpmcQueueTest, MultiProducerMultiConsumer) {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 20000;
+
+    mpmc_queue<int> queue{64};
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+    std::atomic_bool done{false};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (auto value = queue.consume([&] { return done.load(); })) {
+                sum += *value;
+                ++received;
+            }
+        });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; ++p) {
+        producer_threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+    for (auto& t : producer_threads) t.join();
+
+    while (received.load() != producers * per_producer) {
+        std::this_thread::yield();
+    }
+    done = true;
+    queue.notify();
+    for (auto& t : threads) t.join();
+
+    constexpr long long total = producers * per_producer;
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+import mo_yanxi.algo.radix_sort;
+import mo_yanxi.byte_pool;
+import std;
+
+using namespace mo_yanxi::algo;
+
+namespace {
+    struct entity {
+        std::uint64_t packed;
+        std::uint32_t order;
+    };
+
+    enum class layer : std::int8_t { back = -3, mid = 0, front = 5 };
+}
+
+TEST(RadixSortTest, UnsignedKeysAreStable) {
+    std::vector<entity> v(10000);
+    std::mt19937_64 g(1);
+    for (std::uint32_t i = 0; i < v.size(); ++i) {
+        // 高位集中在少数值，低位全部相同，覆盖跳过字节的路径
+        v[i] = {(g() % 64) << 40, i};
+    }
+
+    auto expected = v;
+    std::ranges::stable_sort(expected, {}, &entity::packed);
+
+    radix_sort(v, &entity::packed);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i].packed, expected[i].packed);
+        ASSERT_EQ(v[i].order, expected[i].order);
+    }
+}
+
+TEST(RadixSortTest, SignedKeys) {
+    std::vector<std::int32_t> v(5000);
+    std::mt19937 g(2);
+    for (auto& x : v) x = static_cast<std::int32_t>(g());
+    v.push_back(std::numeric_limits<std::int32_t>::min());
+    v.push_back(std::numeric_limits<std::int32_t>::max());
+
+    auto expected = v;
+    std::ranges::sort(expected);
+    radix_sort(v);
+    EXPECT_EQ(v, expected);
+}
+
+TEST(RadixSortTest, FloatKeys) {
+    std::vector<double> v(5000);
+    std::mt19937 g(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (auto& x : v) x = dist(g);
+    v.push_back(std::numeric_limits<double>::infinity());
+    v.push_back(-std::numeric_limits<double>::infinity());
+    v.push_back(0.0);
+
+    auto expected = v;
+    std::ranges::sort(expected);
+    radix_sort(v);
+    EXPECT_EQ(v, expected);
+
+    std::vector<float> f = {3.5f, -0.25f, 1e-30f, -1e30f, 0.f, 2.f};
+    radix_sort(f);
+    EXPECT_TRUE(std::ranges::is_sorted(f));
+}
+
+TEST(RadixSortTest, EnumKeysAndSmallInput) {
+    std::vector<layer> v = {layer::front, layer::back, layer::mid, layer::back};
+    radix_sort(v);
+    EXPECT_EQ(v, (std::vector<layer>{layer::back, layer::back, layer::mid, layer::front}));
+}
+
+TEST(RadixSortTest, BytePoolScratch) {
+    mo_yanxi::byte_pool<> pool;
+    std::vector<std::uint32_t> v(20000);
+    std::mt19937 g(4);
+    for (auto& x : v) x = g();
+
+    auto expected = v;
+    std::ranges::sort(expected);
+    radix_sort(v, std::identity{}, pool);
+    EXPECT_EQ(v, expected);
+}
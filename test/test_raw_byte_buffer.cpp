@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <version>
+
+import mo_yanxi.raw_byte_buffer;
+import mo_yanxi.mapped_allocator;
+import std;
+
+using namespace mo_yanxi;
+
+namespace {
+    struct expand_counting_allocator {
+        using value_type = int;
+
+        // 每块至少预留的元素数，其内的增长均可原地完成
+        static constexpr std::size_t reserve_count = 4096;
+
+        static inline int expansions = 0;
+        static inline int allocations = 0;
+        static inline std::unordered_map<int*, std::size_t> reserved{};
+
+        expand_counting_allocator() = default;
+
+        int* allocate(std::size_t n) {
+            ++allocations;
+            const std::size_t count = std::max(n, reserve_count);
+            int* p = static_cast<int*>(::operator new(count * sizeof(int)));
+            reserved[p] = count;
+            return p;
+        }
+
+        void deallocate(int* p, std::size_t) noexcept {
+            reserved.erase(p);
+            ::operator delete(p);
+        }
+
+        bool expand_in_place(int* p, std::size_t, std::size_t new_n) noexcept {
+            const auto itr = reserved.find(p);
+            if (itr == reserved.end() || new_n > itr->second) return false;
+            ++expansions;
+            return true;
+        }
+
+        bool operator==(const expand_counting_allocator&) const noexcept = default;
+    };
+
+#ifdef __cpp_lib_is_implicit_lifetime
+    struct tracked {
+        int value{};
+        std::unique_ptr<int> owned{};
+    };
+#endif
+}
+
+#ifdef __cpp_lib_is_implicit_lifetime
+template <>
+struct mo_yanxi::is_trivially_relocatable<tracked> : std::true_type {};
+#endif
+
+TEST(RawByteBufferTest, ExpandInPlaceKeepsAddress) {
+    expand_counting_allocator::expansions = 0;
+    expand_counting_allocator::allocations = 0;
+
+    raw_vector<int, expand_counting_allocator> vec;
+    vec.push_back(0);
+    const int* first = vec.data();
+    for (int i = 1; i < 1000; ++i) vec.push_back(i);
+
+    EXPECT_EQ(vec.data(), first);
+    EXPECT_EQ(expand_counting_allocator::allocations, 1);
+    EXPECT_GT(expand_counting_allocator::expansions, 0);
+    for (int i = 0; i < 1000; ++i) EXPECT_EQ(vec[i], i);
+}
+
+TEST(RawByteBufferTest, ExpandFallsBackToReallocation) {
+    expand_counting_allocator::allocations = 0;
+
+    raw_vector<int, expand_counting_allocator> vec;
+    constexpr int count = 3 * expand_counting_allocator::reserve_count;
+    for (int i = 0; i < count; ++i) vec.push_back(i);
+
+    EXPECT_GT(expand_counting_allocator::allocations, 1);
+    for (int i = 0; i < count; ++i) ASSERT_EQ(vec[i], i);
+}
+
+TEST(RawByteBufferTest, MappedAllocatorGrowthPreservesContents) {
+    raw_buffer<std::uint32_t, mapped_allocator<std::uint32_t, 64 * 1024>> buffer;
+    std::uint32_t size = 1000;
+    buffer.resize(size);
+    for (std::uint32_t i = 0; i < size; ++i) buffer[i] = i * 7;
+
+    // 跨越映射阈值并多次增长，覆盖 heap -> mmap 与 mmap -> mmap 两种路径
+    for (int round = 0; round < 6; ++round) {
+        const auto old_size = size;
+        size *= 4;
+        buffer.resize(size);
+        for (std::uint32_t i = old_size; i < size; ++i) buffer[i] = i * 7;
+    }
+
+    for (std::uint32_t i = 0; i < size; ++i) {
+        ASSERT_EQ(buffer[i], i * 7);
+    }
+}
+
+#ifdef __cpp_lib_is_implicit_lifetime
+TEST(RawByteBufferTest, TriviallyRelocatableOptIn) {
+    static_assert(!std::is_trivially_copyable_v<tracked>);
+    static_assert(is_trivially_relocatable_v<tracked>);
+
+    raw_vector<tracked> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.emplace_back(i, std::make_unique<int>(i * 2));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(vec[i].value, i);
+        EXPECT_EQ(*vec[i].owned, i * 2);
+    }
+}
+#endif
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+import mo_yanxi.cache.map.concurrent;
+import std;
+
+using namespace mo_yanxi;
+
+TEST(ShardedLRUCacheTest, BasicOperations) {
+    sharded_lru_cache<int, std::string> cache{64, 4};
+    EXPECT_EQ(cache.shard_count(), 4);
+    EXPECT_EQ(cache.capacity(), 64);
+
+    cache.put(1, "one");
+    EXPECT_EQ(cache.get(1), "one");
+    EXPECT_FALSE(cache.get(2).has_value());
+
+    const auto stats = cache.statistics();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.size, 1);
+}
+
+TEST(ShardedLRUCacheTest, BatchOperations) {
+    sharded_lru_cache<int, int> cache{256, 8};
+
+    std::vector<std::pair<int, int>> entries;
+    for (int i = 0; i < 100; ++i) entries.emplace_back(i, i * 10);
+    cache.put_many(entries);
+    EXPECT_EQ(cache.size(), 100);
+
+    std::vector<int> keys{5, 500, 42, 99};
+    const auto values = cache.get_many(keys);
+    ASSERT_EQ(values.size(), keys.size());
+    EXPECT_EQ(values[0], 50);
+    EXPECT_FALSE(values[1].has_value());
+    EXPECT_EQ(values[2], 420);
+    EXPECT_EQ(values[3], 990);
+}
+
+TEST(ShardedLRUCacheTest, EvictionCounters) {
+    sharded_lru_cache<int, int> cache{4, 1};
+    for (int i = 0; i < 10; ++i) cache.put(i, i);
+
+    const auto stats = cache.shard_statistics(0);
+    EXPECT_EQ(stats.evictions, 6);
+    EXPECT_EQ(stats.size, 4);
+    EXPECT_FALSE(cache.get(0).has_value());
+    EXPECT_EQ(cache.get(9), 9);
+}
+
+TEST(ShardedLRUCacheTest, GetOrComputeDeduplicates) {
+    sharded_lru_cache<int, int> cache{128};
+    std::atomic<int> computations{0};
+    std::atomic_bool release{false};
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(8);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            results[t] = cache.get_or_compute(7, [&](int key) {
+                ++computations;
+                while (!release.load()) std::this_thread::yield();
+                return key * 3;
+            });
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(computations.load(), 1);
+    for (int v : results) EXPECT_EQ(v, 21);
+    EXPECT_EQ(cache.get(7), 21);
+}
+
+TEST(ShardedLRUCacheTest, GetOrComputeException) {
+    sharded_lru_cache<int, int> cache{16};
+    EXPECT_THROW((void)cache.get_or_compute(1, [](int) -> int { throw std::runtime_error("load"); }), std::runtime_error);
+    EXPECT_FALSE(cache.get(1).has_value());
+    EXPECT_EQ(cache.get_or_compute(1, [](int k) { return k + 1; }), 2);
+}
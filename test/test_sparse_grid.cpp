@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+import mo_yanxi.dim2.sparse_grid;
+import std;
+
+using namespace mo_yanxi;
+using namespace mo_yanxi::dim2;
+
+namespace {
+    using grid_t = sparse_grid<int, 4>;
+    using point_t = grid_t::point_type;
+
+    std::pair<int, int> key(point_t p) {
+        return {p.x, p.y};
+    }
+}
+
+TEST(SparseGridTest, LazyAllocationAndRelease) {
+    grid_t grid;
+    EXPECT_TRUE(grid.empty());
+    EXPECT_EQ((grid[100, -100]), 0);
+    EXPECT_EQ(grid.chunk_count(), 0u);
+
+    grid.set({-1, -1}, 5);
+    grid.set({0, 0}, 7);
+    EXPECT_EQ(grid.chunk_count(), 2u);
+    EXPECT_EQ(grid.size(), 2u);
+    EXPECT_EQ((grid[-1, -1]), 5);
+    EXPECT_EQ((grid[0, 0]), 7);
+    EXPECT_EQ((grid[-16, -16]), 0);
+
+    grid.set({-16, -16}, 1);
+    EXPECT_EQ(grid.chunk_count(), 2u);
+
+    grid.set({-1, -1}, 0);
+    EXPECT_EQ(grid.chunk_count(), 2u);
+    EXPECT_TRUE(grid.reset({-16, -16}));
+    EXPECT_FALSE(grid.reset({-16, -16}));
+    EXPECT_EQ(grid.chunk_count(), 1u);
+    EXPECT_EQ((grid[-1, -1]), 0);
+
+    grid.modify({0, 0}, [](int& v) { v = 0; });
+    EXPECT_EQ(grid.chunk_count(), 0u);
+    EXPECT_TRUE(grid.empty());
+
+    grid.modify({40, 40}, [](int&) {});
+    EXPECT_EQ(grid.chunk_count(), 0u);
+
+    grid.modify({40, 40}, [](int& v) { v += 3; });
+    EXPECT_EQ((grid[40, 40]), 3);
+    EXPECT_EQ(grid.size(), 1u);
+}
+
+TEST(SparseGridTest, MatchesReferenceMap) {
+    grid_t grid;
+    std::map<std::pair<int, int>, int> ref;
+
+    std::mt19937 g(11);
+    std::uniform_int_distribution<int> coord(-200, 200);
+    std::uniform_int_distribution<int> value(0, 3);
+
+    for (int i = 0; i < 20000; ++i) {
+        const point_t p{coord(g), coord(g)};
+        const int v = value(g);
+        grid.set(p, v);
+        if (v) ref[key(p)] = v;
+        else ref.erase(key(p));
+    }
+
+    EXPECT_EQ(grid.size(), ref.size());
+    for (const auto& [k, v] : ref) {
+        EXPECT_EQ((grid[k.first, k.second]), v);
+    }
+
+    std::map<std::pair<int, int>, int> visited;
+    grid.each([&](point_t p, const int& v) { visited[key(p)] = v; });
+    EXPECT_EQ(visited, ref);
+
+    std::map<std::pair<int, int>, int> in_rect;
+    grid.for_each_in_rect({-37, -5}, {21, 90}, [&](point_t p, const int& v) { in_rect[key(p)] = v; });
+    std::map<std::pair<int, int>, int> expected;
+    for (const auto& [k, v] : ref) {
+        if (k.first >= -37 && k.first < 21 && k.second >= -5 && k.second < 90) expected[k] = v;
+    }
+    EXPECT_EQ(in_rect, expected);
+}
+
+TEST(SparseGridTest, ChunksVisitedInMortonOrder) {
+    grid_t grid;
+    for (int y = -3; y <= 3; ++y) {
+        for (int x = -3; x <= 3; ++x) {
+            grid.set({x * grid_t::chunk_extent, y * grid_t::chunk_extent}, 1);
+        }
+    }
+
+    std::vector<std::uint64_t> codes;
+    grid.each_chunk([&](point_t c, const grid_t::chunk_tile_type& cells) {
+        EXPECT_EQ(cells.width(), static_cast<unsigned>(grid_t::chunk_extent));
+        constexpr std::uint32_t bias = 1u << 31;
+        codes.push_back(morton_interleave(static_cast<std::uint32_t>(c.x) ^ bias, static_cast<std::uint32_t>(c.y) ^ bias));
+    });
+
+    EXPECT_EQ(codes.size(), 49u);
+    EXPECT_TRUE(std::ranges::is_sorted(codes));
+}
+
+TEST(SparseGridTest, NeighborsCrossChunkBorders) {
+    grid_t grid;
+    const point_t corner{-1, 15};
+    for (const auto off : grid_t::neighbors_8) {
+        grid.set({corner.x + off.x, corner.y + off.y}, off.x * 10 + off.y);
+    }
+    EXPECT_EQ(grid.chunk_count(), 4u);
+
+    int count = 0;
+    grid.for_each_neighbor_8(corner, [&](point_t p, const int& v) {
+        EXPECT_EQ(v, (p.x - corner.x) * 10 + (p.y - corner.y));
+        ++count;
+    });
+    EXPECT_EQ(count, 8);
+
+    count = 0;
+    grid.for_each_neighbor_4({100, 100}, [&](point_t, const int& v) {
+        EXPECT_EQ(v, 0);
+        ++count;
+    });
+    EXPECT_EQ(count, 4);
+}
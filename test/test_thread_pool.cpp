@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+import mo_yanxi.concurrent.thread_pool;
+import mo_yanxi.concurrent.work_stealing_deque;
+import mo_yanxi.concurrent.small_task;
+import std;
+
+using namespace mo_yanxi::ccur;
+
+TEST(SmallTaskTest, InlineAndHeapStorage) {
+    int counter = 0;
+    small_task inline_task{[&counter] { ++counter; }};
+    inline_task();
+    EXPECT_EQ(counter, 1);
+
+    std::array<int, 64> large{};
+    large[63] = 5;
+    small_task heap_task{[&counter, large] { counter += large[63]; }};
+    small_task moved{std::move(heap_task)};
+    EXPECT_FALSE(static_cast<bool>(heap_task));
+    moved();
+    EXPECT_EQ(counter, 6);
+
+    auto owned = std::make_unique<int>(10);
+    small_task move_only{[p = std::move(owned), &counter] { counter += *p; }};
+    move_only();
+    EXPECT_EQ(counter, 16);
+}
+
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo) {
+    work_stealing_deque<int*> deque{2};
+    std::array<int, 8> values{};
+    for (auto& v : values) deque.push(&v);
+    EXPECT_EQ(deque.size(), 8);
+
+    EXPECT_EQ(deque.pop(), &values[7]);
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.size(), 6);
+
+    while (deque.pop()) {}
+    EXPECT_FALSE(deque.steal().has_value());
+}
+
+TEST(ThreadPoolTest, SubmitAndAsync) {
+    thread_pool pool{4};
+    auto future = pool.async([] { return 42; });
+    EXPECT_EQ(future.get(), 42);
+
+    auto failing = pool.async([]() -> int { throw std::runtime_error("fail"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, TaskGroup) {
+    thread_pool pool{4};
+    std::atomic<int> counter{0};
+    {
+        task_group group{pool};
+        for (int i = 0; i < 10000; ++i) {
+            group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    EXPECT_EQ(counter.load(), 10000);
+
+    task_group group{pool};
+    group.run([] { throw std::logic_error("group"); });
+    EXPECT_THROW(group.wait(), std::logic_error);
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+    thread_pool pool{4};
+    std::vector<int> data(100000);
+    pool.parallel_for(0, data.size(), [&](std::size_t i) { data[i] = static_cast<int>(i); });
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(data[i], static_cast<int>(i));
+    }
+
+    std::atomic<long long> sum{0};
+    pool.parallel_for(0, data.size(), [&](std::size_t begin, std::size_t end) {
+        long long local = 0;
+        for (auto i = begin; i != end; ++i) local += data[i];
+        sum += local;
+    }, 1024);
+    EXPECT_EQ(sum.load(), 99999LL * 100000 / 2);
+
+    pool.parallel_for_each(data, [](int& v) { v *= 2; });
+    EXPECT_EQ(data[500], 1000);
+}
+
+TEST(ThreadPoolTest, NestedJoin) {
+    thread_pool pool{4};
+
+    auto fib = [&](this auto& self, int n) -> long long {
+        if (n < 2) return n;
+        long long a = 0, b = 0;
+        pool.join([&] { a = self(n - 1); }, [&] { b = self(n - 2); });
+        return a + b;
+    };
+    EXPECT_EQ(fib(20), 6765);
+
+    EXPECT_THROW(pool.join([] {}, [] { throw std::runtime_error("rhs"); }), std::runtime_error);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+import mo_yanxi.dim2.tile_layout;
+import std;
+
+using namespace mo_yanxi;
+using namespace mo_yanxi::dim2;
+
+namespace {
+    const std::vector<std::pair<unsigned, unsigned>> extents_under_test{
+        {1, 1}, {1, 9}, {7, 1}, {8, 8}, {13, 5}, {16, 33}, {64, 3}, {31, 31}
+    };
+
+    template <typename Layout>
+    void check_mapping_bijective() {
+        for (const auto [w, h] : extents_under_test) {
+            const typename Layout::template mapping<std::dextents<unsigned, 2>> mapping{std::dextents<unsigned, 2>{h, w}};
+            std::vector<int> hits(mapping.required_span_size());
+            for (unsigned y = 0; y < h; ++y) {
+                for (unsigned x = 0; x < w; ++x) {
+                    const unsigned idx = mapping(y, x);
+                    ASSERT_LT(idx, hits.size()) << w << "x" << h;
+                    ++hits[idx];
+                    const auto coord = mapping.to_coord(idx);
+                    EXPECT_EQ(coord[0], y);
+                    EXPECT_EQ(coord[1], x);
+                }
+            }
+            EXPECT_EQ(std::ranges::count(hits, 1), static_cast<std::ptrdiff_t>(w * h)) << w << "x" << h;
+        }
+    }
+
+    template <typename Layout>
+    void check_tile_round_trip() {
+        for (const auto [w, h] : extents_under_test) {
+            tile<int> row_major{w, h};
+            row_major.fill([](unsigned x, unsigned y) { return static_cast<int>(y * 1000 + x); });
+
+            const layout_tile<int, Layout> blocked{row_major};
+            ASSERT_EQ(blocked.extent(), row_major.extent());
+            for (unsigned y = 0; y < h; ++y) {
+                for (unsigned x = 0; x < w; ++x) {
+                    EXPECT_EQ((blocked[x, y]), (row_major[x, y]));
+                }
+            }
+
+            const auto md = blocked.to_mdspan();
+            for (unsigned y = 0; y < h; ++y) {
+                for (unsigned x = 0; x < w; ++x) {
+                    EXPECT_EQ((md[y, x]), (row_major[x, y]));
+                }
+            }
+
+            const tile<int> back = blocked.to_row_major();
+            EXPECT_TRUE(std::ranges::equal(back, row_major));
+
+            std::vector<int> visited(w * h);
+            std::size_t count = 0;
+            for (auto it = blocked.begin(); it != blocked.end(); ++it) {
+                const auto pos = it.pos();
+                EXPECT_EQ(*it, static_cast<int>(pos.y * 1000 + pos.x));
+                ++visited[pos.y * w + pos.x];
+                ++count;
+            }
+            EXPECT_EQ(count, w * h);
+            EXPECT_TRUE(std::ranges::all_of(visited, [](int v) { return v == 1; }));
+
+            count = 0;
+            blocked.each([&](const int& v, unsigned x, unsigned y) {
+                EXPECT_EQ(v, static_cast<int>(y * 1000 + x));
+                ++count;
+            });
+            EXPECT_EQ(count, w * h);
+        }
+    }
+}
+
+TEST(TileLayoutTest, Block8MappingIsBijective) {
+    check_mapping_bijective<tile_layout_block8>();
+}
+
+TEST(TileLayoutTest, Block16MappingIsBijective) {
+    check_mapping_bijective<tile_layout_block16>();
+}
+
+TEST(TileLayoutTest, MortonMappingIsBijective) {
+    check_mapping_bijective<tile_layout_morton>();
+}
+
+TEST(TileLayoutTest, Block8RoundTrip) {
+    check_tile_round_trip<tile_layout_block8>();
+}
+
+TEST(TileLayoutTest, Block16RoundTrip) {
+    check_tile_round_trip<tile_layout_block16>();
+}
+
+TEST(TileLayoutTest, MortonRoundTrip) {
+    check_tile_round_trip<tile_layout_morton>();
+}
+
+TEST(TileLayoutTest, BlockLocality) {
+    const block8_tile<int> blocked{16, 16};
+    // 同一 8x8 块内竖直相邻的元素相距一个块行
+    EXPECT_EQ(blocked.to_index(3, 5) - blocked.to_index(3, 4), 8u);
+    EXPECT_EQ(blocked.to_index(0, 8), 2u * 64u);
+
+    const morton_tile<int> morton{4, 4};
+    EXPECT_EQ(morton.to_index(1, 0), 1u);
+    EXPECT_EQ(morton.to_index(0, 1), 2u);
+    EXPECT_EQ(morton.to_index(1, 1), 3u);
+    EXPECT_EQ(morton.to_index(2, 0), 4u);
+}
+
+TEST(TileLayoutTest, ModifyThroughAccessors) {
+    morton_tile<int> tile{10, 6, 7};
+    EXPECT_TRUE(std::ranges::all_of(tile, [](int v) { return v == 7; }));
+    tile.each([](int& v, unsigned x, unsigned y) { v = static_cast<int>(x + y); });
+    tile[9, 5] = -1;
+    const auto row_major = tile.to_row_major();
+    EXPECT_EQ((row_major[9, 5]), -1);
+    EXPECT_EQ((row_major[4, 3]), 7);
+}
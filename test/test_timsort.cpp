@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
-import mo_yanxi.algo.timsort;
+import mo_yanxi.algo.parallel_timsort;
+import mo_yanxi.concurrent.thread_pool;
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -26,3 +27,38 @@ TEST(TimsortTest, Random) {
     timsort(v);
     EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
 }
+
+TEST(TimsortTest, ParallelMatchesStableSort) {
+    mo_yanxi::ccur::thread_pool pool{4};
+
+    struct item {
+        int key;
+        int order;
+    };
+
+    std::vector<item> v(300000);
+    std::mt19937 g(7);
+    std::uniform_int_distribution<int> dist(0, 999);
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) {
+        v[i] = {dist(g), i};
+    }
+
+    auto expected = v;
+    std::ranges::stable_sort(expected, {}, &item::key);
+
+    timsort(pool, v, std::ranges::greater{}, [](const item& it) { return -it.key; });
+
+    ASSERT_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i].key, expected[i].key);
+        ASSERT_EQ(v[i].order, expected[i].order);
+    }
+}
+
+TEST(TimsortTest, ParallelSmallInputFallsBackToSerial) {
+    mo_yanxi::ccur::thread_pool pool{2};
+    std::vector<int> v(1000);
+    std::iota(v.rbegin(), v.rend(), 0);
+    timsort(pool, v);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
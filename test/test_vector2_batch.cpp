@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+import mo_yanxi.math.vector2_batch;
+import std;
+
+using namespace mo_yanxi::math;
+
+namespace {
+    std::vector<vec2> random_points(std::size_t count, unsigned seed) {
+        std::mt19937 g(seed);
+        std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+        std::vector<vec2> rst(count);
+        for (auto& p : rst) p = {dist(g), dist(g)};
+        return rst;
+    }
+
+    void expect_near(vec2 actual, vec2 expected) {
+        EXPECT_NEAR(actual.x, expected.x, 1e-3f);
+        EXPECT_NEAR(actual.y, expected.y, 1e-3f);
+    }
+}
+
+TEST(Vector2BatchTest, TransformMatchesScalar) {
+    // 37 个点同时覆盖 8 宽主循环与标量尾部
+    const auto points = random_points(37, 1);
+    vec2_batch batch{points};
+    const trans2 trans{{12.5f, -3.f}, 0.7f};
+
+    batch_transform(batch.span(), trans);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect_near(batch[i], points[i] >> trans);
+    }
+
+    batch_transform_inv(batch.span(), trans);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect_near(batch[i], points[i]);
+    }
+}
+
+TEST(Vector2BatchTest, TranslateScaleRotate) {
+    const auto points = random_points(21, 2);
+    vec2_batch batch{points};
+
+    batch_translate(batch.span(), {1.f, 2.f});
+    batch_scale(batch.span(), {2.f, 0.5f});
+    batch_rotate(batch.span(), 1.1f);
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        vec2 expected = points[i];
+        expected += vec2{1.f, 2.f};
+        expected.x *= 2.f;
+        expected.y *= 0.5f;
+        expected.rotate_rad(1.1f);
+        expect_near(batch[i], expected);
+    }
+}
+
+TEST(Vector2BatchTest, MatrixMultiply) {
+    const auto points = random_points(19, 3);
+    vec2_batch src{points};
+    vec2_batch dst(points.size());
+
+    matrix3 mat = mat3_idt;
+    mat.from_transform(trans2{{5.f, 7.f}, 0.3f});
+
+    batch_mul(mat, src.span(), dst.span());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        expect_near(dst[i], mat * points[i]);
+    }
+}
+
+TEST(Vector2BatchTest, DotLengthAndBound) {
+    const auto points = random_points(45, 4);
+    vec2_batch batch{points};
+    std::vector<float> dots(points.size());
+    std::vector<float> lengths(points.size());
+
+    batch_dot(batch.span(), vec2{0.6f, 0.8f}, dots);
+    batch_length(batch.span(), lengths);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(dots[i], points[i].x * 0.6f + points[i].y * 0.8f, 1e-3f);
+        EXPECT_NEAR(lengths[i], points[i].length(), 1e-3f);
+    }
+
+    const auto bound = get_bound(batch.span());
+    float xmin = points[0].x, xmax = points[0].x, ymin = points[0].y, ymax = points[0].y;
+    for (const auto& p : points) {
+        xmin = std::min(xmin, p.x);
+        xmax = std::max(xmax, p.x);
+        ymin = std::min(ymin, p.y);
+        ymax = std::max(ymax, p.y);
+    }
+    EXPECT_EQ(bound.get_src_x(), xmin);
+    EXPECT_EQ(bound.get_src_y(), ymin);
+    EXPECT_EQ(bound.get_end_x(), xmax);
+    EXPECT_EQ(bound.get_end_y(), ymax);
+}
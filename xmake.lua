@@ -117,6 +117,9 @@ target("mo_yanxi.utility.test")
     add_packages("gtest")
 
     add_files("test/**.cpp")
+    if not has_config("add_legacy") then
+        remove_files("test/legacy/**.cpp")
+    end
 
     set_enabled(has_config("add_test"))
 target_end()